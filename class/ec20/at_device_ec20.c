@@ -47,129 +47,7 @@ static char *QICSGP_CHINA_MOBILE = "AT+QICSGP=1,1,\"CMNET\",\"\",\"\",0";
 static char *QICSGP_CHINA_UNICOM = "AT+QICSGP=1,1,\"UNINET\",\"\",\"\",0";
 static char *QICSGP_CHINA_TELECOM = "AT+QICSGP=1,1,\"CTNET\",\"\",\"\",0";
 
-static void at_cme_errcode_parse(int result)
-{
-    switch(result)
-    {
-    case 0   : LOG_E("%d : Phone failure",                result); break;
-    case 1   : LOG_E("%d : No connection to phone",       result); break;
-    case 2   : LOG_E("%d : Phone-adaptor link reserved",  result); break;
-    case 3   : LOG_E("%d : Operation not allowed",        result); break;
-    case 4   : LOG_E("%d : Operation not supported",      result); break;
-    case 5   : LOG_E("%d : PH-SIM PIN required",          result); break;
-    case 6   : LOG_E("%d : PH-FSIM PIN required",         result); break;
-    case 7   : LOG_E("%d : PH-FSIM PUK required",         result); break;
-    case 10  : LOG_E("%d : SIM not inserted",             result); break;
-    case 11  : LOG_E("%d : SIM PIN required",             result); break;
-    case 12  : LOG_E("%d : SIM PUK required",             result); break;
-    case 13  : LOG_E("%d : SIM failure",                  result); break;
-    case 14  : LOG_E("%d : SIM busy",                     result); break;
-    case 15  : LOG_E("%d : SIM wrong",                    result); break;
-    case 16  : LOG_E("%d : Incorrect password",           result); break;
-    case 17  : LOG_E("%d : SIM PIN2 required",            result); break;
-    case 18  : LOG_E("%d : SIM PUK2 required",            result); break;
-    case 20  : LOG_E("%d : Memory full",                  result); break;
-    case 21  : LOG_E("%d : Invalid index",                result); break;
-    case 22  : LOG_E("%d : Not found",                    result); break;
-    case 23  : LOG_E("%d : Memory failure",               result); break;
-    case 24  : LOG_E("%d : Text string too long",         result); break;
-    case 25  : LOG_E("%d : Invalid characters in text string", result); break;
-    case 26  : LOG_E("%d : Dial string too long",         result); break;
-    case 27  : LOG_E("%d : Invalid characters in dial string", result); break;
-    case 30  : LOG_E("%d : No network service",           result); break;
-    case 31  : LOG_E("%d : Network timeout",              result); break;
-    case 32  : LOG_E("%d : Network not allowed - emergency calls only", result); break;
-    case 40  : LOG_E("%d : Network personalization PIN required", result); break;
-    case 41  : LOG_E("%d : Network personalization PUK required", result); break;
-    case 42  : LOG_E("%d : Network subset personalization PIN required", result); break;
-    case 43  : LOG_E("%d : Network subset personalization PUK required", result); break;
-    case 44  : LOG_E("%d : Service provider personalization PIN required", result); break;
-    case 45  : LOG_E("%d : Service provider personalization PUK required", result); break;
-    case 46  : LOG_E("%d : Corporate personalization PIN required", result); break;
-    case 47  : LOG_E("%d : Corporate personalization PUK required", result); break;
-    case 901 : LOG_E("%d : Audio unknown error",          result); break;
-    case 902 : LOG_E("%d : Audio invalid parameters",     result); break;
-    case 903 : LOG_E("%d : Audio operation not supported", result); break;
-    case 904 : LOG_E("%d : Audio device busy",            result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_cms_errcode_parse(int result)
-{
-    switch(result)
-    {
-    case 300 : LOG_E("%d : ME failure",                   result); break;
-    case 301 : LOG_E("%d : SMS ME reserved",              result); break;
-    case 302 : LOG_E("%d : Operation not allowed",        result); break;
-    case 303 : LOG_E("%d : Operation not supported",      result); break;
-    case 304 : LOG_E("%d : Invalid PDU mode",             result); break;
-    case 305 : LOG_E("%d : Invalid text mode",            result); break;
-    case 310 : LOG_E("%d : SIM not inserted",             result); break;
-    case 311 : LOG_E("%d : SIM pin necessary",            result); break;
-    case 312 : LOG_E("%d : PH SIM pin necessary",         result); break;
-    case 313 : LOG_E("%d : SIM failure",                  result); break;
-    case 314 : LOG_E("%d : SIM busy",                     result); break;
-    case 315 : LOG_E("%d : SIM wrong",                    result); break;
-    case 316 : LOG_E("%d : SIM PUK required",             result); break;
-    case 317 : LOG_E("%d : SIM PIN2 required",            result); break;
-    case 318 : LOG_E("%d : SIM PUK2 required",            result); break;
-    case 320 : LOG_E("%d : Memory failure",               result); break;
-    case 321 : LOG_E("%d : Invalid memory index",         result); break;
-    case 322 : LOG_E("%d : Memory full",                  result); break;
-    case 330 : LOG_E("%d : SMSC address unknown",         result); break;
-    case 331 : LOG_E("%d : No network",                   result); break;
-    case 332 : LOG_E("%d : Network timeout",              result); break;
-    case 500 : LOG_E("%d : Unknown",                      result); break;
-    case 512 : LOG_E("%d : SIM not ready",                result); break;
-    case 513 : LOG_E("%d : Message length exceeds",       result); break;
-    case 514 : LOG_E("%d : Invalid request parameters",   result); break;
-    case 515 : LOG_E("%d : ME storage failure",           result); break;
-    case 517 : LOG_E("%d : Invalid service mode",         result); break;
-    case 528 : LOG_E("%d : More message to send state error", result); break;
-    case 529 : LOG_E("%d : MO SMS is not allow",          result); break;
-    case 530 : LOG_E("%d : GPRS is suspended",            result); break;
-    case 531 : LOG_E("%d : ME storage full",              result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_mms_errcode_parse(int result)//MMS
-{
-    switch(result)
-    {
-    case 751 : LOG_E("%d : Unknown error",                result); break;
-    case 752 : LOG_E("%d : URL length error",             result); break;
-    case 753 : LOG_E("%d : URL error",                    result); break;
-    case 754 : LOG_E("%d : Invalid proxy type",           result); break;
-    case 755 : LOG_E("%d : Proxy address error",          result); break;
-    case 756 : LOG_E("%d : Invalid parameter",            result); break;
-    case 757 : LOG_E("%d : Recipient address full",       result); break;
-    case 758 : LOG_E("%d : CC recipient address full",    result); break;
-    case 759 : LOG_E("%d : BCC recipient address full",   result); break;
-    case 760 : LOG_E("%d : Attachments full",             result); break;
-    case 761 : LOG_E("%d : File error",                   result); break;
-    case 762 : LOG_E("%d : No recipient",                 result); break;
-    case 763 : LOG_E("%d : File not found",               result); break;
-    case 764 : LOG_E("%d : MMS busy",                     result); break;
-    case 765 : LOG_E("%d : Server response failed",       result); break;
-    case 766 : LOG_E("%d : Error response of HTTP(S) post", result); break;
-    case 767 : LOG_E("%d : Invalid report of HTTP(S) post", result); break;
-    case 768 : LOG_E("%d : PDP activation failed",        result); break;
-    case 769 : LOG_E("%d : PDP deactivated",              result); break;
-    case 770 : LOG_E("%d : Socket creation failed",       result); break;
-    case 771 : LOG_E("%d : Socket connection failed",     result); break;
-    case 772 : LOG_E("%d : Socket read failed",           result); break;
-    case 773 : LOG_E("%d : Socket write failed",          result); break;
-    case 774 : LOG_E("%d : Socket closed",                result); break;
-    case 775 : LOG_E("%d : Timeout",                      result); break;
-    case 776 : LOG_E("%d : Encode data error",            result); break;
-    case 777 : LOG_E("%d : HTTP(S) decode data error",    result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void ec20_power_on(struct at_device *device)
+static int ec20_power_on(struct at_device *device)
 {
     struct at_device_ec20 *ec20 = RT_NULL;
 
@@ -178,23 +56,14 @@ static void ec20_power_on(struct at_device *device)
     /* not nead to set pin configuration for ec20 device power on */
     if (ec20->power_pin == -1 || ec20->power_status_pin == -1)
     {
-        return;
+        return RT_EOK;
     }
 
-    if (rt_pin_read(ec20->power_status_pin) == PIN_HIGH)
-    {
-        return;
-    }
-    rt_pin_write(ec20->power_pin, PIN_HIGH);
-
-    while (rt_pin_read(ec20->power_status_pin) == PIN_LOW)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(ec20->power_pin, PIN_LOW);
+    return at_device_power_switch(device, ec20->power_pin, ec20->power_status_pin,
+                                  RT_TRUE, AT_DEVICE_POWER_TIMEOUT);
 }
 
-static void ec20_power_off(struct at_device *device)
+static int ec20_power_off(struct at_device *device)
 {
     struct at_device_ec20 *ec20 = RT_NULL;
 
@@ -203,20 +72,11 @@ static void ec20_power_off(struct at_device *device)
     /* not nead to set pin configuration for ec20 device power on */
     if (ec20->power_pin == -1 || ec20->power_status_pin == -1)
     {
-        return;
+        return RT_EOK;
     }
 
-    if (rt_pin_read(ec20->power_status_pin) == PIN_LOW)
-    {
-        return;
-    }
-    rt_pin_write(ec20->power_pin, PIN_HIGH);
-
-    while (rt_pin_read(ec20->power_status_pin) == PIN_HIGH)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(ec20->power_pin, PIN_LOW);
+    return at_device_power_switch(device, ec20->power_pin, ec20->power_status_pin,
+                                  RT_FALSE, AT_DEVICE_POWER_TIMEOUT);
 }
 
 /* =============================  ec20 network interface operations ============================= */
@@ -252,7 +112,7 @@ static int ec20_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(EC20_IEMI_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+    resp = at_device_resp_take(device, EC20_IEMI_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -265,21 +125,30 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define EC20_NETDEV_HWADDR_LEN   8
         #define EC20_IEMI_LEN            15
 
-        char iemi[EC20_IEMI_LEN] = {0};
+        char iemi[EC20_IEMI_LEN + 1] = {0};
         int i = 0, j = 0;
 
-        /* send "AT+GSN" commond to get device IEMI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+GSN") < 0)
+        /* the IEMI number is cached after the first boot */
+#ifdef AT_DEVICE_USING_CACHE
+        if (at_device_cache_get(device, "imei", iemi, sizeof(iemi)) != RT_EOK)
+#endif
         {
-            result = -RT_ERROR;
-            goto __exit;
-        }
+            /* send "AT+GSN" commond to get device IEMI */
+            if (at_device_exec_cmd(device, resp, "AT+GSN") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
 
-        if (at_resp_parse_line_args(resp, 2, "%s", iemi) <= 0)
-        {
-            LOG_E("ec20 device(%s) prase \"AT+GSN\" commands resposne data error.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
+            if (at_resp_parse_line_args(resp, 2, "%15s", iemi) <= 0)
+            {
+                LOG_E("ec20 device(%s) prase \"AT+GSN\" commands resposne data error.", device->name);
+                result = -RT_ERROR;
+                goto __exit;
+            }
+#ifdef AT_DEVICE_USING_CACHE
+            at_device_cache_set(device, "imei", iemi);
+#endif
         }
 
         LOG_D("ec20 deevice(%s) IEMI number: %s", device->name, iemi);
@@ -304,10 +173,10 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define IP_ADDR_SIZE_MAX    16
         char ipaddr[IP_ADDR_SIZE_MAX] = {0};
         
-        resp = at_resp_set_info(resp, EC20_IPADDR_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+        resp = at_device_resp_set_info(device, resp, EC20_IPADDR_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
 
         /* send "AT+QIACT?" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIACT?") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QIACT?") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -333,10 +202,10 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define DNS_ADDR_SIZE_MAX   16
         char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
 
-        resp = at_resp_set_info(resp, EC20_DNS_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+        resp = at_device_resp_set_info(device, resp, EC20_DNS_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
 
         /* send "AT+QIDNSCFG=1" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QIDNSCFG=1") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -364,100 +233,67 @@ static int ec20_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
 }
 
-static void ec20_check_link_status_entry(void *parameter)
+static rt_bool_t ec20_link_parse(at_response_t resp)
 {
-#define EC20_LINK_RESP_SIZE     64
-#define EC20_LINK_RESP_TIMO     (3 * RT_TICK_PER_SECOND)
-#define EC20_LINK_DELAY_TIME    (30 * RT_TICK_PER_SECOND)
-
     int link_stat = 0;
+
+    at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat);
+
+    /* 1 Registered, home network,5 Registered, roaming */
+    return (link_stat == 1 || link_stat == 5) ? RT_TRUE : RT_FALSE;
+}
+
+/* reactivate the context profile after it's deactivated by the network */
+static int ec20_link_reactivate(struct at_device *device)
+{
+#define EC20_REACT_RESP_SIZE     64
+
+    int result = RT_EOK;
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
-    struct netdev *netdev = (struct netdev *) parameter;
-    
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get ec20 device by netdev name(%s) failed.", netdev->name);
-        return;
-    }
 
-    resp = at_create_resp(EC20_LINK_RESP_SIZE, 0, EC20_LINK_RESP_TIMO);
+    resp = at_device_resp_take(device, EC20_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(40 * 1000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
-        return;
+        return -RT_ENOMEM;
     }
 
-    while (1)
+    /* the deactivated context profile should be deactivated before activated again */
+    if (at_device_exec_cmd(device, resp, "AT+QIDEACT=1") < 0)
     {
-        /* send "AT+CGREG" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
-        {
-            if (netdev_is_link_up(netdev))
-            {
-                netdev_low_level_set_link_status(netdev, RT_FALSE);
-            }
-            
-            rt_thread_mdelay(EC20_LINK_DELAY_TIME);
-            continue;
-        }
-        else
-        {
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat);
-
-            /* 1 Registered, home network,5 Registered, roaming */
-            if (link_stat == 1 || link_stat == 5)
-            {
-                if (netdev_is_link_up(netdev) == RT_FALSE)
-                {
-                    netdev_low_level_set_link_status(netdev, RT_TRUE);
-                }
-            }
-            else
-            {
-                if (netdev_is_link_up(netdev))
-                {
-                    netdev_low_level_set_link_status(netdev, RT_FALSE);
-                }
-            }
-        }
-
-        rt_thread_mdelay(EC20_LINK_DELAY_TIME);
+        result = -RT_ERROR;
+        goto __exit;
     }
-}
-
-static int ec20_netdev_check_link_status(struct netdev *netdev)
-{
-#define EC20_LINK_THREAD_TICK           20
-#define EC20_LINK_THREAD_STACK_SIZE     1024
-#define EC20_LINK_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
-
-    rt_thread_t tid;
 
-    if (netdev == RT_NULL)
+    resp = at_device_resp_set_info(device, resp, EC20_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(150 * 1000));
+    if (at_device_exec_cmd(device, resp, "AT+QIACT=1") < 0)
     {
-        LOG_E("input network interface device is NULL.\n");
-        return -RT_ERROR;
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    /* create ec20 link status polling thread  */
-    tid = rt_thread_create("ec20_link", ec20_check_link_status_entry, (void *) netdev, 
-            EC20_LINK_THREAD_STACK_SIZE, EC20_LINK_THREAD_PRIORITY, EC20_LINK_THREAD_TICK);
-    if (tid != RT_NULL)
-    {
-        rt_thread_startup(tid);
-    }
+    /* the IP address may be changed, update the network interface device information */
+    result = ec20_netdev_set_info(device->netdev);
 
-    return RT_EOK;
+__exit:
+    at_device_resp_release(device, resp);
+
+    return result;
 }
 
+static const struct at_device_link_ops ec20_link_ops =
+{
+    "AT+CGREG?",
+    ec20_link_parse,
+    ec20_link_reactivate,
+};
+
 static int ec20_net_init(struct at_device *device);
 
 static int ec20_netdev_set_up(struct netdev *netdev)
@@ -500,6 +336,7 @@ static int ec20_netdev_set_down(struct netdev *netdev)
         device->is_init = RT_FALSE;
 
         netdev_low_level_set_status(netdev, RT_FALSE);
+        at_device_set_ready(device, RT_FALSE);
         LOG_D("the network interface device(%s) set down status.", netdev->name);
     }
 
@@ -525,7 +362,7 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
     
-    resp = at_create_resp(EC20_DNS_RESP_LEN, 0, EC20_DNS_RESP_TIMEO);
+    resp = at_device_resp_take(device, EC20_DNS_RESP_LEN, 0, EC20_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("no memory for ec20 device(%s) response structure.", device->name);
@@ -534,7 +371,7 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
     }
 
     /* send "AT+QIDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1,\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QIDNSCFG=1,\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -545,7 +382,7 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
@@ -576,7 +413,7 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(EC20_PING_RESP_SIZE, 4, EC20_PING_TIMEO);
+    resp = at_device_resp_take(device, EC20_PING_RESP_SIZE, 4, EC20_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -584,7 +421,7 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+QPING="<host>"[,[<timeout>][,<pingnum>]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QPING=1,\"%s\",%d,1", host, timeout / RT_TICK_PER_SECOND) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QPING=1,\"%s\",%d,1", host, timeout / RT_TICK_PER_SECOND) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -623,7 +460,7 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
@@ -654,13 +491,13 @@ const struct netdev_ops ec20_netdev_ops =
 #endif
 };
 
-static struct netdev *ec20_netdev_add(const char *netdev_name)
+static struct netdev *ec20_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define ETHERNET_MTU        1500
 #define HWADDR_LEN          8
     struct netdev *netdev = RT_NULL;
 
-    netdev = (struct netdev *)rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) netdev structure.", netdev->name);
@@ -686,32 +523,72 @@ static struct netdev *ec20_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
+        (resp) = at_device_resp_set_info(device, (resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)                                       \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
             goto __exit;                                                                          \
         }                                                                                          \
     } while(0)                                                                                     \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* set response format to ATV1, disable echo and enable verbose result code */
+static const struct at_device_step ec20_start_steps[] =
+{
+    {"ATV1",        RT_NULL,     300,  0, AT_DEVICE_STEP_COALESCE},
+    {"ATE0",        RT_NULL,     300,  0, AT_DEVICE_STEP_COALESCE},
+    {"AT+CMEE=2",   RT_NULL,     300,  0, AT_DEVICE_STEP_COALESCE},
+};
+
+/* check SIM card and query the IMSI of SIM card */
+static const struct at_device_step ec20_sim_steps[] =
+{
+    {"AT+CPIN?",    "READY",     5000, 0, 0},
+    {"AT+CIMI",     RT_NULL,     300,  10, 0, 1000},
+};
+
+/* check signal strength and wait the GSM, GPRS network is registered */
+static const struct at_device_step ec20_net_steps[] =
+{
+    {"AT+CSQ",      "+CSQ: 99,", 300,  19, AT_DEVICE_STEP_EXCLUDE, 1000},
+    {"AT+CREG?",    "+CREG: 0,1|+CREG: 0,5", 300, 9, 0, 1000},
+    {"AT+CGREG?",   "+CGREG: 0,1|+CGREG: 0,5", 300, 19, 0, 1000},
+    {"AT+CEREG?",   RT_NULL,     300,  0, 0},
+};
+
+/* enable automatic time zone update via NITZ and get RTC time */
+static const struct at_device_step ec20_time_steps[] =
+{
+    {"AT+CTZU=3",   RT_NULL,     300,  0, AT_DEVICE_STEP_COALESCE},
+    {"AT+CCLK?",    RT_NULL,     300,  0, AT_DEVICE_STEP_COALESCE},
+};
+
 /* initialize for ec20 */
 static void ec20_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY                     5
-#define CIMI_RETRY                     10
-#define CSQ_RETRY                      20
-#define CREG_RETRY                     10
-#define CGREG_RETRY                    20
 
-    int i, qi_arg[3] = {0};
+    int i;
     int retry_num = INIT_RETRY;
     char parsed_data[20] = {0};
+#ifdef AT_DEVICE_USING_CACHE
+    char identity[AT_DEVICE_CACHE_IDENTITY_LEN] = {0};
+    rt_bool_t cache_valid = RT_FALSE;
+#endif
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -723,7 +600,11 @@ static void ec20_init_thread_entry(void *parameter)
     while (retry_num--)
     {
         /* power on the ec20 device */
-        ec20_power_on(device);
+        if (ec20_power_on(device) < 0)
+        {
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
         rt_thread_mdelay(1000);
 
         /* wait ec20 startup finish, send AT every 500ms, if receive OK, SYNC success*/
@@ -733,12 +614,8 @@ static void ec20_init_thread_entry(void *parameter)
             goto __exit;
         }
 
-        /* set response format to ATV1 */
-        AT_SEND_CMD(client, resp, 0, 300, "ATV1");
-        /* disable echo */
-        AT_SEND_CMD(client, resp, 0, 300, "ATE0");
-        /* Use AT+CMEE=2 to enable result code and use verbose values */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+CMEE=2");
+        /* set response format to ATV1, disable echo and use AT+CMEE=2 to enable verbose result code */
+        AT_EXEC_STEPS(device, resp, ec20_start_steps);
         /* Get the baudrate */
         AT_SEND_CMD(client, resp, 0, 300, "AT+IPR?");
         at_resp_parse_line_args_by_kw(resp, "+IPR:", "+IPR: %d", &i);
@@ -750,101 +627,53 @@ static void ec20_init_thread_entry(void *parameter)
         {
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* Use AT+GSN to query the IMEI of module */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+GSN");
-        
-        /* check SIM card */
-        AT_SEND_CMD(client, resp, 2, 5 * 1000, "AT+CPIN?");
-        if (!at_resp_get_line_by_kw(resp, "READY"))
-        {
-            LOG_E("ec20 device(%s) SIM card detection failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
-        
+#ifdef AT_DEVICE_USING_CACHE
+        /* the firmware revision is a part of the module identity */
+        rt_memset(identity, 0, sizeof(identity));
+        at_resp_parse_line_args_by_kw(resp, "Revision:", "Revision: %31s", identity);
+#endif
         
-        /* Use AT+CIMI to query the IMSI of SIM card */
-        // AT_SEND_CMD(client, resp, 2, 300, "AT+CIMI");
-        i = 0;
-        resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
-        while(at_obj_exec_cmd(device->client, resp, "AT+CIMI") < 0)
-        {
-            i++;
-            if(i > CIMI_RETRY)
-            {
-                LOG_E("ec20 device(%s) read CIMI failed.", device->name);
-                result = -RT_ERROR;
-                goto __exit;
-            }
-            rt_thread_mdelay(1000);
-        }
+        /* check SIM card and use AT+CIMI to query the IMSI of SIM card */
+        AT_EXEC_STEPS(device, resp, ec20_sim_steps);
 
         /* Use AT+QCCID to query ICCID number of SIM card */
         AT_SEND_CMD(client, resp, 0, 300, "AT+QCCID");
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &qi_arg[0], &qi_arg[1]);
-            if (qi_arg[0] != 99)
-            {
-                LOG_D("ec20 device(%s) signal strength: %d, channel bit error rate: %d", 
-                        device->name, qi_arg[0], qi_arg[1]);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("ec20 device(%s) signal strength check failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) || 
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("ec20 device(%s) GSM network is registered(%s)", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CREG_RETRY)
+#ifdef AT_DEVICE_USING_CACHE
+        /* the cached values are valid only for the same firmware, SIM card and module (IMEI) */
+        i = rt_strlen(identity);
+        identity[i++] = ',';
+        at_resp_parse_line_args_by_kw(resp, "+QCCID:", "+QCCID: %31s", identity + i);
+
+        AT_SEND_CMD(client, resp, 0, 300, "AT+GSN");
+        i = rt_strlen(identity);
+        identity[i++] = ',';
+        at_resp_parse_line_args(resp, 2, "%15s", identity + i);
+
+        cache_valid = (at_device_cache_check(device, identity) == RT_EOK);
+        if (cache_valid == RT_FALSE && identity[i] != '\0')
         {
-            LOG_E("ec20 device(%s) GSM network is register failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
+            /* the IMEI is read already, it's cached for the network interface hardware address */
+            at_device_cache_set(device, "imei", identity + i);
         }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
+#endif
+        /* check signal strength, wait the GSM and GPRS network is registered and query EPS network status */
+        AT_EXEC_STEPS(device, resp, ec20_net_steps);
+        /* Use AT+COPS? to query current Network Operator, the operator of the same SIM card is cached */
+#ifdef AT_DEVICE_USING_CACHE
+        if (cache_valid == RT_FALSE || 
+                at_device_cache_get(device, "cops", parsed_data, sizeof(parsed_data)) != RT_EOK)
+#endif
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) || 
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
+            AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
+#ifdef AT_DEVICE_USING_CACHE
+            if (at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%19[^\"]", &parsed_data) > 0)
             {
-                LOG_D("ec20 device(%s) GPRS network is registered(%s)", device->name, parsed_data);
-                break;
+                at_device_cache_set(device, "cops", parsed_data);
             }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("ec20 device(%s) GPRS network is register failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
+#else
+            at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%19[^\"]", &parsed_data);
+#endif
         }
-        /*Use AT+CEREG? to query current EPS Network Registration Status*/
-        AT_SEND_CMD(client, resp, 0, 300, "AT+CEREG?");
-        /* Use AT+COPS? to query current Network Operator */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
-        at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
         if(rt_strcmp(parsed_data,"CHINA MOBILE") == 0)
         {
             /* "CMCC" */
@@ -863,18 +692,25 @@ static void ec20_init_thread_entry(void *parameter)
             LOG_I("ec20 device(%s) network operator: %s", device->name, parsed_data);
             AT_SEND_CMD(client, resp, 0, 300, QICSGP_CHINA_TELECOM);
         }
-        /* Enable automatic time zone update via NITZ and update LOCAL time to RTC */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+CTZU=3");
-        /* Get RTC time */
-        AT_SEND_CMD(client, resp, 0, 300, "AT+CCLK?");
-
-        /* Deactivate context profile */
-        AT_SEND_CMD(client, resp, 0, 40 * 1000, "AT+QIDEACT=1");
-        /* Activate context profile */
-        AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT=1");
-        /* Query the status of the context profile */
+        /* Enable automatic time zone update via NITZ and update LOCAL time to RTC, get RTC time */
+        AT_EXEC_STEPS(device, resp, ec20_time_steps);
+
+        /* Query the status of the context profile, reuse it if it is still activated */
         AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT?");
-        at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: %*[^\"]\"%[^\"]", &parsed_data);
+        if (at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: 1,1,%*d,\"%[^\"]", &parsed_data) > 0)
+        {
+            LOG_I("ec20 device(%s) context profile is already activated, skip activation.", device->name);
+        }
+        else
+        {
+            /* Deactivate context profile */
+            AT_SEND_CMD(client, resp, 0, 40 * 1000, "AT+QIDEACT=1");
+            /* Activate context profile */
+            AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT=1");
+            /* Query the status of the context profile */
+            AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT?");
+            at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: %*[^\"]\"%[^\"]", &parsed_data);
+        }
         LOG_I("ec20 device(%s) IP address: %s", device->name, parsed_data);
         result = RT_EOK;
 
@@ -895,15 +731,20 @@ static void ec20_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result == RT_EOK)
     {
         /* set network interface device status and address information */
         ec20_netdev_set_info(device->netdev);
-        ec20_netdev_check_link_status(device->netdev);
+        at_device_link_monitor(device, &ec20_link_ops);
+#ifdef AT_USING_SOCKET
+        /* the data length of one send command, the class default is used if it's not probed */
+        at_device_probe_send_max(device, "AT+QISEND=?", "+QISEND:");
+#endif
 
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("ec20 device(%s) network initialize success.", device->name);
     }
     else
@@ -956,7 +797,7 @@ static int ec20_init(struct at_device *device)
 #endif
 
     /* add ec20 device to the netdev list */
-    device->netdev = ec20_netdev_add(ec20->device_name);
+    device->netdev = ec20_netdev_add(device, ec20->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("ec20 device(%s) initialize failed, get network interface device failed.", ec20->device_name);
@@ -979,6 +820,162 @@ static int ec20_deinit(struct at_device *device)
     return ec20_netdev_set_down(device->netdev);
 }
 
+/* request the PSM and eDRX timers, disable them when the configuration is NULL */
+static int ec20_low_power(struct at_device *device, struct at_device_low_power *config)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for ec20 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (config && config->psm && config->psm_tau && config->psm_active)
+    {
+        result = at_device_exec_cmd(device, resp, "AT+CPSMS=1,,,\"%s\",\"%s\"",
+                                 config->psm_tau, config->psm_active);
+    }
+    else
+    {
+        result = at_device_exec_cmd(device, resp, "AT+CPSMS=%d", (config && config->psm) ? 1 : 0);
+    }
+    if (result < 0)
+    {
+        LOG_E("ec20 device(%s) set PSM failed.", device->name);
+        goto __exit;
+    }
+
+    if (config && config->edrx && config->edrx_value)
+    {
+        result = at_device_exec_cmd(device, resp, "AT+CEDRXS=1,4,\"%s\"", config->edrx_value);
+    }
+    else
+    {
+        result = at_device_exec_cmd(device, resp, "AT+CEDRXS=%d", (config && config->edrx) ? 1 : 0);
+    }
+    if (result < 0)
+    {
+        LOG_E("ec20 device(%s) set eDRX failed.", device->name);
+    }
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
+/* enable the sleep mode, the module enters sleep mode when the DTR (wakeup pin) is high */
+static int ec20_sleep(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for ec20 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+QSCLK=1") < 0)
+    {
+        LOG_E("ec20 device(%s) enable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    if (ec20->wakeup_pin > 0)
+    {
+        rt_pin_mode(ec20->wakeup_pin, PIN_MODE_OUTPUT);
+        rt_pin_write(ec20->wakeup_pin, PIN_HIGH);
+    }
+
+    return RT_EOK;
+}
+
+/* pull down the DTR (wakeup pin) to wake up the module and disable the sleep mode */
+static int ec20_wakeup(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+    struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
+
+    if (ec20->wakeup_pin > 0)
+    {
+        rt_pin_write(ec20->wakeup_pin, PIN_LOW);
+    }
+
+    /* the UART is available after the module wakes up */
+    if (at_client_obj_wait_connect(device->client, EC20_WAIT_CONNECT_TIME))
+    {
+        LOG_E("ec20 device(%s) wakeup timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for ec20 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+QSCLK=0") < 0)
+    {
+        LOG_E("ec20 device(%s) disable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    return RT_EOK;
+}
+
+/* get the signal strength (dBm) by the received signal strength indication */
+static int ec20_get_signal(struct at_device *device, int *rssi)
+{
+    int result = RT_EOK, csq = 99, ber = 0;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(rssi);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for ec20 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSQ") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &csq, &ber) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* 99 not known or not detectable */
+    if (csq == 99)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    *rssi = -113 + 2 * csq;
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
 static int ec20_control(struct at_device *device, int cmd, void *arg)
 {
     int result = -RT_ERROR;
@@ -990,17 +987,25 @@ static int ec20_control(struct at_device *device, int cmd, void *arg)
     case AT_DEVICE_CTRL_POWER_ON:
     case AT_DEVICE_CTRL_POWER_OFF:
     case AT_DEVICE_CTRL_RESET:
-    case AT_DEVICE_CTRL_LOW_POWER:
-    case AT_DEVICE_CTRL_SLEEP:
-    case AT_DEVICE_CTRL_WAKEUP:
     case AT_DEVICE_CTRL_NET_CONN:
     case AT_DEVICE_CTRL_NET_DISCONN:
     case AT_DEVICE_CTRL_SET_WIFI_INFO:
-    case AT_DEVICE_CTRL_GET_SIGNAL:
     case AT_DEVICE_CTRL_GET_GPS:
     case AT_DEVICE_CTRL_GET_VER:
         LOG_W("ec20 not support the control command(%d).", cmd);
         break;
+    case AT_DEVICE_CTRL_GET_SIGNAL:
+        result = ec20_get_signal(device, (int *) arg);
+        break;
+    case AT_DEVICE_CTRL_LOW_POWER:
+        result = ec20_low_power(device, (struct at_device_low_power *) arg);
+        break;
+    case AT_DEVICE_CTRL_SLEEP:
+        result = ec20_sleep(device);
+        break;
+    case AT_DEVICE_CTRL_WAKEUP:
+        result = ec20_wakeup(device);
+        break;
     default:
         LOG_E("input error control command(%d).", cmd);
         break;
@@ -1016,16 +1021,24 @@ const struct at_device_ops ec20_device_ops =
     ec20_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class ec20_device_class;
+#endif
+
 static int ec20_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &ec20_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for ec20 device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill ec20 device class object */
 #ifdef AT_USING_SOCKET
@@ -33,8 +33,8 @@ extern "C" {
 
 #include <at_device.h>
 
-/* The maximum number of sockets supported by the ec20 device */
-#define AT_DEVICE_EC20_SOCKETS_NUM  5
+/* The maximum number of sockets supported by the ec20 device, the connect ID is 0 - 11 */
+#define AT_DEVICE_EC20_SOCKETS_NUM  12
 
 struct at_device_ec20
 {     
@@ -45,9 +45,21 @@ struct at_device_ec20
     int power_status_pin;
     size_t recv_line_num;
     struct at_device device;
+#ifdef AT_DEVICE_USING_STATIC
+    /* the static memory of the device, see AT_DEVICE_STATIC_BIND */
+#ifdef AT_USING_SOCKET
+    struct at_socket sockets[AT_DEVICE_EC20_SOCKETS_NUM];
+    struct at_device_socket_stats socket_stats[AT_DEVICE_EC20_SOCKETS_NUM];
+    rt_ubase_t recv_pool[AT_DEVICE_STATIC_RECV_SIZE / sizeof(rt_ubase_t)];
+    char domain_ip[16];
+#endif
+#endif /* AT_DEVICE_USING_STATIC */
 
     void *socket_data;
     void *user_data;
+
+    /* the module DTR pin to control the sleep mode, 0 or -1 if not connected */
+    int wakeup_pin;
 };
 
 #ifdef AT_USING_SOCKET
@@ -41,7 +41,7 @@
 #define EC20_MODULE_SEND_MAX_SIZE       1460
 
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define EC20_EVENT_CONN_OK             (1L << 0)
@@ -92,191 +92,6 @@ static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
     }
 }
 
-static void at_http_errcode_parse(int result)//HTTP
-{
-    switch(result)
-    {
-    case 0   : LOG_D("%d : Operation successful",         result); break;
-    case 701 : LOG_E("%d : HTTP(S) unknown error",        result); break;
-    case 702 : LOG_E("%d : HTTP(S) timeout",              result); break;
-    case 703 : LOG_E("%d : HTTP(S) busy",                 result); break;
-    case 704 : LOG_E("%d : HTTP(S) UART busy",            result); break;
-    case 705 : LOG_E("%d : HTTP(S) no GET/POST requests", result); break;
-    case 706 : LOG_E("%d : HTTP(S) network busy",         result); break;
-    case 707 : LOG_E("%d : HTTP(S) network open failed",  result); break;
-    case 708 : LOG_E("%d : HTTP(S) network no configuration", result); break;
-    case 709 : LOG_E("%d : HTTP(S) network deactivated",  result); break;
-    case 710 : LOG_E("%d : HTTP(S) network error",        result); break;
-    case 711 : LOG_E("%d : HTTP(S) URL error",            result); break;
-    case 712 : LOG_E("%d : HTTP(S) empty URL",            result); break;
-    case 713 : LOG_E("%d : HTTP(S) IP address error",     result); break;
-    case 714 : LOG_E("%d : HTTP(S) DNS error",            result); break;
-    case 715 : LOG_E("%d : HTTP(S) socket create error",  result); break;
-    case 716 : LOG_E("%d : HTTP(S) socket connect error", result); break;
-    case 717 : LOG_E("%d : HTTP(S) socket read error",    result); break;
-    case 718 : LOG_E("%d : HTTP(S) socket write error",   result); break;
-    case 719 : LOG_E("%d : HTTP(S) socket closed",        result); break;
-    case 720 : LOG_E("%d : HTTP(S) data encode error",    result); break;
-    case 721 : LOG_E("%d : HTTP(S) data decode error",    result); break;
-    case 722 : LOG_E("%d : HTTP(S) read timeout",         result); break;
-    case 723 : LOG_E("%d : HTTP(S) response failed",      result); break;
-    case 724 : LOG_E("%d : Incoming call busy",           result); break;
-    case 725 : LOG_E("%d : Voice call busy",              result); break;
-    case 726 : LOG_E("%d : Input timeout",                result); break;
-    case 727 : LOG_E("%d : Wait data timeout",            result); break;
-    case 728 : LOG_E("%d : Wait HTTP(S) response timeout", result); break;
-    case 729 : LOG_E("%d : Memory allocation failed",     result); break;
-    case 730 : LOG_E("%d : Invalid parameter",            result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_http_rsponsecode_parse(int result)//HTTP
-{
-    switch(result)
-    {
-    case 200 : LOG_D("%d : OK",                           result); break;
-    case 400 : LOG_E("%d : Bad request",                  result); break;
-    case 403 : LOG_E("%d : Forbidden",                    result); break;
-    case 404 : LOG_E("%d : Not found",                    result); break;
-    case 409 : LOG_E("%d : Conflict",                     result); break;
-    case 411 : LOG_E("%d : Length required",              result); break;
-    case 500 : LOG_E("%d : Internal server error",        result); break;
-    case 502 : LOG_E("%d : Bad gate way",                 result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_ftp_errcode_parse(int result)//FTP
-{
-    switch(result)
-    {
-    case 0   : LOG_D("%d : Operation successful",         result); break;
-    case 601 : LOG_E("%d : Unknown error",                result); break;
-    case 602 : LOG_E("%d : FTP(S) server blocked",        result); break;
-    case 603 : LOG_E("%d : FTP(S) server busy",           result); break;
-    case 604 : LOG_E("%d : DNS parse failed",             result); break;
-    case 605 : LOG_E("%d : Network error",                result); break;
-    case 606 : LOG_E("%d : Control connection closed.",   result); break;
-    case 607 : LOG_E("%d : Data connection closed",       result); break;
-    case 608 : LOG_E("%d : Socket closed by peer",        result); break;
-    case 609 : LOG_E("%d : Timeout error",                result); break;
-    case 610 : LOG_E("%d : Invalid parameter",            result); break;
-    case 611 : LOG_E("%d : Failed to open file",          result); break;
-    case 612 : LOG_E("%d : File position invalid",        result); break;
-    case 613 : LOG_E("%d : File error",                   result); break;
-    case 614 : LOG_E("%d : Service not available, closing control connection", result); break;
-    case 615 : LOG_E("%d : Open data connection failed",  result); break;
-    case 616 : LOG_E("%d : Connection closed; transfer aborted", result); break;
-    case 617 : LOG_E("%d : Requested file action not taken", result); break;
-    case 618 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 619 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 620 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 621 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 622 : LOG_E("%d : Command not implemented",      result); break;
-    case 623 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 624 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 625 : LOG_E("%d : Not logged in",                result); break;
-    case 626 : LOG_E("%d : Need account for storing files", result); break;
-    case 627 : LOG_E("%d : Requested action not taken",   result); break;
-    case 628 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
-    case 629 : LOG_E("%d : Requested file action aborted", result); break;
-    case 630 : LOG_E("%d : Requested file name invalid",  result); break;
-    case 631 : LOG_E("%d : SSL authentication failed",    result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_ftp_protocol_errcode_parse(int result)//FTP_Protocol
-{
-    switch(result)
-    {
-    case 421 : LOG_E("%d : Service not available, closing control connection", result); break;
-    case 425 : LOG_E("%d : Open data connection failed",  result); break;
-    case 426 : LOG_E("%d : Connection closed; transfer aborted", result); break;
-    case 450 : LOG_E("%d : Requested file action not taken", result); break;
-    case 451 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 452 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 500 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 501 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 502 : LOG_E("%d : Command not implemented",      result); break;
-    case 503 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 504 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 530 : LOG_E("%d : Not logged in",                result); break;
-    case 532 : LOG_E("%d : Need account for storing files", result); break;
-    case 550 : LOG_E("%d : Requested action not taken: file unavailable", result); break;
-    case 551 : LOG_E("%d : Requested action aborted: page type unknown", result); break;
-    case 552 : LOG_E("%d : Requested file action aborted: exceeded storage allocation", result); break;
-    case 553 : LOG_E("%d : Requested action not taken: file name not allowed", result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_smtp_errcode_parse(int result)//Email
-{
-    switch(result)
-    {
-    case 651 : LOG_E("%d : Unknown error",                result); break;
-    case 652 : LOG_E("%d : The SMTP server is busy, such as uploading the body or sending an email.", result); break;
-    case 653 : LOG_E("%d : Failed to get IP address according to the domain name.", result); break;
-    case 654 : LOG_E("%d : Network error, such as failed to activate GPRS/CSD context, failed to establish the TCP connection with the SMTP server or failed to send an email to the SMTP server, etc.", result); break;
-    case 655 : LOG_E("%d : Unsupported authentication type", result); break;
-    case 656 : LOG_E("%d : The connection for the SMTP server is closed by peer.", result); break;
-    case 657 : LOG_E("%d : GPRS/CSD context is deactivated.", result); break;
-    case 658 : LOG_E("%d : Timeout",                      result); break;
-    case 659 : LOG_E("%d : No recipient for the SMTP server", result); break;
-    case 660 : LOG_E("%d : Failed to send an email",      result); break;
-    case 661 : LOG_E("%d : Failed to open a file",        result); break;
-    case 662 : LOG_E("%d : No enough memory for the attachment", result); break;
-    case 663 : LOG_E("%d : Failed to save the attachment", result); break;
-    case 664 : LOG_E("%d : The input parameter is wrong", result); break;
-    case 665 : LOG_E("%d : SSL authentication failed",    result); break;
-    case 666 : LOG_E("%d : Service not available, closing transmission channel", result); break;
-    case 667 : LOG_E("%d : Requested mail action not taken: mailbox unavailable", result); break;
-    case 668 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 669 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 670 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 671 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 672 : LOG_E("%d : Command not implemented",      result); break;
-    case 673 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 674 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 675 : LOG_E("%d : <domain> does not accept mail (see RFC1846)", result); break;
-    case 676 : LOG_E("%d : Access denied",                result); break;
-    case 677 : LOG_E("%d : Authentication failed",        result); break;
-    case 678 : LOG_E("%d : Requested action not taken: mailbox unavailable", result); break;
-    case 679 : LOG_E("%d : User not local; please try <forward-path>", result); break;
-    case 680 : LOG_E("%d : Requested mail action aborted: exceeded storage allocation", result); break;
-    case 681 : LOG_E("%d : Requested action not taken: mailbox name not allowed", result); break;
-    case 682 : LOG_E("%d : Transaction failed",           result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
-static void at_smtp_protocol_errcode_parse(int result)//Email_Protocol
-{
-    switch(result)
-    {
-    case 421 : LOG_E("%d : Service not available, closing transmission channel", result); break;
-    case 450 : LOG_E("%d : Requested mail action not taken: mailbox unavailable", result); break;
-    case 451 : LOG_E("%d : Requested action aborted: local error in processing", result); break;
-    case 452 : LOG_E("%d : Requested action not taken: insufficient system storage", result); break;
-    case 500 : LOG_E("%d : Syntax error, command unrecognized", result); break;
-    case 501 : LOG_E("%d : Syntax error in parameters or arguments", result); break;
-    case 502 : LOG_E("%d : Command not implemented",      result); break;
-    case 503 : LOG_E("%d : Bad sequence of commands",     result); break;
-    case 504 : LOG_E("%d : Command parameter not implemented", result); break;
-    case 521 : LOG_E("%d : <domain> does not accept mail (see RFC1846)", result); break;
-    case 530 : LOG_E("%d : Access denied",                result); break;
-    case 535 : LOG_E("%d : Authentication failed",        result); break;
-    case 550 : LOG_E("%d : Requested action not taken: mailbox unavailable", result); break;
-    case 551 : LOG_E("%d : User not local; please try <forward-path>", result); break;
-    case 552 : LOG_E("%d : Requested mail action aborted: exceeded storage allocation", result); break;
-    case 553 : LOG_E("%d : Requested action not taken: mailbox name not allowed", result); break;
-    case 554 : LOG_E("%d : Transaction failed",           result); break;
-    default  : LOG_E("%d : Unknown err code",             result); break;
-    }
-}
-
 static int ec20_socket_event_send(struct at_device *device, uint32_t event)
 {
     return (int) rt_event_send(device->socket_event, event);
@@ -287,10 +102,10 @@ static int ec20_socket_event_recv(struct at_device *device, uint32_t event, uint
     int result = RT_EOK;
     rt_uint32_t recved;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
@@ -312,8 +127,11 @@ static int ec20_socket_close(struct at_socket *socket)
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
     
-    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 64, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -321,11 +139,11 @@ static int ec20_socket_close(struct at_socket *socket)
     }
 
     /* default connection timeout is 10 seconds, but it set to 1 seconds is convenient to use.*/
-    result = at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d,1", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+QICLOSE=%d,1", device_socket);
     
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -354,11 +172,15 @@ static int ec20_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     int result = 0, event_result = 0;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -380,7 +202,7 @@ __retry:
             /* contextID   = 1 : use same contextID as AT+QICSGP & AT+QIACT */
             /* local_port  = 0 : local port assigned automatically */
             /* access_mode = 1 : Direct push mode */
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+QIOPEN=1,%d,\"TCP\",\"%s\",%d,0,1", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -389,7 +211,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+QIOPEN=1,%d,\"UDP\",\"%s\",%d,0,1", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -402,6 +224,17 @@ __retry:
             return -RT_ERROR;
         }
     }
+    else if (type == AT_SOCKET_UDP)
+    {
+        /* the "UDP SERVICE" receives the datagrams from any peers on the local port, */
+        /* the destination is given by every send command */
+        if (at_device_exec_cmd(device, resp, 
+                "AT+QIOPEN=1,%d,\"UDP SERVICE\",\"127.0.0.1\",0,%d,1", device_socket, port) < 0)
+        {
+            result = -RT_ERROR;
+            goto __exit;
+        }
+    }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use.*/
     if (ec20_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
@@ -443,74 +276,39 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
-    return result;
-}
-
-static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acked, size_t *nacked)
-{
-    int result = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for ec20 device(%s) response structure.", device->name);
-        result = -RT_ENOMEM;
-        goto __exit;
-    }
-
-    if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,0", device_socket) < 0)
-    {
-        result = -RT_ERROR;
-        goto __exit;
-    }
-
-    if (at_resp_parse_line_args_by_kw(resp, "+QISEND:", "+QISEND: %d,%d,%d", size, acked, nacked) <= 0)
-    {
-        result = -RT_ERROR;
-        goto __exit;
-    }
-
-__exit:
-    if (resp)
+    if (result == RT_EOK)
     {
-        at_delete_resp(resp);
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
     }
 
     return result;
 }
 
-static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
+/**
+ * open the unconnected UDP socket by AT commands, the datagrams are sent to and received
+ * from any peers.
+ *
+ * @param socket current socket
+ * @param local_port local port of the socket
+ *
+ * @return   0: open success
+ *         < 0: open failed, see ec20_socket_connect()
+ */
+static int ec20_socket_udp_open(struct at_socket *socket, int local_port)
 {
-    /* get the timeout by the input data size */
-    rt_tick_t timeout = rt_tick_from_millisecond(settings_size);
-    rt_tick_t last_time = rt_tick_get();
-    size_t size = 0, acked = 0, nacked = 0xFFFF;
-
-    while (rt_tick_get() - last_time <= timeout)
-    {
-        at_get_send_size(socket, &size, &acked, &nacked);
-        if (nacked == 0)
-        {
-            return RT_EOK;
-        }
-        rt_thread_mdelay(50);
-    }
-
-    return -RT_ETIMEOUT;
+    return ec20_socket_connect(socket, "127.0.0.1", local_port, AT_SOCKET_UDP, RT_FALSE);
 }
 
 /**
- * send data to server or client by AT commands.
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -518,27 +316,60 @@ static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int ec20_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                             enum at_socket_type type)
 {
     uint32_t event = 0;
-    int result = 0, event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    int result = 0, event_result = 0, port = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
+    char ipstr[16] = {0};
+    rt_bool_t has_dest = RT_FALSE;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_ec20 *ec20 = (struct at_device_ec20 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
+
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, EC20_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    /* the data is queued and sent in one burst after the device wakes up when it's sleeping */
+    result = at_device_sleep_queue(socket, iov, iovcnt, type);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
+    /* the datagram of the unconnected UDP socket is sent to its own destination */
+    if (type == AT_SOCKET_UDP)
+    {
+        has_dest = at_device_udp_get_dest(device, device_socket, ipstr, &port);
+    }
 
     /* set current socket for send URC event */
     ec20->user_data = (void *) device_socket;
@@ -552,24 +383,33 @@ static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < EC20_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = EC20_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (has_dest)
+        {
+            result = at_device_exec_cmd(device, resp, "AT+QISEND=%d,%d,\"%s\",%d",
+                                        device_socket, cur_pkt_size, ipstr, port);
+        }
+        else
+        {
+            result = at_device_exec_cmd(device, resp, "AT+QISEND=%d,%d", device_socket, cur_pkt_size);
+        }
+        if (result < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* send the real data to server or client */
-        result = (int) at_client_send(buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -594,6 +434,7 @@ static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t b
         /* check result */
         if (event_result & EC20_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("ec20 device(%s) socket (%d) send failed.", device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
@@ -601,10 +442,10 @@ static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t b
 
         if (type == AT_SOCKET_TCP)
         {
-            // at_wait_send_finish(socket, cur_pkt_size);
             rt_thread_mdelay(10);
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -612,16 +453,36 @@ __exit:
     /* reset the end sign for data conflict */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see ec20_socket_sendv()
+ */
+static int ec20_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return ec20_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -640,19 +501,21 @@ static int ec20_domain_resolve(const char *name, char ip[16])
     int i, result;
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the ec20 device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_EC20);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization ec20 device failed.");
+        LOG_E("get ec20 device for domain resolve failed.");
         return -RT_ERROR;
-    } 
+    }
 
     /* the maximum response time is 60 seconds, but it set to 10 seconds is convenient to use. */
-    resp = at_create_resp(128, 0, 10 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 10 * RT_TICK_PER_SECOND);
     if (!resp)
     {
         LOG_E("no memory for ec20 device(%s) response structure.", device->name);
@@ -662,7 +525,7 @@ static int ec20_domain_resolve(const char *name, char ip[16])
     /* clear EC20_EVENT_DOMAIN_OK */
     ec20_socket_event_recv(device, EC20_EVENT_DOMAIN_OK, 0, RT_EVENT_FLAG_OR);
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=1,\"%s\"", name);
+    result = at_device_exec_cmd(device, resp, "AT+QIDNSGIP=1,\"%s\"", name);
     if (result < 0)
     {
         goto __exit;
@@ -707,9 +570,14 @@ static int ec20_domain_resolve(const char *name, char ip[16])
     }
 
  __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -745,6 +613,8 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "+QIOPEN: %d,%d", &device_socket , &result);
 
     if (result == 0)
@@ -773,6 +643,9 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get ec20 device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     ec20 = (struct at_device_ec20 *) device->user_data;
     device_socket = (int) ec20->user_data;
 
@@ -802,6 +675,8 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "+QIURC: \"closed\",%d", &device_socket);
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
@@ -815,10 +690,10 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
+    int device_socket = 0, port = 0;
     rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
+    rt_size_t bfsz = 0, temp_size = 0, head_size = 0;
+    char *recv_buf = RT_NULL, temp[8] = {0}, ipstr[16] = {0};
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
@@ -832,8 +707,11 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+QIURC: \"recv\",%d,%d", &device_socket, (int *) &bfsz);
+    at_device_stats_urc(device, data);
+
+    /* get the current socket and receive buffer size by receive data, */
+    /* "+QIURC: "recv",<connectID>,<len>,"<remote IP>",<remote port>" for the "UDP SERVICE" */
+    sscanf(data, "+QIURC: \"recv\",%d,%d,\"%15[^\"]\",%d", &device_socket, (int *) &bfsz, ipstr, &port);
     /* get receive timeout by receive buffer length */
     timeout = bfsz;
 
@@ -842,9 +720,16 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    /* the datagram of the unconnected UDP socket is received after its source header */
+    if (at_device_udp_is_unconnected(device, device_socket))
+    {
+        head_size = sizeof(struct at_device_udp_head);
+    }
+
+    recv_buf = (char *) at_device_recv_alloc(device, head_size + bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for ec20 device(%s) URC receive buffer (%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -863,32 +748,51 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    if (at_client_obj_recv(client, recv_buf + head_size, bfsz, timeout) != bfsz)
     {
         LOG_E("ec20 device(%s) receive size(%d) data failed.", device->name, bfsz);
         rt_free(recv_buf);
         return;
     }
-    
+
+    if (head_size > 0)
+    {
+        at_device_udp_head_set((struct at_device_udp_head *) recv_buf, ipstr, port, bfsz);
+    }
+
+    /* the received socket data proves the link is alive */
+    at_device_link_activity(device);
+
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, head_size + bfsz);
     }
 }
 
 static void urc_pdpdeact_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int connectID = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
 
     sscanf(data, "+QIURC: \"pdpdeact\",%d", &connectID);
 
     LOG_E("context (%d) is deactivated.", connectID);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device)
+    {
+        /* the link is down, only the context profile is activated again */
+        at_device_link_reactivate(device);
+    }
 }
 
 static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
@@ -908,6 +812,9 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
         LOG_E("get ec20 device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     ec20 = (struct at_device_ec20 *) device->user_data;
 
     for (i = 0; i < size; i++)
@@ -924,11 +831,15 @@ static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_
         /* set ec20 information socket data */
         if (ec20->socket_data == RT_NULL)
         {
+#ifdef AT_DEVICE_USING_STATIC
+            ec20->socket_data = ec20->domain_ip;
+#else
             ec20->socket_data = rt_calloc(1, sizeof(recv_ip));
             if (ec20->socket_data == RT_NULL)
             {
                 return;
             }
+#endif
         }
         rt_memcpy(ec20->socket_data, recv_ip, sizeof(recv_ip));
         
@@ -999,6 +910,8 @@ int ec20_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_EC20_SOCKETS_NUM;
     class->socket_ops = &ec20_socket_ops;
+    class->socket_sendv = ec20_socket_sendv;
+    class->socket_udp_open = ec20_socket_udp_open;
 
     return RT_EOK;
 }
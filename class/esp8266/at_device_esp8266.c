@@ -57,17 +57,20 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
     rt_uint32_t mac_addr[6] = {0};
     rt_uint32_t num = 0; 
     rt_uint8_t dhcp_stat = 0;
+#ifndef AT_DEVICE_USING_STATIC
     struct rt_delayed_work *delay_work = (struct rt_delayed_work *)work;
+#endif
     struct at_device *device = (struct at_device *)work_data;
     struct netdev *netdev = device->netdev;
-    struct at_client *client = device->client;
 
+#ifndef AT_DEVICE_USING_STATIC
     if (delay_work)
     {
         rt_free(delay_work);
     }
+#endif
 
-    resp = at_create_resp(512, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 512, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%d) response structure.", device->name);
@@ -75,7 +78,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
     }
     
     /* send mac addr query commond "AT+CIFSR" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+CIFSR") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIFSR") < 0)
     {
         goto __exit;
     }
@@ -87,7 +90,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send addr info query commond "AT+CIPSTA?" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+CIPSTA?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPSTA?") < 0)
     {
         LOG_E("esp8266 device(%s) send \"AT+CIPSTA?\" commands error.", device->name);
         goto __exit;
@@ -116,7 +119,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send dns server query commond "AT+CIPDNS_CUR?" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPDNS_CUR?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPDNS_CUR?") < 0)
     {
         LOG_W("please check and update device(%s) firmware to support the \"AT+CIPDNS_CUR?\" command.", device->name);
         goto __exit;
@@ -142,7 +145,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send DHCP query commond " AT+CWDHCP_CUR?" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+CWDHCP_CUR?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CWDHCP_CUR?") < 0)
     {
         goto __exit;
     }
@@ -160,7 +163,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 }
 
@@ -202,6 +205,7 @@ static int esp8266_netdev_set_down(struct netdev *netdev)
     {
         device->is_init = RT_FALSE;
         netdev_low_level_set_status(netdev, RT_FALSE);
+        at_device_set_ready(device, RT_FALSE);
         LOG_D("the network interface device(%s) set down status", netdev->name);        
     }
 
@@ -230,7 +234,7 @@ static int esp8266_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_add
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -255,7 +259,7 @@ static int esp8266_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_add
         rt_memcpy(esp8266_netmask_addr, inet_ntoa(netdev->netmask), IPADDR_SIZE);
 
     /* send addr info set commond "AT+CIPSTA_CUR=<ip>[,<gateway>,<netmask>]" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSTA_CUR=\"%s\",\"%s\",\"%s\"", 
+    if (at_device_exec_cmd(device, resp, "AT+CIPSTA_CUR=\"%s\",\"%s\",\"%s\"", 
             esp8266_ip_addr, esp8266_gw_addr, esp8266_netmask_addr) < 0)
     {
         LOG_E("esp8266 device(%s) set address information failed.", device->name);
@@ -279,7 +283,7 @@ static int esp8266_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_add
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -303,7 +307,7 @@ static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -311,7 +315,7 @@ static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
     }
 
     /* send dns server set commond "AT+CIPDNS_CUR=<enable>[,<DNS	server0>,<DNS	server1>]" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPDNS_CUR=1,\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPDNS_CUR=1,\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         LOG_E("esp8266 device(%s) set DNS server(%s) failed.", device->name, inet_ntoa(*dns_server));
         result = -RT_ERROR;
@@ -324,7 +328,7 @@ static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -348,7 +352,7 @@ static int esp8266_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.",device->name);
@@ -356,7 +360,7 @@ static int esp8266_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
     }
 
     /* send dhcp set commond "AT+CWDHCP_CUR=<mode>,<en>" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CWDHCP_CUR=%d,%d", ESP8266_STATION, is_enabled) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CWDHCP_CUR=%d,%d", ESP8266_STATION, is_enabled) < 0)
     {
         LOG_E("esp8266 device(%s) set DHCP status(%d) failed.", device->name, is_enabled);
         result = -RT_ERROR;
@@ -371,7 +375,7 @@ static int esp8266_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -400,7 +404,7 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(64, 0, timeout);
+    resp = at_device_resp_take(device, 64, 0, timeout);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -408,7 +412,7 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send domain commond "AT+CIPDOMAIN=<domain name>" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=\"%s\"", host) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=\"%s\"", host) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -422,7 +426,7 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send ping commond "AT+PING=<IP>" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+PING=\"%s\"", host) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+PING=\"%s\"", host) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -445,7 +449,7 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -481,7 +485,7 @@ void esp8266_netdev_netstat(struct netdev *netdev)
         goto __exit;
     }
 
-    resp = at_create_resp(ESP8266_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, ESP8266_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -489,7 +493,7 @@ void esp8266_netdev_netstat(struct netdev *netdev)
     }
 
     /* send network connection information commond "AT+CIPSTATUS" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSTATUS") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPSTATUS") < 0)
     {
         goto __exit;
     }
@@ -513,7 +517,7 @@ void esp8266_netdev_netstat(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (type)
@@ -545,7 +549,7 @@ static const struct netdev_ops esp8266_netdev_ops =
 #endif
 };
 
-static struct netdev *esp8266_netdev_add(const char *netdev_name)
+static struct netdev *esp8266_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define ETHERNET_MTU        1500
 #define HWADDR_LEN          6
@@ -553,7 +557,7 @@ static struct netdev *esp8266_netdev_add(const char *netdev_name)
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) netdev structure.", netdev_name);
@@ -579,17 +583,39 @@ static struct netdev *esp8266_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
+        (resp) = at_device_resp_set_info(device, (resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)               \
         {                                                                  \
             result = -RT_ERROR;                                            \
             goto __exit;                                                   \
         }                                                                  \
     } while(0)                                                             \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* disable echo and set current mode to Wi-Fi station, the esp8266 AT firmware not support command concatenation */
+static const struct at_device_step esp8266_start_steps[] =
+{
+    {"ATE0",        RT_NULL,     5000, 0, 0},
+    {"AT+CWMODE=1", RT_NULL,     5000, 0, 0},
+};
+
 static void esp8266_netdev_start_delay_work(struct at_device *device)
 {
     struct rt_delayed_work *net_work = RT_NULL;
+#ifdef AT_DEVICE_USING_STATIC
+    struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+
+    /* the static work is initialized with the device, it's only submitted again */
+    net_work = &(esp8266->net_work);
+#else
     net_work = (struct rt_delayed_work *)rt_calloc(1, sizeof(struct rt_delayed_work));
     if (net_work == RT_NULL)
     {
@@ -597,9 +623,69 @@ static void esp8266_netdev_start_delay_work(struct at_device *device)
     }
 
     rt_delayed_work_init(net_work, esp8266_get_netdev_info, (void *)device);
+#endif
     rt_work_submit(&(net_work->work), RT_TICK_PER_SECOND);
 }
 
+/**
+ * check whether the esp8266 device is still online after a host-only reboot, the module is
+ * online when it is associated to the configured AP, has got an IP address and works in
+ * multiple connections mode.
+ *
+ * @param device current AT device object
+ * @param resp response object used to execute the probe commands
+ *
+ * @return  RT_TRUE: the association can be reused, reset and re-join are not needed
+ *         RT_FALSE: the device must be reset and initialized again
+ */
+static rt_bool_t esp8266_check_online(struct at_device *device, at_response_t resp)
+{
+#define SSID_LEN       32
+    struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+    char ssid[SSID_LEN + 1] = {0};
+    int mux_mode = 0, status = 0;
+
+    resp = at_device_resp_set_info(device, resp, 256, 0, 5 * RT_TICK_PER_SECOND);
+
+    /* disable echo, it also check the module is alive */
+    if (at_device_exec_cmd(device, resp, "ATE0") < 0)
+    {
+        return RT_FALSE;
+    }
+
+    /* get the current associated AP, "No AP" is responsed when the module is not associated */
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CWJAP:", "+CWJAP:\"%32[^\"]\"", ssid) <= 0 ||
+            rt_strcmp(ssid, esp8266->wifi_ssid) != 0)
+    {
+        return RT_FALSE;
+    }
+
+    /* the multiple connections mode must be kept */
+    if (at_device_exec_cmd(device, resp, "AT+CIPMUX?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CIPMUX:", "+CIPMUX:%d", &mux_mode) <= 0 ||
+            mux_mode != 1)
+    {
+        return RT_FALSE;
+    }
+
+    /* status 2: got IP, 3: connected, 4: disconnected, others: not associated */
+    if (at_device_exec_cmd(device, resp, "AT+CIPSTATUS") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "STATUS:", "STATUS:%d", &status) <= 0 ||
+            status < 2 || status > 4)
+    {
+        return RT_FALSE;
+    }
+
+    /* close the connections created before the host reboot, they are unknown for AT socket */
+    if (status == 3)
+    {
+        at_device_exec_cmd(device, resp, "AT+CIPCLOSE=5");
+    }
+
+    return RT_TRUE;
+}
+
 static void esp8266_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY    5
@@ -619,23 +705,28 @@ static void esp8266_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%d) response structure.", device->name);
         return;
     }
     
+    /* reuse the current association if the module is still online, skip reset and re-join */
+    if (esp8266_check_online(device, resp))
+    {
+        LOG_I("esp8266 device(%s) is already online, skip reset.", device->name);
+        retry_num = 0;
+    }
+
     while (retry_num--)
     {
         /* reset module */
         AT_SEND_CMD(client, resp, "AT+RST");
         /* reset waiting delay */
         rt_thread_mdelay(1000);
-        /* disable echo */
-        AT_SEND_CMD(client, resp, "ATE0");
-        /* set current mode to Wi-Fi station */
-        AT_SEND_CMD(client, resp, "AT+CWMODE=1");
+        /* disable echo and set current mode to Wi-Fi station */
+        AT_EXEC_STEPS(device, resp, esp8266_start_steps);
         /* get module version */
         AT_SEND_CMD(client, resp, "AT+GMR");
         /* show module version */
@@ -647,7 +738,7 @@ static void esp8266_init_thread_entry(void *parameter)
         AT_SEND_CMD(client, resp, "AT+CIPMUX=1");
 
         /* connect to WiFi AP */
-        if (at_obj_exec_cmd(client, at_resp_set_info(resp, 128, 0, 20 * RT_TICK_PER_SECOND), 
+        if (at_device_exec_cmd(device, at_device_resp_set_info(device, resp, 128, 0, 20 * RT_TICK_PER_SECOND), 
                     "AT+CWJAP=\"%s\",\"%s\"", esp8266->wifi_ssid, esp8266->wifi_password) != RT_EOK)
         {
             LOG_E("AT device(%s) network initialize failed, check ssid(%s) and password(%s).", 
@@ -670,7 +761,7 @@ static void esp8266_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result != RT_EOK)
@@ -684,6 +775,7 @@ static void esp8266_init_thread_entry(void *parameter)
         netdev_low_level_set_status(device->netdev, RT_TRUE);
         netdev_low_level_set_link_status(device->netdev, RT_TRUE);
         esp8266_netdev_start_delay_work(device);
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("esp8266 device(%s) network initialize successfully.", device->name);
     }
 }
@@ -741,7 +833,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
         if (device->is_init)
         {
-            netdev_low_level_set_link_status(device->netdev, RT_TRUE);
+            at_device_link_notify(device, RT_TRUE);
             
             esp8266_netdev_start_delay_work(device);
         }
@@ -752,7 +844,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
         if (device->is_init)
         {
-            netdev_low_level_set_link_status(device->netdev, RT_FALSE);
+            at_device_link_notify(device, RT_FALSE);
         }
     }
 }
@@ -788,13 +880,17 @@ static int esp8266_init(struct at_device *device)
 #endif
 
     /* add esp8266 device to the netdev list */
-    device->netdev = esp8266_netdev_add(esp8266->device_name);
+    device->netdev = esp8266_netdev_add(device, esp8266->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("esp8266 device(%s) initialize failed, get network interface device failed.", esp8266->device_name);
         return -RT_ERROR;
     }
 
+#ifdef AT_DEVICE_USING_STATIC
+    rt_delayed_work_init(&(esp8266->net_work), esp8266_get_netdev_info, (void *) device);
+#endif
+
     /* initialize esp8266 device network */
     return esp8266_netdev_set_up(device->netdev);
 }
@@ -811,7 +907,7 @@ static int esp8266_reset(struct at_device *device)
     struct at_client *client = device->client;
 
     /* send "AT+RST" commonds to esp8266 device */
-    result = at_obj_exec_cmd(client, RT_NULL, "AT+RST");
+    result = at_device_exec_cmd(device, RT_NULL, "AT+RST");
     rt_thread_mdelay(1000);
 
     /* waiting 10 seconds for esp8266 device reset */
@@ -841,7 +937,7 @@ static int esp8266_wifi_info_set(struct at_device *device, struct at_device_ssid
          return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -849,7 +945,7 @@ static int esp8266_wifi_info_set(struct at_device *device, struct at_device_ssid
     }
     
     /* connect to input wifi ap */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
     {
         LOG_E("esp8266 device(%s) wifi connect failed, check ssid(%s) and password(%s).",  
                 device->name, info->ssid, info->password);
@@ -858,9 +954,104 @@ static int esp8266_wifi_info_set(struct at_device *device, struct at_device_ssid
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
+/* enter the modem sleep mode, disable it when the configuration is NULL */
+static int esp8266_low_power(struct at_device *device, struct at_device_low_power *config)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
     }
 
+    result = at_device_exec_cmd(device, resp, "AT+SLEEP=%d", config ? 2 : 0);
+    if (result < 0)
+    {
+        LOG_E("esp8266 device(%s) set sleep mode failed.", device->name);
+    }
+
+    at_device_resp_release(device, resp);
+
+    return result;
+}
+
+/* enter the deep sleep mode, the module restarts after the sleep time (milliseconds) */
+static int esp8266_sleep(struct at_device *device, rt_uint32_t *sleep_time)
+{
+    at_response_t resp = RT_NULL;
+
+    if (sleep_time == RT_NULL || *sleep_time == 0)
+    {
+        LOG_E("input esp8266 device(%s) deep sleep time error.", device->name);
+        return -RT_ERROR;
+    }
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+GSLP=%d", *sleep_time) < 0)
+    {
+        LOG_E("esp8266 device(%s) enter deep sleep failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    /* the network is disconnected in deep sleep mode */
+    at_device_set_ready(device, RT_FALSE);
+    netdev_low_level_set_link_status(device->netdev, RT_FALSE);
+
+    return RT_EOK;
+}
+
+/* wait the module restarts from deep sleep and initialize device network again */
+static int esp8266_wakeup(struct at_device *device)
+{
+    if (at_client_obj_wait_connect(device->client, ESP8266_WAIT_CONNECT_TIME))
+    {
+        LOG_E("esp8266 device(%s) wakeup timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    return esp8266_net_init(device);
+}
+
+/* get the signal strength (dBm) of the connected AP */
+static int esp8266_get_signal(struct at_device *device, int *rssi)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(rssi);
+
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CWJAP:", "+CWJAP:\"%*[^\"]\",\"%*[^\"]\",%*d,%d", rssi) <= 0)
+    {
+        result = -RT_ERROR;
+    }
+
+    at_device_resp_release(device, resp);
+
     return result;
 }
 
@@ -874,19 +1065,27 @@ static int esp8266_control(struct at_device *device, int cmd, void *arg)
     {
     case AT_DEVICE_CTRL_POWER_ON:
     case AT_DEVICE_CTRL_POWER_OFF:
-    case AT_DEVICE_CTRL_LOW_POWER:
-    case AT_DEVICE_CTRL_SLEEP:
-    case AT_DEVICE_CTRL_WAKEUP:
     case AT_DEVICE_CTRL_NET_CONN:
     case AT_DEVICE_CTRL_NET_DISCONN:
-    case AT_DEVICE_CTRL_GET_SIGNAL:
     case AT_DEVICE_CTRL_GET_GPS:
     case AT_DEVICE_CTRL_GET_VER:
         LOG_W("esp8266 not support the control command(%d).", cmd);
         break;
+    case AT_DEVICE_CTRL_GET_SIGNAL:
+        result = esp8266_get_signal(device, (int *) arg);
+        break;
     case AT_DEVICE_CTRL_RESET:
         result = esp8266_reset(device);
         break;
+    case AT_DEVICE_CTRL_LOW_POWER:
+        result = esp8266_low_power(device, (struct at_device_low_power *) arg);
+        break;
+    case AT_DEVICE_CTRL_SLEEP:
+        result = esp8266_sleep(device, (rt_uint32_t *) arg);
+        break;
+    case AT_DEVICE_CTRL_WAKEUP:
+        result = esp8266_wakeup(device);
+        break;
     case AT_DEVICE_CTRL_SET_WIFI_INFO:
         result = esp8266_wifi_info_set(device, (struct at_device_ssid_pwd *) arg);
         break;
@@ -905,16 +1104,24 @@ static const struct at_device_ops esp8266_device_ops =
     esp8266_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class esp8266_device_class;
+#endif
+
 static int esp8266_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &esp8266_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for esp8266 device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill ESP8266 device class object */
 #ifdef AT_USING_SOCKET
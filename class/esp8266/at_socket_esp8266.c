@@ -39,7 +39,7 @@
 
 #define ESP8266_MODULE_SEND_MAX_SIZE   2048
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define ESP8266_EVENT_CONN_OK          (1L << 0)
@@ -64,10 +64,10 @@ static int esp8266_socket_event_recv(struct at_device *device, uint32_t event, u
     int result = 0;
     rt_uint32_t recved;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
@@ -90,18 +90,21 @@ static int esp8266_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket);
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
@@ -128,11 +131,15 @@ static int esp8266_socket_connect(struct at_socket *socket, char *ip, int32_t po
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -146,7 +153,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -154,7 +161,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -167,6 +174,17 @@ __retry:
             goto __exit;
         }
     }
+    else if (type == AT_SOCKET_UDP)
+    {
+        /* the UDP link in mode 2 receives the datagrams from any peers on the local port, */
+        /* the "+IPD" URC reports the source of every datagram after AT+CIPDINFO=1 */
+        if (at_device_exec_cmd(device, resp, "AT+CIPDINFO=1") < 0 ||
+                at_device_exec_cmd(device, resp,
+                    "AT+CIPSTART=%d,\"UDP\",\"0.0.0.0\",%d,%d,2", device_socket, port, port) < 0)
+        {
+            result = -RT_ERROR;
+        }
+    }
 
     if (result != RT_EOK && retryed == RT_FALSE)
     {
@@ -184,18 +202,39 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
+    }
+
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
     }
 
     return result;
 }
 
 /**
- * send data to server or client by AT commands.
+ * open the unconnected UDP socket by AT commands, the datagrams are sent to and received
+ * from any peers.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param local_port local port of the socket
+ *
+ * @return   0: open success
+ *         < 0: open failed, see esp8266_socket_connect()
+ */
+static int esp8266_socket_udp_open(struct at_socket *socket, int local_port)
+{
+    return esp8266_socket_connect(socket, "0.0.0.0", local_port, AT_SOCKET_UDP, RT_FALSE);
+}
+
+/**
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
+ *
+ * @param socket current socket
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -203,28 +242,62 @@ __exit:
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int esp8266_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int esp8266_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                                enum at_socket_type type)
 {
     int result = RT_EOK;
-    int event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    int event_result = 0, port = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
+    char ipstr[16] = {0};
+    rt_bool_t has_dest = RT_FALSE;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, ESP8266_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    /* the module restarts from the deep sleep (AT+GSLP) and all sockets are closed, so the data
+     * isn't queued for sending after it wakes up */
+    if (at_device_is_sleep(device))
+    {
+        LOG_E("esp8266 device(%s) is in deep sleep, socket(%d) send failed.", device->name, device_socket);
+        return -RT_ERROR;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
+    /* the datagram of the unconnected UDP socket is sent to its own destination */
+    if (type == AT_SOCKET_UDP)
+    {
+        has_dest = at_device_udp_get_dest(device, device_socket, ipstr, &port);
+    }
 
     /* set current socket for send URC event */
     esp8266->user_data = (void *) device_socket;
@@ -234,24 +307,33 @@ static int esp8266_socket_send(struct at_socket *socket, const char *buff, size_
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < ESP8266_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = ESP8266_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
 
         /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (has_dest)
+        {
+            result = at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d,\"%s\",%d",
+                                        device_socket, cur_pkt_size, ipstr, port);
+        }
+        else
+        {
+            result = at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size);
+        }
+        if (result < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -277,11 +359,13 @@ static int esp8266_socket_send(struct at_socket *socket, const char *buff, size_
         /* check result */
         if (event_result & ESP8266_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("esp8266 device(%s) socket(%d) send failed.", device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -289,16 +373,36 @@ __exit:
     /* reset the end sign for data */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see esp8266_socket_sendv()
+ */
+static int esp8266_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return esp8266_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -317,18 +421,20 @@ static int esp8266_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the esp8266 device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_ESP8266);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization esp8266 device failed.");
+        LOG_E("get esp8266 device for domain resolve failed.");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for esp8266 device(%s) response structure.", device->name);
@@ -337,7 +443,7 @@ static int esp8266_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -366,9 +472,14 @@ static int esp8266_domain_resolve(const char *name, char ip[16])
     }
 
 __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -413,6 +524,9 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get esp8266 device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     esp8266 = (struct at_device_esp8266 *) device->user_data;
     device_socket = (int) esp8266->user_data;
 
@@ -451,6 +565,8 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "%d,CLOSED", &index);
     socket = &(device->sockets[index]);
 
@@ -463,10 +579,10 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
+    int device_socket = 0, port = 0;
     rt_int32_t timeout = 0;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
+    rt_size_t bfsz = 0, temp_size = 0, head_size = 0;
+    char *recv_buf = RT_NULL, temp[8] = {0}, ipstr[16] = {0};
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name; 
@@ -480,8 +596,11 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    /* get the at deveice socket and receive buffer size by receive data */
-    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
+    at_device_stats_urc(device, data);
+
+    /* get the at deveice socket and receive buffer size by receive data, */
+    /* "+IPD,<link>,<len>,<remote IP>,<remote port>:" after AT+CIPDINFO=1 */
+    sscanf(data, "+IPD,%d,%d,%15[^,],%d:", &device_socket, (int *) &bfsz, ipstr, &port);
 
     /* get receive timeout by receive buffer length */
     timeout = bfsz;
@@ -489,9 +608,16 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     if (device_socket < 0 || bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    /* the datagram of the unconnected UDP socket is received after its source header */
+    if (at_device_udp_is_unconnected(device, device_socket))
+    {
+        head_size = sizeof(struct at_device_udp_head);
+    }
+
+    recv_buf = (char *) at_device_recv_alloc(device, head_size + bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for esp8266 device(%s) URC receive buffer(%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -510,20 +636,27 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    if (at_client_obj_recv(client, recv_buf + head_size, bfsz, timeout) != bfsz)
     {
         LOG_E("esp8266 device(%s) receive size(%d) data failed.", device->name, bfsz);
         rt_free(recv_buf);
         return;
     }
 
+    if (head_size > 0)
+    {
+        at_device_udp_head_set((struct at_device_udp_head *) recv_buf, ipstr, port, bfsz);
+    }
+
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, head_size + bfsz);
     }
 }
 
@@ -552,6 +685,8 @@ int esp8266_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_ESP8266_SOCKETS_NUM;
     class->socket_ops = &esp8266_socket_ops;
+    class->socket_sendv = esp8266_socket_sendv;
+    class->socket_udp_open = esp8266_socket_udp_open;
 
     return RT_EOK;
 }
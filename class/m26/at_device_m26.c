@@ -41,7 +41,7 @@
 #define M26_THREAD_STACK_SIZE          1024
 #define M26_THREAD_PRIORITY            (RT_THREAD_PRIORITY_MAX/2)
 
-static void m26_power_on(struct at_device *device)
+static int m26_power_on(struct at_device *device)
 {
     struct at_device_m26 *m26 = RT_NULL;
 
@@ -50,23 +50,14 @@ static void m26_power_on(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (m26->power_pin == -1 || m26->power_status_pin == -1)
     {
-        return;
-    }
-
-    if (rt_pin_read(m26->power_status_pin) == PIN_HIGH)
-    {
-        return;
+        return RT_EOK;
     }
-    rt_pin_write(m26->power_pin, PIN_HIGH);
 
-    while (rt_pin_read(m26->power_status_pin) == PIN_LOW)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(m26->power_pin, PIN_LOW);
+    return at_device_power_switch(device, m26->power_pin, m26->power_status_pin,
+                                  RT_TRUE, AT_DEVICE_POWER_TIMEOUT);
 }
 
-static void m26_power_off(struct at_device *device)
+static int m26_power_off(struct at_device *device)
 {
     struct at_device_m26 *m26 = RT_NULL;
 
@@ -75,20 +66,11 @@ static void m26_power_off(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (m26->power_pin == -1 || m26->power_status_pin == -1)
     {
-        return;
-    }
-
-    if (rt_pin_read(m26->power_status_pin) == PIN_LOW)
-    {
-        return;
+        return RT_EOK;
     }
-    rt_pin_write(m26->power_pin, PIN_HIGH);
 
-    while (rt_pin_read(m26->power_status_pin) == PIN_HIGH)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(m26->power_pin, PIN_LOW);
+    return at_device_power_switch(device, m26->power_pin, m26->power_status_pin,
+                                  RT_FALSE, AT_DEVICE_POWER_TIMEOUT);
 }
 
 /* =============================  m26 network interface operations ============================= */
@@ -105,7 +87,6 @@ static int m26_netdev_set_info(struct netdev *netdev)
     ip_addr_t addr;
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
-    struct at_client *client = RT_NULL;
 
     if (netdev == RT_NULL)
     {
@@ -119,13 +100,12 @@ static int m26_netdev_set_info(struct netdev *netdev)
         LOG_E("get m26 deivce by netdev name failed.", netdev->name);
         return -RT_ERROR;
     }
-    client = device->client;
 
     /* set network interface device up status */
     netdev_low_level_set_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(M26_IEMI_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
+    resp = at_device_resp_take(device, M26_IEMI_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", netdev->name);
@@ -142,7 +122,7 @@ static int m26_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "AT+GSN" commond to get device IEMI */
-        if (at_obj_exec_cmd(client, resp, "AT+GSN") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+GSN") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -177,10 +157,10 @@ static int m26_netdev_set_info(struct netdev *netdev)
         #define IP_ADDR_SIZE_MAX    16
         char ipaddr[IP_ADDR_SIZE_MAX] = {0};
         
-        at_resp_set_info(resp, M26_IPADDR_RESP_SIZE, 2, M26_INFO_RESP_TIMO);
+        at_device_resp_set_info(device, resp, M26_IPADDR_RESP_SIZE, 2, M26_INFO_RESP_TIMO);
 
         /* send "AT+QILOCIP" commond to get IP address */
-        if (at_obj_exec_cmd(client, resp, "AT+QILOCIP") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QILOCIP") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -205,10 +185,10 @@ static int m26_netdev_set_info(struct netdev *netdev)
         #define DNS_ADDR_SIZE_MAX   16
         char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
 
-        at_resp_set_info(resp, M26_DNS_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
+        at_device_resp_set_info(device, resp, M26_DNS_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
 
         /* send "AT+QIDNSCFG?" commond to get DNS servers address */
-        if (at_obj_exec_cmd(client, resp, "AT+QIDNSCFG?") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QIDNSCFG?") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -235,89 +215,76 @@ static int m26_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
 }
 
-static void check_link_status_entry(void *parameter)
+static rt_bool_t m26_link_parse(at_response_t resp)
 {
 #define M26_LINK_STATUS_OK   0
-#define M26_LINK_RESP_SIZE   64
-#define M26_LINK_RESP_TIMO   (3 * RT_TICK_PER_SECOND)
-#define M26_LINK_DELAY_TIME  (30 * RT_TICK_PER_SECOND)
 
-    struct netdev *netdev = (struct netdev *)parameter;
-    struct at_device *device = RT_NULL;
+    int link_status = -1;
+
+    at_resp_parse_line_args_by_kw(resp, "+QNSTATUS:", "+QNSTATUS: %d", &link_status);
+
+    return (M26_LINK_STATUS_OK == link_status) ? RT_TRUE : RT_FALSE;
+}
+
+/* reactivate the GPRS context after it's deactivated by the network */
+static int m26_link_reactivate(struct at_device *device)
+{
+#define M26_REACT_RESP_SIZE      64
+
+    int result = RT_EOK;
     at_response_t resp = RT_NULL;
-    int link_status;
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
-    if (device == RT_NULL)
+    /* the "DEACT OK" response has no "OK" line, it's ended by the response line number */
+    resp = at_device_resp_take(device, M26_REACT_RESP_SIZE, 2, rt_tick_from_millisecond(20 * 1000));
+    if (resp == RT_NULL)
     {
-        LOG_E("get m26 deivce by netdev name failed.", netdev->name);
-        return;
+        LOG_E("no memory for m26 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
     }
 
-    resp = at_create_resp(M26_LINK_RESP_SIZE, 0, M26_LINK_RESP_TIMO);
-    if (resp == RT_NULL)
+    /* the context should be deactivated before the APN is registered again */
+    if (at_device_exec_cmd(device, resp, "AT+QIDEACT") < 0)
     {
-        LOG_E("no memory for m26 device(%s) response object.", netdev->name);
-        return;
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-   while (1)
-    { 
-        
-        /* send "AT+QNSTATUS" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QNSTATUS") < 0)
-        {
-            rt_thread_mdelay(M26_LINK_DELAY_TIME);
-
-           continue;
-        }
-        
-        link_status = -1;
-        at_resp_parse_line_args_by_kw(resp, "+QNSTATUS:", "+QNSTATUS: %d", &link_status);
-
-        /* check the network interface device link status  */
-        if ((M26_LINK_STATUS_OK == link_status) != netdev_is_link_up(netdev))
-        {
-            netdev_low_level_set_link_status(netdev, (M26_LINK_STATUS_OK == link_status));
-        }
-
-        rt_thread_mdelay(M26_LINK_DELAY_TIME);
+    resp = at_device_resp_set_info(device, resp, M26_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (at_device_exec_cmd(device, resp, "AT+QIREGAPP") < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
     }
-}
-
-static int m26_netdev_check_link_status(struct netdev *netdev)
-{
-#define M26_LINK_THREAD_TICK           20
-#define M26_LINK_THREAD_STACK_SIZE     512
-#define M26_LINK_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
-
-    rt_thread_t tid;
-    char tname[RT_NAME_MAX] = {0};
 
-    if (netdev == RT_NULL)
+    resp = at_device_resp_set_info(device, resp, M26_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(20 * 1000));
+    if (at_device_exec_cmd(device, resp, "AT+QIACT") < 0)
     {
-        LOG_E("input network interface device is NULL.");
-        return -RT_ERROR;
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    rt_snprintf(tname, RT_NAME_MAX, "%s_link", netdev->name);
+    /* the IP address may be changed, update the network interface device information */
+    result = m26_netdev_set_info(device->netdev);
 
-    tid = rt_thread_create(tname, check_link_status_entry, (void *)netdev, 
-            M26_LINK_THREAD_STACK_SIZE, M26_LINK_THREAD_PRIORITY, M26_LINK_THREAD_TICK);
-    if (tid)
-    {
-        rt_thread_startup(tid);
-    }
+__exit:
+    at_device_resp_release(device, resp);
 
-    return RT_EOK;
+    return result;
 }
 
+static const struct at_device_link_ops m26_link_ops =
+{
+    "AT+QNSTATUS",
+    m26_link_parse,
+    m26_link_reactivate,
+};
+
 static int m26_net_init(struct at_device *device);
 
 static int m26_netdev_set_up(struct netdev *netdev)
@@ -360,6 +327,7 @@ static int m26_netdev_set_down(struct netdev *netdev)
         device->is_init = RT_FALSE;
 
         netdev_low_level_set_status(netdev, RT_FALSE);
+        at_device_set_ready(device, RT_FALSE);
         LOG_D("the network interface device(%s) set down status.", netdev->name);
     }
 
@@ -385,7 +353,7 @@ static int m26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M26_DNS_RESP_LEN, 0, M26_DNS_RESP_TIMEO);
+    resp = at_device_resp_take(device, M26_DNS_RESP_LEN, 0, M26_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response object.", netdev->name);
@@ -393,7 +361,7 @@ static int m26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
     }
 
     /* send "AT+QIDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_exec_cmd(resp, "AT+QIDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QIDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -404,7 +372,7 @@ static int m26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     return result;
 }
@@ -434,14 +402,14 @@ static int m26_netdev_ping(struct netdev *netdev, const char *host,
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M26_PING_RESP_SIZE, 5, M26_PING_TIMEO);
+    resp = at_device_resp_take(device, M26_PING_RESP_SIZE, 5, M26_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response object.", netdev->name);
         return  -RT_ENOMEM;
     }
     /* send "AT+QPING="<host>"[,[<timeout>][,<pingnum>]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+QPING=\"%s\",%d,1", host, M26_PING_TIMEO / RT_TICK_PER_SECOND) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QPING=\"%s\",%d,1", host, M26_PING_TIMEO / RT_TICK_PER_SECOND) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -480,7 +448,7 @@ static int m26_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -511,7 +479,7 @@ const struct netdev_ops m26_netdev_ops =
 #endif
 };
 
-static struct netdev *m26_netdev_add(const char *netdev_name)
+static struct netdev *m26_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define M26_NETDEV_MTU       1500
 
@@ -519,7 +487,7 @@ static struct netdev *m26_netdev_add(const char *netdev_name)
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) netdev structure.", netdev_name);
@@ -544,32 +512,52 @@ static struct netdev *m26_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
-        if (at_obj_exec_cmd((client),(resp), (cmd)) < 0)                                           \
+        (resp) = at_device_resp_set_info(device, (resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)                                       \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
             goto __exit;                                                                           \
         }                                                                                          \
     } while(0);                                                                                    \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* check SIM card, signal strength and wait the GSM, GPRS network is registered */
+static const struct at_device_step m26_net_steps[] =
+{
+    {"AT+CPIN?",    "READY",     5000, 9,  0, 1000},
+    {"AT+CSQ",      "+CSQ: 99,99", 300, 9, AT_DEVICE_STEP_EXCLUDE, 1000},
+    {"AT+CREG?",    "+CREG: 0,1|+CREG: 0,5", 300, 9, 0, 1000},
+    {"AT+CGREG?",   "+CGREG: 0,1|+CGREG: 0,5", 300, 19, 0, 1000},
+};
+
+/* set foreground context and the APN of GPRS context */
+static const struct at_device_step m26_context_steps[] =
+{
+    {"AT+QIFGCNT=0",            RT_NULL, 300, 0, AT_DEVICE_STEP_COALESCE},
+    {"AT+QICSGP=1, \"CMNET\"",  RT_NULL, 300, 0, AT_DEVICE_STEP_COALESCE},
+};
+
 /* init for m26 or mc20 */
 static void m26_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY                     5
-#define CPIN_RETRY                     10
-#define CSQ_RETRY                      10
-#define CREG_RETRY                     10
-#define CGREG_RETRY                    20
 
     at_response_t resp = RT_NULL;
     int i, qimux, qimode;
     int retry_num = INIT_RETRY;
-    char parsed_data[10];
     rt_err_t result = RT_EOK;
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", device->name);
@@ -581,7 +569,11 @@ static void m26_init_thread_entry(void *parameter)
     while (retry_num--)
     {
         /* power on the m26 device */
-        m26_power_on(device);
+        if (m26_power_on(device) < 0)
+        {
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
         rt_thread_mdelay(1000);
 
         /* wait m26|mc20 startup finish */
@@ -600,85 +592,11 @@ static void m26_init_thread_entry(void *parameter)
         {
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check SIM card */
-        for (i = 0; i < CPIN_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 2, 5 * RT_TICK_PER_SECOND, "AT+CPIN?");
-
-            if (at_resp_get_line_by_kw(resp, "READY"))
-            {
-                LOG_D("m26 device(%s) SIM card detection success.", device->name);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CPIN_RETRY)
-        {
-            LOG_E("SIM card detection failed!");
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %s", &parsed_data);
-            if (rt_strncmp(parsed_data, "99,99", sizeof(parsed_data)))
-            {
-                LOG_D("m26 device(%s) signal strength: %s", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("m26 device(%s) signal strength check failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) || 
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("m26 device(%s) GSM network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CREG_RETRY)
-        {
-            LOG_E("m26 device(%s) GSM network is register failed(%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) || 
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("m26 device(%s) GPRS network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("m26 device(%s) GPRS network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
+        /* check SIM card, signal strength and wait the GSM, GPRS network is registered */
+        AT_EXEC_STEPS(device, resp, m26_net_steps);
 
-        AT_SEND_CMD(client, resp, 0, 300, "AT+QIFGCNT=0");
-        AT_SEND_CMD(client, resp, 0, 300, "AT+QICSGP=1, \"CMNET\"");
+        /* set foreground context and the APN of GPRS context */
+        AT_EXEC_STEPS(device, resp, m26_context_steps);
         AT_SEND_CMD(client, resp, 0, 300, "AT+QIMODE?");
 
         at_resp_parse_line_args_by_kw(resp, "+QIMODE:", "+QIMODE: %d", &qimode);
@@ -723,14 +641,19 @@ static void m26_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result == RT_EOK)
     {
         m26_netdev_set_info(device->netdev);
-        m26_netdev_check_link_status(device->netdev);
+        at_device_link_monitor(device, &m26_link_ops);
+#ifdef AT_USING_SOCKET
+        /* the data length of one send command, the class default is used if it's not probed */
+        at_device_probe_send_max(device, "AT+QISEND=?", "+QISEND:");
+#endif
 
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("m26 device(%s) network initialize successfully.", device->name);
     }
     else
@@ -798,7 +721,7 @@ static int m26_init(struct at_device *device)
 #endif
 
     /* add m26 netdev to the netdev list */
-    device->netdev = m26_netdev_add(m26->device_name);
+    device->netdev = m26_netdev_add(device, m26->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("m26 device(%s) initialize failed, get network interface device failed.", m26->device_name);
@@ -821,6 +744,46 @@ static int m26_deinit(struct at_device *device)
     return m26_netdev_set_down(device->netdev);
 }
 
+/* get the signal strength (dBm) by the received signal strength indication */
+static int m26_get_signal(struct at_device *device, int *rssi)
+{
+    int result = RT_EOK, csq = 99, ber = 0;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(rssi);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for m26 device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSQ") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &csq, &ber) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* 99 not known or not detectable */
+    if (csq == 99)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    *rssi = -113 + 2 * csq;
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
 static int m26_control(struct at_device *device, int cmd, void *arg)
 {
     int result = -RT_ERROR;
@@ -838,11 +801,13 @@ static int m26_control(struct at_device *device, int cmd, void *arg)
     case AT_DEVICE_CTRL_NET_CONN:
     case AT_DEVICE_CTRL_NET_DISCONN:
     case AT_DEVICE_CTRL_SET_WIFI_INFO:
-    case AT_DEVICE_CTRL_GET_SIGNAL:
     case AT_DEVICE_CTRL_GET_GPS:
     case AT_DEVICE_CTRL_GET_VER:
         LOG_W("m26 not support the control command(%d).", cmd);
         break;
+    case AT_DEVICE_CTRL_GET_SIGNAL:
+        result = m26_get_signal(device, (int *) arg);
+        break;
     default:
         LOG_E("input error control command(%d).", cmd);
         break;
@@ -857,16 +822,24 @@ static const struct at_device_ops m26_device_ops =
     m26_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class m26_device_class;
+#endif
+
 static int m26_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &m26_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for m26 device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill m26 device class object */
 #ifdef AT_USING_SOCKET
@@ -45,6 +45,14 @@ struct at_device_m26
     int power_status_pin;
     size_t recv_line_num;
     struct at_device device;
+#ifdef AT_DEVICE_USING_STATIC
+    /* the static memory of the device, see AT_DEVICE_STATIC_BIND */
+#ifdef AT_USING_SOCKET
+    struct at_socket sockets[AT_DEVICE_M26_SOCKETS_NUM];
+    struct at_device_socket_stats socket_stats[AT_DEVICE_M26_SOCKETS_NUM];
+    rt_ubase_t recv_pool[AT_DEVICE_STATIC_RECV_SIZE / sizeof(rt_ubase_t)];
+#endif
+#endif /* AT_DEVICE_USING_STATIC */
 
     void *user_data;
 };
@@ -40,7 +40,7 @@
 #define M26_MODULE_SEND_MAX_SIZE       1460
 
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define M26_EVENT_CONN_OK              (1L << 0)
@@ -66,10 +66,10 @@ static int m26_socket_event_recv(struct at_device *device, uint32_t event, uint3
     int result = 0;
     rt_uint32_t recved = 0;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
@@ -91,8 +91,11 @@ static int m26_socket_close(struct at_socket *socket)
     at_response_t resp = RT_NULL;
     int device_socke = (int) socket->user_data;
     struct at_device *device  = (struct at_device *) socket->device;
+
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
     
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", device->name);
@@ -102,7 +105,7 @@ static int m26_socket_close(struct at_socket *socket)
     /* clear socket close event */
     m26_socket_event_recv(device, SET_EVENT(device_socke, M26_EVNET_CLOSE_OK), 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d", device_socke) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QICLOSE=%d", device_socke) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -119,7 +122,7 @@ static int m26_socket_close(struct at_socket *socket)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -146,8 +149,12 @@ static int m26_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     int result = 0, event_result = 0;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
+
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", device->name);
@@ -169,7 +176,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+QIOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -178,7 +185,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+QIOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -229,7 +236,12 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
+    }
+
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
     }
 
     return result;
@@ -242,7 +254,7 @@ static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acke
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 64, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure!", device->name);
@@ -250,7 +262,7 @@ static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acke
         goto __exit;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QISACK=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QISACK=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -266,7 +278,7 @@ static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acke
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -293,11 +305,12 @@ static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
 }
 
 /**
- * send data to server or client by AT commands.
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -305,27 +318,45 @@ static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int m26_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                            enum at_socket_type type)
 {
     int result = 0, event_result = 0;
-    size_t pkt_size = 0, sent_size = 0;
+    size_t bfsz = 0, pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_m26 *m26 = (struct at_device_m26 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
+
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, M26_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
     /* Clear socket send event */
     event_result = SET_EVENT(device_socket, M26_EVENT_SEND_OK | M26_EVENT_SEND_FAIL);
     m26_socket_event_recv(device, event_result, 0, RT_EVENT_FLAG_OR);
@@ -337,24 +368,24 @@ static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bf
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < M26_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             pkt_size = bfsz - sent_size;
         }
         else
         {
-            pkt_size = M26_MODULE_SEND_MAX_SIZE;
+            pkt_size = send_max_size;
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QISEND=%d,%d", device_socket, pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -379,6 +410,7 @@ static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bf
         /* check result */
         if (event_result & M26_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("m26 device(%s) socket(%d) send failed.", device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
@@ -389,6 +421,7 @@ static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bf
             at_wait_send_finish(socket, pkt_size);
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, pkt_size);
         sent_size += pkt_size;
     }
 
@@ -396,16 +429,36 @@ __exit:
     /* reset the end sign for data conflict */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see m26_socket_sendv()
+ */
+static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return m26_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -425,19 +478,21 @@ static int m26_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the m26 device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_M26_MC20);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization m26 device failed.");
+        LOG_E("get m26 device for domain resolve failed.");
         return -RT_ERROR;
     }
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for m26 device(%s) response structure.", device->name);
@@ -446,7 +501,7 @@ static int m26_domain_resolve(const char *name, char ip[16])
 
     for(i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -476,9 +531,14 @@ static int m26_domain_resolve(const char *name, char ip[16])
     }
 
 __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -514,6 +574,8 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "%d%*[^0-9]", &device_socket);
     
     if (rt_strstr(data, "CONNECT OK"))
@@ -541,6 +603,9 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get m26 device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     m26 = (struct at_device_m26 *) device->user_data;
     device_socket = (int) m26->user_data;
 
@@ -609,6 +674,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     /* get the current socket and receive buffer size by receive data */
     sscanf(data, "+RECEIVE: %d, %d", &device_socket, (int *) &bfsz);
 
@@ -620,9 +687,10 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for m26 device(%s) urc receive buffer (%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -648,9 +716,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    /* the received socket data proves the link is alive */
+    at_device_link_activity(device);
+
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
@@ -658,6 +731,28 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 }
 
+static void urc_pdp_deact_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get m26 device by client name(%s) failed.", client_name);
+        return;
+    }
+
+    at_device_stats_urc(device, data);
+
+    LOG_E("m26 device(%s) GPRS context is deactivated.", device->name);
+
+    /* the link is down, only the GPRS context is activated again */
+    at_device_link_reactivate(device);
+}
+
 static const struct at_urc urc_table[] = 
 {
     {"",            ", CONNECT OK\r\n",     urc_connect_func},
@@ -667,6 +762,7 @@ static const struct at_urc urc_table[] =
     {"",            ", CLOSE OK\r\n",       urc_close_func},
     {"",            ", CLOSED\r\n",         urc_close_func},
     {"+RECEIVE:",   "\r\n",                 urc_recv_func},
+    {"+PDP DEACT",  "\r\n",                 urc_pdp_deact_func},
 };
 
 static const struct at_socket_ops m26_socket_ops = 
@@ -694,6 +790,7 @@ int m26_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_M26_SOCKETS_NUM;
     class->socket_ops = &m26_socket_ops;
+    class->socket_sendv = m26_socket_sendv;
 
     return RT_EOK;
 }
@@ -55,17 +55,20 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
     rt_uint32_t mac_addr[6] = {0};
     rt_uint32_t num = 0;
     rt_uint8_t dhcp_stat = 0;
+#ifndef AT_DEVICE_USING_STATIC
     struct rt_delayed_work *delay_work = (struct rt_delayed_work *)work;
+#endif
     struct at_device *device = (struct at_device *)work_data;
     struct netdev *netdev = device->netdev;
-    struct at_client *client = device->client;
 
+#ifndef AT_DEVICE_USING_STATIC
     if (delay_work)
     {
         rt_free(delay_work);
     }
+#endif
 
-    resp = at_create_resp(512, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 512, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%d) response structure.", device->name);
@@ -73,7 +76,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send mac addr query commond "AT+CIFSR" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+WMAC?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+WMAC?") < 0)
     {
         goto __exit;
     }
@@ -85,7 +88,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send addr info query commond "AT+CIPSTA?" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+WJAPIP?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+WJAPIP?") < 0)
     {
         LOG_E("mw31 device(%s) send \"AT+WJAPIP?\" commands error.", device->name);
         goto __exit;
@@ -125,7 +128,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
     }
 
     /* send DHCP query commond " AT+WDHCP?" and wait response */
-    if (at_obj_exec_cmd(client, resp, "AT+WDHCP?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+WDHCP?") < 0)
     {
         goto __exit;
     }
@@ -147,7 +150,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 }
 
@@ -189,6 +192,7 @@ static int mw31_netdev_set_down(struct netdev *netdev)
     {
         device->is_init = RT_FALSE;
         netdev_low_level_set_status(netdev, RT_FALSE);
+        at_device_set_ready(device, RT_FALSE);
         LOG_D("the network interface device(%s) set down status", netdev->name);
     }
 
@@ -217,7 +221,7 @@ static int mw31_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -242,7 +246,7 @@ static int mw31_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
         rt_memcpy(mw31_netmask_addr, inet_ntoa(netdev->netmask), IPADDR_SIZE);
 
     /* send addr info set commond "AT+WJAPIP=<ip>,<network>,<gateway>[,<dns>] " and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+WJAPIP=%s,%s,%s",
+    if (at_device_exec_cmd(device, resp, "AT+WJAPIP=%s,%s,%s",
                         mw31_ip_addr, mw31_netmask_addr, mw31_gw_addr) < 0)
     {
         LOG_E("mw31 device(%s) set address information failed.", device->name);
@@ -266,7 +270,7 @@ static int mw31_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -290,7 +294,7 @@ static int mw31_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -298,7 +302,7 @@ static int mw31_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
     }
 
     /* send dns server set commond "AT+WJAPIP=<ip>,<network>,<gateway>[,<dns>] " and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+WJAPIP=%s,%s,%s,%s",
+    if (at_device_exec_cmd(device, resp, "AT+WJAPIP=%s,%s,%s,%s",
                         mw31_ip_addr, mw31_netmask_addr, mw31_gw_addr, inet_ntoa(*dns_server)) < 0)
     {
         LOG_E("mw31 device(%s) set DNS server(%s) failed.", device->name, inet_ntoa(*dns_server));
@@ -312,7 +316,7 @@ static int mw31_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -337,7 +341,7 @@ static int mw31_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -353,7 +357,7 @@ static int mw31_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         send_buf = "AT+WDHCP=OFF";
     }
     /* send dhcp set commond "AT+WDHCP=" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, send_buf) < 0)
+    if (at_device_exec_cmd(device, resp, send_buf) < 0)
     {
         LOG_E("mw31 device(%s) set DHCP status(%d) failed.", device->name, is_enabled);
         result = -RT_ERROR;
@@ -368,7 +372,7 @@ static int mw31_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -397,7 +401,7 @@ static int mw31_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(64, 0, timeout);
+    resp = at_device_resp_take(device, 64, 0, timeout);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -405,7 +409,7 @@ static int mw31_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send domain commond "AT+CIPDOMAIN=<domain name>" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=\"%s\"", host) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=\"%s\"", host) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -419,7 +423,7 @@ static int mw31_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send ping commond "AT+PING=<IP>" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+PING=\"%s\"", host) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+PING=\"%s\"", host) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -442,7 +446,7 @@ static int mw31_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -478,7 +482,7 @@ void mw31_netdev_netstat(struct netdev *netdev)
         goto __exit;
     }
 
-    resp = at_create_resp(MW31_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, MW31_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -486,7 +490,7 @@ void mw31_netdev_netstat(struct netdev *netdev)
     }
 
     /* send network connection information commond "AT+CIPSTATUS" and wait response */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPSTATUS") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPSTATUS") < 0)
     {
         goto __exit;
     }
@@ -510,7 +514,7 @@ void mw31_netdev_netstat(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (type)
@@ -542,7 +546,7 @@ static const struct netdev_ops mw31_netdev_ops =
 #endif
 };
 
-static struct netdev *mw31_netdev_add(const char *netdev_name)
+static struct netdev *mw31_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define ETHERNET_MTU        1500
 #define HWADDR_LEN          6
@@ -550,7 +554,7 @@ static struct netdev *mw31_netdev_add(const char *netdev_name)
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) netdev structure.", netdev_name);
@@ -576,8 +580,8 @@ static struct netdev *mw31_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
+        (resp) = at_device_resp_set_info(device, (resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)               \
         {                                                                  \
             result = -RT_ERROR;                                            \
             goto __exit;                                                   \
@@ -587,6 +591,12 @@ static struct netdev *mw31_netdev_add(const char *netdev_name)
 static void mw31_netdev_start_delay_work(struct at_device *device)
 {
     struct rt_delayed_work *net_work = RT_NULL;
+#ifdef AT_DEVICE_USING_STATIC
+    struct at_device_mw31 *mw31 = (struct at_device_mw31 *) device->user_data;
+
+    /* the static work is initialized with the device, it's only submitted again */
+    net_work = &(mw31->net_work);
+#else
     net_work = (struct rt_delayed_work *)rt_calloc(1, sizeof(struct rt_delayed_work));
     if (net_work == RT_NULL)
     {
@@ -594,9 +604,46 @@ static void mw31_netdev_start_delay_work(struct at_device *device)
     }
 
     rt_delayed_work_init(net_work, mw31_get_netdev_info, (void *)device);
+#endif
     rt_work_submit(&(net_work->work), RT_TICK_PER_SECOND);
 }
 
+/**
+ * check whether the mw31 device is still online after a host-only reboot, the module is
+ * online when the station is up and associated to the configured AP.
+ *
+ * @param device current AT device object
+ * @param resp response object used to execute the probe commands
+ *
+ * @return  RT_TRUE: the association can be reused, reboot and re-join are not needed
+ *         RT_FALSE: the device must be rebooted and initialized again
+ */
+static rt_bool_t mw31_check_online(struct at_device *device, at_response_t resp)
+{
+#define SSID_LEN       32
+    struct at_device_mw31 *mw31 = (struct at_device_mw31 *) device->user_data;
+    char ssid[SSID_LEN + 1] = {0};
+
+    resp = at_device_resp_set_info(device, resp, 256, 0, 5 * RT_TICK_PER_SECOND);
+
+    /* get the station status, "STATION_UP" is responsed when the module has got IP address */
+    if (at_device_exec_cmd(device, resp, "AT+WJAPS") < 0 ||
+            at_resp_get_line_by_kw(resp, "STATION_UP") == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+
+    /* get the current associated AP */
+    if (at_device_exec_cmd(device, resp, "AT+WJAP?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+WJAP:", "+WJAP:%32[^,]", ssid) <= 0 ||
+            rt_strcmp(ssid, mw31->wifi_ssid) != 0)
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
 static void mw31_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY    2
@@ -616,13 +663,20 @@ static void mw31_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%d) response structure.", device->name);
         return;
     }
 
+    /* reuse the current association if the module is still online, skip reboot and re-join */
+    if (mw31_check_online(device, resp))
+    {
+        LOG_I("mw31 device(%s) is already online, skip reboot.", device->name);
+        retry_num = 0;
+    }
+
     while (retry_num--)
     {
         /* reset module */
@@ -642,7 +696,7 @@ static void mw31_init_thread_entry(void *parameter)
         }
 
         /* connect to WiFi AP */
-        if (at_obj_exec_cmd(client, at_resp_set_info(resp, 128, 0, 20 * RT_TICK_PER_SECOND),
+        if (at_device_exec_cmd(device, at_device_resp_set_info(device, resp, 128, 0, 20 * RT_TICK_PER_SECOND),
                             "AT+WJAP=%s,%s", mw31->wifi_ssid, mw31->wifi_password) != RT_EOK)
         {
             LOG_E("AT device(%s) network initialize failed, check ssid(%s) and password(%s).",
@@ -665,7 +719,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result != RT_EOK)
@@ -679,6 +733,7 @@ __exit:
         netdev_low_level_set_status(device->netdev, RT_TRUE);
         netdev_low_level_set_link_status(device->netdev, RT_TRUE);
 
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("mw31 device(%s) network initialize successfully.", device->name);
     }
 }
@@ -726,7 +781,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
         if (device->is_init)
         {
-            netdev_low_level_set_link_status(device->netdev, RT_TRUE);
+            at_device_link_notify(device, RT_TRUE);
 
             mw31_netdev_start_delay_work(device);
         }
@@ -737,7 +792,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
         if (device->is_init)
         {
-            netdev_low_level_set_link_status(device->netdev, RT_FALSE);
+            at_device_link_notify(device, RT_FALSE);
         }
     }
 }
@@ -770,13 +825,17 @@ static int mw31_init(struct at_device *device)
 #endif
 
     /* add mw31 device to the netdev list */
-    device->netdev = mw31_netdev_add(mw31->device_name);
+    device->netdev = mw31_netdev_add(device, mw31->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("mw31 device(%s) initialize failed, get network interface device failed.", mw31->device_name);
         return -RT_ERROR;
     }
 
+#ifdef AT_DEVICE_USING_STATIC
+    rt_delayed_work_init(&(mw31->net_work), mw31_get_netdev_info, (void *) device);
+#endif
+
     /* initialize mw31 device network */
     return mw31_netdev_set_up(device->netdev);
 }
@@ -793,7 +852,7 @@ static int mw31_reset(struct at_device *device)
     struct at_client *client = device->client;
 
     /* send "AT+RST" commonds to mw31 device */
-    result = at_obj_exec_cmd(client, RT_NULL, "AT+RST");
+    result = at_device_exec_cmd(device, RT_NULL, "AT+RST");
     rt_thread_mdelay(1000);
 
     /* waiting 10 seconds for mw31 device reset */
@@ -823,7 +882,7 @@ static int mw31_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -831,7 +890,7 @@ static int mw31_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
     }
 
     /* connect to input wifi ap */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
     {
         LOG_E("mw31 device(%s) wifi connect failed, check ssid(%s) and password(%s).",
               device->name, info->ssid, info->password);
@@ -840,7 +899,7 @@ static int mw31_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -887,16 +946,24 @@ static const struct at_device_ops mw31_device_ops =
     mw31_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class mw31_device_class;
+#endif
+
 static int mw31_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &mw31_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for mw31 device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill MW31 device class object */
 #ifdef AT_USING_SOCKET
@@ -38,7 +38,7 @@
 
 #define MW31_MODULE_SEND_MAX_SIZE   1024
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define MW31_EVENT_CONN_OK          (1L << 0)
@@ -73,14 +73,17 @@ static int mw31_socket_close(struct at_socket *socket)
     struct at_device *device = (struct at_device *) socket->device;
     char type[15] = {0}, status[15] = {0};
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
         return -RT_ENOMEM;
     }
 
-    at_obj_exec_cmd(device->client, resp, "AT+CIPSTATUS=%d", device_socket);
+    at_device_exec_cmd(device, resp, "AT+CIPSTATUS=%d", device_socket);
 
     if (at_resp_parse_line_args_by_kw(resp, "+CIPSTATU:", "+CIPSTATU:%[^,],%s", type, status) > 0)
     {
@@ -92,12 +95,12 @@ static int mw31_socket_close(struct at_socket *socket)
         goto __exit;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPSTOP=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+CIPSTOP=%d", device_socket);
 
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -124,11 +127,15 @@ static int mw31_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -142,7 +149,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp,
+            if (at_device_exec_cmd(device, resp,
                                 "AT+CIPSTART=%d,tcp_client,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
             {
                 result = -RT_ERROR;
@@ -150,7 +157,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
+            if (at_device_exec_cmd(device, resp,
                                 "AT+CIPSTART=%d,udp_unicast,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
             {
                 result = -RT_ERROR;
@@ -180,18 +187,24 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
+    }
+
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
     }
 
     return result;
 }
 
 /**
- * send data to server or client by AT commands.
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -199,29 +212,47 @@ __exit:
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int mw31_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                             enum at_socket_type type)
 {
     int result = RT_EOK;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_mw31 *mw31 = (struct at_device_mw31 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
     char send_buf[20] = {0};
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, MW31_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
     /* set current socket for send URC event */
     mw31->user_data = (void *) device_socket;
 
@@ -230,29 +261,30 @@ static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < MW31_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = MW31_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
 
-        sprintf(send_buf, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size);
+        sprintf(send_buf, "AT+CIPSEND=%d,%d", device_socket, (int) cur_pkt_size);
         /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line */
         at_client_obj_send(device->client, send_buf, strlen(send_buf));
 
         at_client_obj_send(device->client, "\r", 1);
 
         /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -263,16 +295,36 @@ __exit:
 //    at_client_obj_recv(device->client, send_buf, 4, RT_WAITING_FOREVER);
 //    send_buf[5] = 0;
 //    rt_kprintf("%s\n", send_buf);
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see mw31_socket_sendv()
+ */
+static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return mw31_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -292,18 +344,20 @@ static int mw31_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the mw31 device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_MW31);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization mw31 device failed.");
+        LOG_E("get mw31 device for domain resolve failed.");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for mw31 device(%s) response structure.", device->name);
@@ -312,7 +366,7 @@ static int mw31_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=%s", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=%s", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -343,9 +397,14 @@ static int mw31_domain_resolve(const char *name, char ip[16])
     }
 
 __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -395,6 +454,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     at_client_obj_recv(client, temp, 2, 1000);
     /* get the at deveice socket and receive buffer size by receive data */
     sscanf(temp, "%d,", &device_socket);
@@ -413,9 +474,10 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     if (device_socket < 0 || bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for mw31 device(%s) URC receive buffer(%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -444,6 +506,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
@@ -473,6 +537,7 @@ int mw31_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_MW31_SOCKETS_NUM;
     class->socket_ops = &mw31_socket_ops;
+    class->socket_sendv = mw31_socket_sendv;
 
     return RT_EOK;
 }
@@ -44,7 +44,7 @@
 
 /* =============================  rw007 network interface operations ============================= */
 
-static struct netdev *rw007_netdev_add(const char *netdev_name)
+static struct netdev *rw007_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define ETHERNET_MTU        1500
 #define HWADDR_LEN          6
@@ -52,7 +52,7 @@ static struct netdev *rw007_netdev_add(const char *netdev_name)
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         return RT_NULL;
@@ -84,14 +84,74 @@ static struct netdev *rw007_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
+        (resp) = at_device_resp_set_info(device, (resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)               \
         {                                                                  \
             result = -RT_ERROR;                                            \
             goto __exit;                                                   \
         }                                                                  \
     } while(0)                                                             \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* disable echo and set current mode to Wi-Fi station, the rw007 AT firmware not support command concatenation */
+static const struct at_device_step rw007_start_steps[] =
+{
+    {"ATE0",        RT_NULL,     5000, 0, 0},
+    {"AT+CWMODE=1", RT_NULL,     5000, 0, 0},
+};
+
+/**
+ * check whether the rw007 device is still online after a host-only reboot, the module is
+ * online when it is associated to the configured AP and works in multiple connections mode.
+ *
+ * @param device current AT device object
+ * @param resp response object used to execute the probe commands
+ *
+ * @return  RT_TRUE: the association can be reused, reset and re-join are not needed
+ *         RT_FALSE: the device must be reset and initialized again
+ */
+static rt_bool_t rw007_check_online(struct at_device *device, at_response_t resp)
+{
+#define SSID_LEN       32
+    struct at_device_rw007 *rw007 = (struct at_device_rw007 *) device->user_data;
+    char ssid[SSID_LEN + 1] = {0};
+    int mux_mode = 0;
+
+    resp = at_device_resp_set_info(device, resp, 256, 0, 5 * RT_TICK_PER_SECOND);
+
+    /* disable echo, it also check the module is alive */
+    if (at_device_exec_cmd(device, resp, "ATE0") < 0)
+    {
+        return RT_FALSE;
+    }
+
+    /* get the current associated AP */
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CWJAP:", "+CWJAP:\"%32[^\"]\"", ssid) <= 0 ||
+            rt_strcmp(ssid, rw007->wifi_ssid) != 0)
+    {
+        return RT_FALSE;
+    }
+
+    /* the multiple connections mode must be kept */
+    if (at_device_exec_cmd(device, resp, "AT+CIPMUX?") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CIPMUX:", "+CIPMUX:%d", &mux_mode) <= 0 ||
+            mux_mode != 1)
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
 static void rw007_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY    5
@@ -109,23 +169,28 @@ static void rw007_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device(%d) response structure.", device->name);
         return;
     }
 
+    /* reuse the current association if the module is still online, skip reset and re-join */
+    if (rw007_check_online(device, resp))
+    {
+        LOG_I("rw007 device(%s) is already online, skip reset.", device->name);
+        retry_num = 0;
+    }
+
     while (retry_num--)
     {
         /* reset module */
         AT_SEND_CMD(client, resp, "AT+RST");
         /* reset waiting delay */
         rt_thread_mdelay(1000);
-        /* disable echo */
-        AT_SEND_CMD(client, resp, "ATE0");
-        /* set current mode to Wi-Fi station */
-        AT_SEND_CMD(client, resp, "AT+CWMODE=1");
+        /* disable echo and set current mode to Wi-Fi station */
+        AT_EXEC_STEPS(device, resp, rw007_start_steps);
         /* get module version */
         AT_SEND_CMD(client, resp, "AT+GMR");
         /* show module version */
@@ -134,7 +199,7 @@ static void rw007_init_thread_entry(void *parameter)
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
         /* connect to WiFi AP */
-        if (at_obj_exec_cmd(client, at_resp_set_info(resp, 128, 0, 20 * RT_TICK_PER_SECOND), 
+        if (at_device_exec_cmd(device, at_device_resp_set_info(device, resp, 128, 0, 20 * RT_TICK_PER_SECOND), 
                     "AT+CWJAP=\"%s\",\"%s\"", rw007->wifi_ssid, rw007->wifi_password) != RT_EOK)
         {
             LOG_E("rw007 device(%s) network initialize failed, check ssid(%s) and password(%s).", 
@@ -159,7 +224,7 @@ static void rw007_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result != RT_EOK)
@@ -170,6 +235,7 @@ static void rw007_init_thread_entry(void *parameter)
     else
     {
         netdev_low_level_set_status(device->netdev, RT_TRUE);
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("rw007 device(%s) network initialize successfully.", device->name);
     }
 }
@@ -261,7 +327,7 @@ static int rw007_init(struct at_device *device)
 #endif
 
     /* add rw007 device to the netdev list */
-    device->netdev = rw007_netdev_add(rw007->device_name);
+    device->netdev = rw007_netdev_add(device, rw007->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("rw007 device(%s) initialize failed, get network interface device failed.", rw007->device_name);
@@ -286,7 +352,7 @@ static int rw007_reset(struct at_device *device)
     struct at_client *client = device->client;
 
     /* send "AT+RST" commonds to rw007 device */
-    result = at_obj_exec_cmd(client, RT_NULL, "AT+RST");
+    result = at_device_exec_cmd(device, RT_NULL, "AT+RST");
     rt_thread_delay(1000);
 
     /* waiting 10 seconds for rw007 device reset */
@@ -316,7 +382,7 @@ static int rw007_wifi_info_set(struct at_device *device, struct at_device_ssid_p
          return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device(%s) response structure.", device->name);
@@ -324,7 +390,7 @@ static int rw007_wifi_info_set(struct at_device *device, struct at_device_ssid_p
     }
 
     /* connect to input wifi ap */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
+    if (at_device_exec_cmd(device, resp, "AT+CWJAP=\"%s\",\"%s\"", info->ssid, info->password) != RT_EOK)
     {
         LOG_E("rw007 device(%s) wifi connect failed, check ssid(%s) and password(%s).",  
                 device->name, info->ssid, info->password);
@@ -333,7 +399,7 @@ static int rw007_wifi_info_set(struct at_device *device, struct at_device_ssid_p
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -379,16 +445,24 @@ const struct at_device_ops rw007_device_ops =
     rw007_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class rw007_device_class;
+#endif
+
 static int rw007_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &rw007_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for rw007 device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill rw007 device class object */
 #ifdef AT_USING_SOCKET
@@ -39,7 +39,7 @@
 
 #define RW007_MODULE_SEND_MAX_SIZE     2048
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define RW007_EVENT_CONN_OK            (1L << 0)
@@ -64,10 +64,10 @@ static int rw007_socket_event_recv(struct at_device *device, uint32_t event, uin
     int result = RT_EOK;
     rt_uint32_t recved;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
@@ -90,18 +90,21 @@ static int rw007_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, RT_TICK_PER_SECOND);
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
+
+    resp = at_device_resp_take(device, 64, 0, RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device(%s) response structure.", device->name);
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket);
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
@@ -128,11 +131,15 @@ static int rw007_socket_connect(struct at_socket *socket, char *ip, int32_t port
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device(%s) response structure.", device->name);
@@ -146,7 +153,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -154,7 +161,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, 
+            if (at_device_exec_cmd(device, resp, 
                     "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -184,18 +191,24 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
+    }
+
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
     }
 
     return result;
 }
 
 /**
- * send data to server or client by AT commands.
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -203,29 +216,47 @@ __exit:
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int rw007_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int rw007_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                              enum at_socket_type type)
 {
     int result = RT_EOK;
     int event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_rw007 *rw007 = (struct at_device_rw007 *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, RW007_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
     /* set current socket for send URC event */
     rw007->user_data = (void *) device_socket;
 
@@ -234,24 +265,24 @@ static int rw007_socket_send(struct at_socket *socket, const char *buff, size_t
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < RW007_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = RW007_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
 
         /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -277,11 +308,13 @@ static int rw007_socket_send(struct at_socket *socket, const char *buff, size_t
         /* check result */
         if (event_result & RW007_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("rw007 device(%s) socket (%d) send failed.", device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -289,16 +322,36 @@ __exit:
     /* reset the end sign for data */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see rw007_socket_sendv()
+ */
+static int rw007_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return rw007_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -317,18 +370,20 @@ static int rw007_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the rw007 device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_RW007);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization rw007 device failed.");
+        LOG_E("get rw007 device for domain resolve failed.");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for rw007 device response structure.", device->name);
@@ -337,7 +392,7 @@ static int rw007_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -366,9 +421,14 @@ static int rw007_domain_resolve(const char *name, char ip[16])
     }
 
 __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -413,6 +473,9 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get rw007 device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     rw007 = (struct at_device_rw007 *) device->user_data;
     device_socket = (int) rw007->user_data;
 
@@ -451,6 +514,8 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "%d,CLOSED", &device_socket);
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
@@ -481,6 +546,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     /* get the current socket and receive buffer size by receive data */
     sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
     /* get receive timeout by receive buffer length */
@@ -491,9 +558,10 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for rw007 device(%s) URC receive buffer (%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -522,6 +590,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
@@ -554,6 +624,7 @@ int rw007_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_RW007_SOCKETS_NUM;
     class->socket_ops = &rw007_socket_ops;
+    class->socket_sendv = rw007_socket_sendv;
 
     return RT_EOK;
 }
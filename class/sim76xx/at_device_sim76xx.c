@@ -46,7 +46,7 @@
 /**
  * power up sim76xx modem
  */
-static void sim76xx_power_on(struct at_device *device)
+static int sim76xx_power_on(struct at_device *device)
 {
     struct at_device_sim76xx *sim76xx = RT_NULL;
 
@@ -55,23 +55,14 @@ static void sim76xx_power_on(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (sim76xx->power_pin == -1 || sim76xx->power_status_pin == -1)
     {
-        return;
-    }
-
-    if (rt_pin_read(sim76xx->power_status_pin) == PIN_HIGH)
-    {
-        return;
+        return RT_EOK;
     }
-    rt_pin_write(sim76xx->power_pin, PIN_HIGH);
 
-    while (rt_pin_read(sim76xx->power_status_pin) == PIN_LOW)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(sim76xx->power_pin, PIN_LOW);
+    return at_device_power_switch(device, sim76xx->power_pin, sim76xx->power_status_pin,
+                                  RT_TRUE, AT_DEVICE_POWER_TIMEOUT);
 }
 
-static void sim76xx_power_off(struct at_device *device)
+static int sim76xx_power_off(struct at_device *device)
 {
     struct at_device_sim76xx *sim76xx = RT_NULL;
 
@@ -80,25 +71,16 @@ static void sim76xx_power_off(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (sim76xx->power_pin == -1 || sim76xx->power_status_pin == -1)
     {
-        return;
+        return RT_EOK;
     }
 
-    if (rt_pin_read(sim76xx->power_status_pin) == PIN_LOW)
-    {
-        return;
-    }
-    rt_pin_write(sim76xx->power_pin, PIN_HIGH);
-
-    while (rt_pin_read(sim76xx->power_status_pin) == PIN_HIGH)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(sim76xx->power_pin, PIN_LOW);
+    return at_device_power_switch(device, sim76xx->power_pin, sim76xx->power_status_pin,
+                                  RT_FALSE, AT_DEVICE_POWER_TIMEOUT);
 }
 
 /* =============================  sim76xx network interface operations ============================= */
 
-static struct netdev *sim76xx_netdev_add(const char *netdev_name)
+static struct netdev *sim76xx_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define ETHERNET_MTU 1500
 #define HWADDR_LEN 8
@@ -106,7 +88,7 @@ static struct netdev *sim76xx_netdev_add(const char *netdev_name)
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *)rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) netdev structure.", netdev_name);
@@ -138,33 +120,49 @@ static struct netdev *sim76xx_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                          \
     do {                                                                        \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND);      \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                       \
+        (resp) = at_device_resp_set_info(device, (resp), 256, 0, 5 * RT_TICK_PER_SECOND);      \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)                    \
         {                                                                       \
             result = -RT_ERROR;                                                 \
             goto __exit;                                                        \
         }                                                                       \
     } while(0)                                                                  \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* check SIM card, signal strength, wait the GSM, GPRS network is registered and packet domain attach */
+static const struct at_device_step sim76xx_net_steps[] =
+{
+    {"AT+CPIN?",     "READY",     5000, 0,  0},
+    {"AT+CSQ",       "+CSQ: 99,", 5000, 19, AT_DEVICE_STEP_EXCLUDE, 1000},
+    /* do not show the prompt when receiving data */
+    {"AT+CIPSRIP=0", RT_NULL,     5000, 0,  0},
+    /* the received data is read by link id with AT+CIPRXGET=2 instead of pushed by +IPD */
+    {"AT+CIPRXGET=1", RT_NULL,    5000, 0,  0},
+    {"AT+CREG?",     "+CREG: 0,1|+CREG: 0,5", 5000, 9, 0, 1000},
+    {"AT+CGREG?",    "+CGREG: 0,1|+CGREG: 0,5", 5000, 19, 0, 1000},
+    {"AT+CGATT?",    "+CGATT: 1", 5000, 9,  0, 1000},
+};
 
 static void sim76xx_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY                     5
-#define CSQ_RETRY                      20
-#define CREG_RETRY                     10
-#define CGREG_RETRY                    20
-#define CGATT_RETRY                    10
 #define CCLK_RETRY                     10
 
     at_response_t resp = RT_NULL;
     rt_err_t result = RT_EOK;
-    rt_size_t i, qi_arg[3] = {0};
+    rt_size_t i;
     int retry_num = INIT_RETRY;
-    char parsed_data[20] = {0};
     struct at_device *device = (struct at_device *)parameter;
-    struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
@@ -176,11 +174,15 @@ static void sim76xx_init_thread_entry(void *parameter)
     while (retry_num--)
     {
         /* power-up sim76xx */
-        sim76xx_power_on(device);
+        if (sim76xx_power_on(device) < 0)
+        {
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
         rt_thread_mdelay(1000);
 
         /* wait SIM76XX startup finish, Send AT every 5s, if receive OK, SYNC success*/
-        if (at_client_wait_connect(SIM76XX_WAIT_CONNECT_TIME))
+        if (at_client_obj_wait_connect(device->client, SIM76XX_WAIT_CONNECT_TIME))
         {
             result = -RT_ETIMEOUT;
             goto __exit;
@@ -197,106 +199,16 @@ static void sim76xx_init_thread_entry(void *parameter)
         {
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check SIM card */
-
-        AT_SEND_CMD(client, resp, "AT+CPIN?");
-        if (!at_resp_get_line_by_kw(resp, "READY"))
-        {
-            LOG_E("sim76xx device(%s) SIM card detection failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &qi_arg[0], &qi_arg[1]);
-            if (qi_arg[0] != 99)
-            {
-                LOG_D("sim76xx device(%s) signal strength: %d  Channel bit error rate: %d", device->name, qi_arg[0], qi_arg[1]);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("sim76xx device(%s) signal strength check failed (%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* do not show the prompt when receiving data */
-        AT_SEND_CMD(client, resp, "AT+CIPSRIP=0");
-
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) || !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("sim76xx device(%s) GSM network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CREG_RETRY)
-        {
-            LOG_E("sim76xx device(%s) GSM network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) || !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("sim76xx device(%s) GPRS network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("sim76xx device(%s) GPRS network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* check packet domain attach or detach */
-        for (i = 0; i < CGATT_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, "AT+CGATT?");
-            at_resp_parse_line_args_by_kw(resp, "+CGATT:", "+CGATT: %s", &parsed_data);
-            if (!strncmp(parsed_data, "1", 1))
-            {
-                LOG_I("sim76xx device(%s) Packet domain attach.", device->name);
-                break;
-            }
-
-            rt_thread_mdelay(1000);
-        }
-
-        if (i == CGATT_RETRY)
-        {
-            LOG_E("sim76xx device(%s) GPRS network attach failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
+        /* check SIM card, signal strength, wait the GSM, GPRS network is registered and packet domain attach */
+        AT_EXEC_STEPS(device, resp, sim76xx_net_steps);
 
         /* get real time */
         int year, month, day, hour, min, sec;
 
         for (i = 0; i < CCLK_RETRY; i++)
         {
-            if (at_obj_exec_cmd(device->client, at_resp_set_info(resp, 256, 0, 5 * RT_TICK_PER_SECOND), "AT+CCLK?") < 0)
+            if (at_device_exec_cmd(device, at_device_resp_set_info(device, resp, 256, 0, 5 * RT_TICK_PER_SECOND),
+                                   "AT+CCLK?") < 0)
             {
                 rt_thread_mdelay(500);
                 continue;
@@ -342,11 +254,16 @@ static void sim76xx_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result == RT_EOK)
     {
+#ifdef AT_USING_SOCKET
+        /* the data length of one send command, the class default is used if it's not probed */
+        at_device_probe_send_max(device, "AT+CIPSEND=?", "+CIPSEND:");
+#endif
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("sim76xx devuce(%s) network initialize success!", device->name);
     }
     else
@@ -378,36 +295,58 @@ int sim76xx_net_init(struct at_device *device)
     return RT_EOK;
 }
 
+/* get the sim76xx device by the device name, or the first initialized one without the name */
+static struct at_device *sim76xx_get_device(const char *name)
+{
+    struct at_device *device = RT_NULL;
+
+    if (name)
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, name);
+    }
+    else
+    {
+        device = at_device_get_first_initialized();
+    }
+
+    if (device == RT_NULL || device->class->class_id != AT_DEVICE_CLASS_SIM76XX)
+    {
+        return RT_NULL;
+    }
+
+    return device;
+}
+
 int sim76xx_ping(int argc, char **argv)
 {
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
 
-    if (argc != 2)
+    if (argc != 2 && argc != 3)
     {
-        rt_kprintf("Please input: at_ping <host address>\n");
+        rt_kprintf("Please input: at_ping <host address> [device name]\n");
         return -RT_ERROR;
     }
 
-    device = at_device_get_first_initialized();
+    device = sim76xx_get_device((argc == 3) ? argv[2] : RT_NULL);
     if (device == RT_NULL)
     {
-        rt_kprintf("get first initialized sim76xx device failed.\n");
+        rt_kprintf("get sim76xx device failed.\n");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 64, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         rt_kprintf("no memory for sim76xx device(%s) response structure.\n", device->name);
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+CPING=\"%s\",1,4,64,1000,10000,255", argv[1]) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CPING=\"%s\",1,4,64,1000,10000,255", argv[1]) < 0)
     {
         if (resp)
         {
-            at_delete_resp(resp);
+            at_device_resp_release(device, resp);
         }
         rt_kprintf("sim76xx device(%s) send ping commands error.\n", device->name);
         return -RT_ERROR;
@@ -415,27 +354,27 @@ int sim76xx_ping(int argc, char **argv)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return RT_EOK;
 }
 
-int sim76xx_ifconfig(void)
+int sim76xx_ifconfig(int argc, char **argv)
 {
     at_response_t resp = RT_NULL;
     char resp_arg[AT_CMD_MAX_LEN] = {0};
     rt_err_t result = RT_EOK;
     struct at_device *device = RT_NULL;
 
-    device = at_device_get_first_initialized();
+    device = sim76xx_get_device((argc == 2) ? argv[1] : RT_NULL);
     if (device == RT_NULL)
     {
-        rt_kprintf("get first initialized sim76xx device failed.\n");
+        rt_kprintf("get sim76xx device failed.\n");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 2, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 2, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         rt_kprintf("no memory for sim76xx device(%s) response structure.\n", device->name);
@@ -450,7 +389,7 @@ int sim76xx_ifconfig(void)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -522,7 +461,7 @@ static int sim76xx_init(struct at_device *device)
 #endif
 
     /* add sim76xx device to the netdev list */
-    device->netdev = sim76xx_netdev_add(sim76xx->device_name);
+    device->netdev = sim76xx_netdev_add(device, sim76xx->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("sim76xx device(%s) initialize failed, get network interface device failed.", sim76xx->device_name);
@@ -549,6 +488,112 @@ static int sim76xx_deinit(struct at_device *device)
     return RT_EOK;
 }
 
+/* enable the sleep mode, the module enters sleep mode when the DTR (wakeup pin) is high */
+static int sim76xx_sleep(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+    struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSCLK=1") < 0)
+    {
+        LOG_E("sim76xx device(%s) enable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    if (sim76xx->wakeup_pin > 0)
+    {
+        rt_pin_mode(sim76xx->wakeup_pin, PIN_MODE_OUTPUT);
+        rt_pin_write(sim76xx->wakeup_pin, PIN_HIGH);
+    }
+
+    return RT_EOK;
+}
+
+/* pull down the DTR (wakeup pin) to wake up the module and disable the sleep mode */
+static int sim76xx_wakeup(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+    struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
+
+    if (sim76xx->wakeup_pin > 0)
+    {
+        rt_pin_write(sim76xx->wakeup_pin, PIN_LOW);
+    }
+
+    /* the UART is available after the module wakes up */
+    if (at_client_obj_wait_connect(device->client, SIM76XX_WAIT_CONNECT_TIME))
+    {
+        LOG_E("sim76xx device(%s) wakeup timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSCLK=0") < 0)
+    {
+        LOG_E("sim76xx device(%s) disable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    return RT_EOK;
+}
+
+/* get the signal strength (dBm) by the received signal strength indication */
+static int sim76xx_get_signal(struct at_device *device, int *rssi)
+{
+    int result = RT_EOK, csq = 99, ber = 0;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(rssi);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSQ") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &csq, &ber) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* 99 not known or not detectable */
+    if (csq == 99)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    *rssi = -113 + 2 * csq;
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
 static int sim76xx_control(struct at_device *device, int cmd, void *arg)
 {
     int result = -RT_ERROR;
@@ -561,16 +606,22 @@ static int sim76xx_control(struct at_device *device, int cmd, void *arg)
     case AT_DEVICE_CTRL_POWER_OFF:
     case AT_DEVICE_CTRL_RESET:
     case AT_DEVICE_CTRL_LOW_POWER:
-    case AT_DEVICE_CTRL_SLEEP:
-    case AT_DEVICE_CTRL_WAKEUP:
     case AT_DEVICE_CTRL_NET_CONN:
     case AT_DEVICE_CTRL_NET_DISCONN:
     case AT_DEVICE_CTRL_SET_WIFI_INFO:
-    case AT_DEVICE_CTRL_GET_SIGNAL:
     case AT_DEVICE_CTRL_GET_GPS:
     case AT_DEVICE_CTRL_GET_VER:
         LOG_W("sim76xx not support the control command(%d).", cmd);
         break;
+    case AT_DEVICE_CTRL_GET_SIGNAL:
+        result = sim76xx_get_signal(device, (int *) arg);
+        break;
+    case AT_DEVICE_CTRL_SLEEP:
+        result = sim76xx_sleep(device);
+        break;
+    case AT_DEVICE_CTRL_WAKEUP:
+        result = sim76xx_wakeup(device);
+        break;
     default:
         LOG_E("input error control command(%d).", cmd);
         break;
@@ -586,16 +637,24 @@ const struct at_device_ops sim76xx_device_ops =
     sim76xx_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class sim76xx_device_class;
+#endif
+
 static int sim76xx_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &sim76xx_device_class;
+#else
     class = (struct at_device_class *)rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for sim76xx device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill sim76xx device class object */
 #ifdef AT_USING_SOCKET
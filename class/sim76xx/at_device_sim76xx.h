@@ -45,8 +45,23 @@ struct at_device_sim76xx
     int power_status_pin;
     size_t recv_line_num;
     struct at_device device;
+#ifdef AT_DEVICE_USING_STATIC
+    /* the static memory of the device, see AT_DEVICE_STATIC_BIND */
+#ifdef AT_USING_SOCKET
+    struct at_socket sockets[AT_DEVICE_SIM76XX_SOCKETS_NUM];
+    struct at_device_socket_stats socket_stats[AT_DEVICE_SIM76XX_SOCKETS_NUM];
+    rt_ubase_t recv_pool[AT_DEVICE_STATIC_RECV_SIZE / sizeof(rt_ubase_t)];
+#endif
+#endif /* AT_DEVICE_USING_STATIC */
+
+    /* the sockets whose received data is waiting in the module, read by AT+CIPRXGET */
+    rt_uint32_t recv_pending;
+    struct rt_work recv_work;
 
     void *user_data;
+
+    /* the module DTR pin to control the sleep mode, 0 or -1 if not connected */
+    int wakeup_pin;
 };
 
 #ifdef AT_USING_SOCKET
@@ -40,10 +40,10 @@
 #ifdef AT_DEVICE_USING_SIM76XX
 
 #define SIM76XX_MODULE_SEND_MAX_SIZE   1500
-#define SIM76XX_MAX_CONNECTIONS        10
+#define SIM76XX_MODULE_RECV_MAX_SIZE   1500
 
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define SIM76XX_EVENT_CONN_OK          (1L << 0)
@@ -59,9 +59,6 @@ static at_evt_cb_t at_evt_cb_set[] =
     [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static char udp_ipstr[SIM76XX_MAX_CONNECTIONS][16];
-static int udp_port[SIM76XX_MAX_CONNECTIONS];
-
 /* unsolicited TCP/IP command<err> codes */
 static void at_tcp_ip_errcode_parse(int result) 
 {
@@ -83,6 +80,31 @@ static void at_tcp_ip_errcode_parse(int result)
     }
 }
 
+/* take the pending receive flag of the link, return non-zero when it's set */
+static int sim76xx_recv_pending_take(struct at_device *device, int device_socket)
+{
+    struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
+    rt_uint32_t pending;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    pending = sim76xx->recv_pending & (1UL << device_socket);
+    sim76xx->recv_pending &= ~(1UL << device_socket);
+    rt_hw_interrupt_enable(level);
+
+    return pending ? 1 : 0;
+}
+
+static void sim76xx_recv_pending_set(struct at_device *device, int device_socket)
+{
+    struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    sim76xx->recv_pending |= (1UL << device_socket);
+    rt_hw_interrupt_enable(level);
+}
+
 static int sim76xx_socket_event_send(struct at_device *device, uint32_t event)
 {
     return (int)rt_event_send(device->socket_event, event);
@@ -93,10 +115,10 @@ static int sim76xx_socket_event_recv(struct at_device *device, uint32_t event, u
     int result = RT_EOK;
     rt_uint32_t recved;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
@@ -121,7 +143,10 @@ static int sim76xx_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, RT_TICK_PER_SECOND);
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
+
+    resp = at_device_resp_take(device, 64, 0, RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
@@ -131,7 +156,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
     rt_thread_mdelay(100);
 
     /* check socket link_state */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE?") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -148,14 +173,14 @@ static int sim76xx_socket_close(struct at_socket *socket)
     if (lnk_stat[device_socket])
     {
         /* close tcp or udp socket if connected */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
     }
     /* check the network open or not */
-    if (at_obj_exec_cmd(device->client, resp, "AT+NETOPEN?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+NETOPEN?") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -170,7 +195,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
     if (activated)
     {
         /* if already open,then close it */
-        if (at_obj_exec_cmd(device->client, resp, "AT+NETCLOSE") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+NETCLOSE") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -178,9 +203,12 @@ static int sim76xx_socket_close(struct at_socket *socket)
     }
 
  __exit:
+    /* the data of the closed link is not read anymore */
+    sim76xx_recv_pending_take(device, device_socket);
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -195,7 +223,7 @@ static int sim76xx_network_socket_open(struct at_socket *socket)
     at_response_t resp = RT_NULL;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
@@ -203,7 +231,7 @@ static int sim76xx_network_socket_open(struct at_socket *socket)
     }
 
     /* check the network open or not */
-    if (at_obj_exec_cmd(device->client, resp, "AT+NETOPEN?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+NETOPEN?") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -223,7 +251,7 @@ static int sim76xx_network_socket_open(struct at_socket *socket)
     else
     {
         /* if not opened the open it */
-        if (at_obj_exec_cmd(device->client, resp, "AT+NETOPEN") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+NETOPEN") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -233,7 +261,7 @@ static int sim76xx_network_socket_open(struct at_socket *socket)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -260,20 +288,25 @@ static int sim76xx_socket_connect(struct at_socket *socket, char *ip, int32_t po
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    rt_mutex_t lock = device->client->lock;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
 __retry:
     if (is_client)
     {
@@ -284,19 +317,17 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
             }
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPOPEN=%d,\"UDP\",,,%d", device_socket, port) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPOPEN=%d,\"UDP\",,,%d", device_socket, port) < 0)
             {
                 result = -RT_ERROR;
             }
-            strcpy(udp_ipstr[device_socket], ip);
-            udp_port[device_socket] = port;
             break;
 
         default:
@@ -305,6 +336,17 @@ __retry:
             goto __exit;
         }
     }
+    else if (type == AT_SOCKET_UDP)
+    {
+        /* open network socket first(AT+NETOPEN) */
+        sim76xx_network_socket_open(socket);
+
+        /* the UDP link receives the datagrams from any peers on the local port */
+        if (at_device_exec_cmd(device, resp, "AT+CIPOPEN=%d,\"UDP\",,,%d", device_socket, port) < 0)
+        {
+            result = -RT_ERROR;
+        }
+    }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use.*/
     if (sim76xx_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
@@ -354,22 +396,46 @@ __retry:
     }
 
 __exit:
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
+    at_device_unlock(device);
+
+    if (result == RT_EOK)
     {
-        at_delete_resp(resp);
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
+
+        /* every datagram is sent with the destination, the connected UDP socket sends to its peer */
+        if (is_client && type == AT_SOCKET_UDP)
+        {
+            at_device_udp_set_dest(device, device_socket, ip, port);
+        }
     }
 
     return result;
 }
 
 /**
- * send data to server or client by AT commands.
+ * open the unconnected UDP socket by AT commands, the datagrams are sent to and received
+ * from any peers.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param local_port local port of the socket
+ *
+ * @return   0: open success
+ *         < 0: open failed, see sim76xx_socket_connect()
+ */
+static int sim76xx_socket_udp_open(struct at_socket *socket, int local_port)
+{
+    return sim76xx_socket_connect(socket, "0.0.0.0", local_port, AT_SOCKET_UDP, RT_FALSE);
+}
+
+/**
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
+ *
+ * @param socket current socket
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -377,29 +443,62 @@ __exit:
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int sim76xx_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                                enum at_socket_type type)
 {
     int result = RT_EOK;
-    int event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    int event_result = 0, port = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
+    char ipstr[16] = {0};
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
     struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    /* the datagram is sent with the destination, it's not set before the first sendto of the unconnected socket */
+    if (socket->type == AT_SOCKET_UDP && at_device_udp_get_dest(device, device_socket, ipstr, &port) == RT_FALSE)
+    {
+        LOG_E("sim76xx device(%s) socket(%d) send failed, no destination.", device->name, device_socket);
+        return -RT_EINVAL;
+    }
+
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, SIM76XX_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    /* the data is queued and sent in one burst after the device wakes up when it's sleeping */
+    result = at_device_sleep_queue(socket, iov, iovcnt, type);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
     /* set current socket for send URC event */
     sim76xx->user_data = (void *) device_socket;
     /* set AT client end sign to deal with '>' sign.*/
@@ -407,20 +506,20 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < SIM76XX_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = SIM76XX_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
         
         switch (socket->type)
         {
         case AT_SOCKET_TCP:
             /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-            if (at_obj_exec_cmd(device->client,  resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+            if (at_device_exec_cmd(device,  resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -428,8 +527,8 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
             break;
         case AT_SOCKET_UDP:
             /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-            if (at_obj_exec_cmd(device->client,  resp, "AT+CIPSEND=%d,%d,\"%s\",%d", 
-                    device_socket, cur_pkt_size, udp_ipstr[device_socket], udp_port[device_socket]) < 0)
+            if (at_device_exec_cmd(device,  resp, "AT+CIPSEND=%d,%d,\"%s\",%d", 
+                    device_socket, cur_pkt_size, ipstr, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -438,7 +537,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
         }
         
         /* send the real data to server or client */
-        result = (int) at_client_send(buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -464,6 +563,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
         /* check result */
         if (event_result & SIM76XX_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("sim76xx device(%s) socket(%d) send failed.", device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
@@ -474,6 +574,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
             //cur_pkt_size = cur_send_bfsz;
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -481,16 +582,36 @@ __exit:
     /* reset the end sign for data */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see sim76xx_socket_sendv()
+ */
+static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return sim76xx_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -510,18 +631,20 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
     char domain_ip[16] = {0};
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the sim76xx device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_SIM76XX);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialized sim76xx device failed.");
+        LOG_E("get sim76xx device for domain resolve failed.");
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
@@ -530,7 +653,7 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             rt_thread_mdelay(200);
             /* resolve failed, maybe receive an URC CRLF */
@@ -565,9 +688,14 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
         result = -RT_ERROR;
     }
 
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -602,6 +730,8 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "+CIPSEND: %d,%d,%d", &device_socket, &rqst_size, &cnf_size);
 
     //cur_send_bfsz = cnf_size;
@@ -655,6 +785,8 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "+CIPOPEN: %d,%d", &device_socket, &result);
 
     if (result == 0)
@@ -684,6 +816,8 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     sscanf(data, "+IPCLOSE %d,%d", &device_socket, &reason);
 
     switch (reason)
@@ -709,12 +843,51 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
 }
 
+/* read the received data of the pending links one by one, the data comes by the "+CIPRXGET: 2" URC */
+static void sim76xx_recv_work(struct rt_work *work, void *work_data)
+{
+    int device_socket = 0;
+    at_response_t resp = RT_NULL;
+    struct at_device *device = (struct at_device *) work_data;
+    struct at_device_sim76xx *sim76xx = (struct at_device_sim76xx *) device->user_data;
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 64, 0, 5 * RT_TICK_PER_SECOND);
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim76xx device(%s) response structure.", device->name);
+        at_device_unlock(device);
+        return;
+    }
+
+    /* the links are read in turn, the link with more data is set pending again by the URC */
+    while (sim76xx->recv_pending)
+    {
+        if (sim76xx_recv_pending_take(device, device_socket))
+        {
+            if (at_device_exec_cmd(device, resp, "AT+CIPRXGET=2,%d,%d",
+                                   device_socket, SIM76XX_MODULE_RECV_MAX_SIZE) < 0)
+            {
+                LOG_E("sim76xx device(%s) socket(%d) read received data failed.", device->name, device_socket);
+            }
+        }
+
+        device_socket = (device_socket + 1) % AT_DEVICE_SIM76XX_SOCKETS_NUM;
+    }
+
+    at_device_resp_release(device, resp);
+
+    at_device_unlock(device);
+}
+
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    rt_size_t bfsz = 0, temp_size = 0;
+    rt_size_t bfsz = 0, temp_size = 0, rest_size = 0, head_size = 0;
     rt_int32_t timeout;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    int device_socket = 0;
+    char *recv_buf = RT_NULL, temp[8] = {0}, ipstr[16] = {0};
+    int device_socket = 0, mode = 0, port = 0;
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     struct at_device_sim76xx *sim76xx = RT_NULL;
@@ -728,27 +901,50 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get sim76xx device by client name(%s) failed.", client_name);
         return;
     }
+
+    at_device_stats_urc(device, data);
+
     sim76xx = (struct at_device_sim76xx *) device->user_data;
-    device_socket = (int) sim76xx->user_data;
 
-    /* get the current socket and receive buffer size by receive data */
-    sscanf(data, "+IPD%d:", (int *)&bfsz);
+    /* "+CIPRXGET: 1,<link>" the data is arrived, "+CIPRXGET: 2,<link>,<read_len>,<rest_len>" the data follows, */
+    /* the UDP source "<remote IP>:<remote port>" is parsed when the module appends it */
+    if (sscanf(data, "+CIPRXGET: %d,%d,%d,%d,%15[^:]:%d", &mode, &device_socket, (int *) &bfsz,
+               (int *) &rest_size, ipstr, &port) < 2 ||
+            device_socket < 0 || device_socket >= AT_DEVICE_SIM76XX_SOCKETS_NUM)
+    {
+        return;
+    }
+
+    if (mode == 1)
+    {
+        sim76xx_recv_pending_set(device, device_socket);
+        rt_work_submit(&(sim76xx->recv_work), 0);
+        return;
+    }
+
+    if (mode != 2 || bfsz == 0)
+    {
+        return;
+    }
+
     /* get receive timeout by receive buffer length */
     timeout = bfsz * 10;
 
-    if (bfsz == 0)
-        return;
+    /* the datagram of the unconnected UDP socket is received after its source header */
+    if (at_device_udp_is_unconnected(device, device_socket))
+    {
+        head_size = sizeof(struct at_device_udp_head);
+    }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_alloc(device, head_size + bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for sim76xx device(%s) URC receive buffer(%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
         {
             if (bfsz - temp_size > sizeof(temp))
-
-
             {
                 at_client_obj_recv(client, temp, sizeof(temp), timeout);
             }
@@ -762,20 +958,33 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     }
 
     /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    if (at_client_obj_recv(client, recv_buf + head_size, bfsz, timeout) != bfsz)
     {
         LOG_E("sim76xx device(%s) receive size(%d) data failed.", device->name, bfsz);
         rt_free(recv_buf);
         return;
     }
 
+    if (head_size > 0)
+    {
+        at_device_udp_head_set((struct at_device_udp_head *) recv_buf, ipstr, port, bfsz);
+    }
+
+    /* the rest data of the link is read in the next turn */
+    if (rest_size > 0)
+    {
+        sim76xx_recv_pending_set(device, device_socket);
+    }
+
     /* get AT socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, head_size + bfsz);
     }
 }
 
@@ -785,7 +994,7 @@ static struct at_urc urc_table[] =
     {"+CIPOPEN:",      "\r\n",           urc_connect_func},
     {"+CPING:",        "\r\n",           urc_ping_func},
     {"+IPCLOSE",       "\r\n",           urc_close_func},
-    {"+IPD",           "\r\n",           urc_recv_func},
+    {"+CIPRXGET:",     "\r\n",           urc_recv_func},
 };
 
 int sim76xx_connect(int argc, char **argv)
@@ -861,8 +1070,14 @@ static const struct at_socket_ops sim76xx_socket_ops =
 
 int sim76xx_socket_init(struct at_device *device)
 {
+    struct at_device_sim76xx *sim76xx = RT_NULL;
+
     RT_ASSERT(device);
 
+    sim76xx = (struct at_device_sim76xx *) device->user_data;
+    sim76xx->recv_pending = 0;
+    rt_work_init(&(sim76xx->recv_work), sim76xx_recv_work, (void *) device);
+
     /* register URC data execution function  */
     at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
@@ -875,6 +1090,8 @@ int sim76xx_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_SIM76XX_SOCKETS_NUM;
     class->socket_ops = &sim76xx_socket_ops;
+    class->socket_sendv = sim76xx_socket_sendv;
+    class->socket_udp_open = sim76xx_socket_udp_open;
 
     return RT_EOK;
 }
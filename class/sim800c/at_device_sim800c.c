@@ -47,7 +47,7 @@ static char *CSTT_CHINA_MOBILE  = "AT+CSTT=\"CMNET\"";
 static char *CSTT_CHINA_UNICOM  = "AT+CSTT=\"UNINET\"";
 static char *CSTT_CHINA_TELECOM = "AT+CSTT=\"CTNET\"";
 
-static void sim800c_power_on(struct at_device *device)
+static int sim800c_power_on(struct at_device *device)
 {
     struct at_device_sim800c *sim800c = RT_NULL;
 
@@ -56,23 +56,14 @@ static void sim800c_power_on(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (sim800c->power_pin == -1 || sim800c->power_status_pin == -1)
     {
-        return;
+        return RT_EOK;
     }
 
-    if (rt_pin_read(sim800c->power_status_pin) == PIN_HIGH)
-    {
-        return;
-    }
-    rt_pin_write(sim800c->power_pin, PIN_HIGH);
-
-    while (rt_pin_read(sim800c->power_status_pin) == PIN_LOW)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(sim800c->power_pin, PIN_LOW);
+    return at_device_power_switch(device, sim800c->power_pin, sim800c->power_status_pin,
+                                  RT_TRUE, AT_DEVICE_POWER_TIMEOUT);
 }
 
-static void sim800c_power_off(struct at_device *device)
+static int sim800c_power_off(struct at_device *device)
 {
     struct at_device_sim800c *sim800c = RT_NULL;
 
@@ -81,20 +72,11 @@ static void sim800c_power_off(struct at_device *device)
     /* not nead to set pin configuration for m26 device power on */
     if (sim800c->power_pin == -1 || sim800c->power_status_pin == -1)
     {
-        return;
-    }
-
-    if (rt_pin_read(sim800c->power_status_pin) == PIN_LOW)
-    {
-        return;
+        return RT_EOK;
     }
-    rt_pin_write(sim800c->power_pin, PIN_HIGH);
 
-    while (rt_pin_read(sim800c->power_status_pin) == PIN_HIGH)
-    {
-        rt_thread_mdelay(10);
-    }
-    rt_pin_write(sim800c->power_pin, PIN_LOW);
+    return at_device_power_switch(device, sim800c->power_pin, sim800c->power_status_pin,
+                                  RT_FALSE, AT_DEVICE_POWER_TIMEOUT);
 }
 
 /* =============================  sim76xx network interface operations ============================= */
@@ -130,7 +112,7 @@ static int sim800c_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(SIM800C_IEMI_RESP_SIZE, 0, SIM800C_INFO_RESP_TIMO);
+    resp = at_device_resp_take(device, SIM800C_IEMI_RESP_SIZE, 0, SIM800C_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("sim800c device(%s) set IP address failed, no memory for response object.", device->name);
@@ -147,7 +129,7 @@ static int sim800c_netdev_set_info(struct netdev *netdev)
         int i = 0, j = 0;
 
         /* send "AT+GSN" commond to get device IEMI */
-        if (at_obj_exec_cmd(device->client, resp, "AT+GSN") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+GSN") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -182,10 +164,10 @@ static int sim800c_netdev_set_info(struct netdev *netdev)
         #define IP_ADDR_SIZE_MAX    16
         char ipaddr[IP_ADDR_SIZE_MAX] = {0};
 
-        at_resp_set_info(resp, SIM800C_IPADDR_RESP_SIZE, 2, SIM800C_INFO_RESP_TIMO);
+        at_device_resp_set_info(device, resp, SIM800C_IPADDR_RESP_SIZE, 2, SIM800C_INFO_RESP_TIMO);
 
         /* send "AT+CIFSR" commond to get IP address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIFSR") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIFSR") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -210,10 +192,10 @@ static int sim800c_netdev_set_info(struct netdev *netdev)
         #define DNS_ADDR_SIZE_MAX   16
         char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
 
-        at_resp_set_info(resp, SIM800C_DNS_RESP_SIZE, 0, SIM800C_INFO_RESP_TIMO);
+        at_device_resp_set_info(device, resp, SIM800C_DNS_RESP_SIZE, 0, SIM800C_INFO_RESP_TIMO);
 
         /* send "AT+CDNSCFG?" commond to get DNS servers address */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSCFG?") < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSCFG?") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -240,88 +222,98 @@ static int sim800c_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
 }
 
-static void check_link_status_entry(void *parameter)
+static rt_bool_t sim800c_link_parse(at_response_t resp)
 {
 #define SIM800C_LINK_STATUS_OK   1
-#define SIM800C_LINK_RESP_SIZE   64
-#define SIM800C_LINK_RESP_TIMO   (3 * RT_TICK_PER_SECOND)
-#define SIM800C_LINK_DELAY_TIME  (30 * RT_TICK_PER_SECOND)
 
+    int result_code, link_status = -1;
+
+    at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %d,%d", &result_code, &link_status);
+
+    return (SIM800C_LINK_STATUS_OK == link_status) ? RT_TRUE : RT_FALSE;
+}
+
+/* reactivate the GPRS context after it's deactivated by the network */
+static int sim800c_link_reactivate(struct at_device *device)
+{
+#define SIM800C_REACT_RESP_SIZE  64
+
+    int result = RT_EOK;
+    char operator[20] = {0};
+    char *cstt = RT_NULL;
     at_response_t resp = RT_NULL;
-    int result_code, link_status;
-    struct at_device *device = RT_NULL;
-    struct netdev *netdev = (struct netdev *)parameter;
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
-    if (device == RT_NULL)
+    /* the "SHUT OK" response has no "OK" line, it's ended by the response line number */
+    resp = at_device_resp_take(device, SIM800C_REACT_RESP_SIZE, 2, rt_tick_from_millisecond(20 * 1000));
+    if (resp == RT_NULL)
     {
-        LOG_E("get sim800c device by netdev name(%s) failed.", netdev->name);
-        return;
+        LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
     }
 
-    resp = at_create_resp(SIM800C_LINK_RESP_SIZE, 0, SIM800C_LINK_RESP_TIMO);
-    if (resp == RT_NULL)
+    /* the IP status is "IP INITIAL" after shutting down, the APN should be set again */
+    if (at_device_exec_cmd(device, resp, "AT+CIPSHUT") < 0)
     {
-        LOG_E("sim800c device(%s) set check link status failed, no memory for response object.", device->name);
-        return;
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    while (1)
+    resp = at_device_resp_set_info(device, resp, SIM800C_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (at_device_exec_cmd(device, resp, "AT+COPS?") < 0)
     {
-        /* send "AT+CGREG?" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
-        {
-            rt_thread_mdelay(SIM800C_LINK_DELAY_TIME);
-
-            continue;
-        }
-
-        link_status = -1;
-        at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %d,%d", &result_code, &link_status);
-
-        /* check the network interface device link status  */
-        if ((SIM800C_LINK_STATUS_OK == link_status) != netdev_is_link_up(netdev))
-        {
-            netdev_low_level_set_link_status(netdev, (SIM800C_LINK_STATUS_OK == link_status));
-        }
-
-        rt_thread_mdelay(SIM800C_LINK_DELAY_TIME);
+        result = -RT_ERROR;
+        goto __exit;
     }
-}
-
-static int sim800c_netdev_check_link_status(struct netdev *netdev)
-{
-#define SIM800C_LINK_THREAD_TICK           20
-#define SIM800C_LINK_THREAD_STACK_SIZE     512
-#define SIM800C_LINK_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
+    at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%19[^\"]", operator);
 
-    rt_thread_t tid;
-    char tname[RT_NAME_MAX] = {0};
-
-    if (netdev == RT_NULL)
+    if (rt_strcmp(operator, "CHINA MOBILE") == 0)
     {
-        LOG_E("input network interface device is NULL.\n");
-        return -RT_ERROR;
+        cstt = CSTT_CHINA_MOBILE;
+    }
+    else if (rt_strcmp(operator, "CHN-UNICOM") == 0)
+    {
+        cstt = CSTT_CHINA_UNICOM;
+    }
+    else if (rt_strcmp(operator, "CHN-CT") == 0)
+    {
+        cstt = CSTT_CHINA_TELECOM;
     }
 
-    rt_snprintf(tname, RT_NAME_MAX, "%s_link", netdev->name);
+    if (cstt && at_device_exec_cmd(device, resp, cstt) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
 
-    tid = rt_thread_create(tname, check_link_status_entry, (void *) netdev, 
-            SIM800C_LINK_THREAD_STACK_SIZE, SIM800C_LINK_THREAD_PRIORITY, SIM800C_LINK_THREAD_TICK);
-    if (tid)
+    resp = at_device_resp_set_info(device, resp, SIM800C_REACT_RESP_SIZE, 0, rt_tick_from_millisecond(20 * 1000));
+    if (at_device_exec_cmd(device, resp, "AT+CIICR") < 0)
     {
-        rt_thread_startup(tid);
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    return RT_EOK;
+    /* the IP address may be changed, update the network interface device information */
+    result = sim800c_netdev_set_info(device->netdev);
+
+__exit:
+    at_device_resp_release(device, resp);
+
+    return result;
 }
 
+static const struct at_device_link_ops sim800c_link_ops =
+{
+    "AT+CGREG?",
+    sim800c_link_parse,
+    sim800c_link_reactivate,
+};
+
 static int sim800c_net_init(struct at_device *device);
 
 static int sim800c_netdev_set_up(struct netdev *netdev)
@@ -364,6 +356,7 @@ static int sim800c_netdev_set_down(struct netdev *netdev)
         device->is_init = RT_FALSE;
 
         netdev_low_level_set_status(netdev, RT_FALSE);
+        at_device_set_ready(device, RT_FALSE);
         LOG_D("the network interface device(%s) set down status.", netdev->name);
     }
 
@@ -389,7 +382,7 @@ static int sim800c_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(SIM800C_DNS_RESP_LEN, 0, SIM800C_DNS_RESP_TIMEO);
+    resp = at_device_resp_take(device, SIM800C_DNS_RESP_LEN, 0, SIM800C_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("sim800c set dns server failed, no memory for response object.");
@@ -398,7 +391,7 @@ static int sim800c_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
     }
 
     /* send "AT+CDNSCFG=<pri_dns>[,<sec_dns>]" commond to set dns servers */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CDNSCFG=\"%s\"", inet_ntoa(*dns_server)) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -409,12 +402,13 @@ static int sim800c_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
 }
 
+#ifdef NETDEV_USING_PING
 static int sim800c_ping_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
     int result = RT_EOK;
@@ -422,14 +416,14 @@ static int sim800c_ping_domain_resolve(struct at_device *device, const char *nam
     at_response_t resp = RT_NULL;
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -456,13 +450,12 @@ static int sim800c_ping_domain_resolve(struct at_device *device, const char *nam
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
 }
 
-#ifdef NETDEV_USING_PING
 static int sim800c_netdev_ping(struct netdev *netdev, const char *host, 
         size_t data_len, uint32_t timeout, struct netdev_ping_resp *ping_resp)
 {
@@ -502,7 +495,7 @@ static int sim800c_netdev_ping(struct netdev *netdev, const char *host,
         rt_memset(ip_addr, 0x00, SIM800C_PING_IP_SIZE);
     }
 
-    resp = at_create_resp(SIM800C_PING_RESP_SIZE, 0, SIM800C_PING_TIMEO);
+    resp = at_device_resp_take(device, SIM800C_PING_RESP_SIZE, 0, SIM800C_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("sim800c device(%s) set dns server failed, no memory for response object.", device->name);
@@ -522,7 +515,7 @@ static int sim800c_netdev_ping(struct netdev *netdev, const char *host,
     }
 
     /* send "AT+CIPPING=<IP addr>[,<retryNum>[,<dataLen>[,<timeout>[,<ttl>]]]]" commond to send ping request */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPPING=%s,1,%d,%d,64", 
+    if (at_device_exec_cmd(device, resp, "AT+CIPPING=%s,1,%d,%d,64", 
             host, data_len, SIM800C_PING_TIMEO / (RT_TICK_PER_SECOND / 10)) < 0)
     {
         result = -RT_ERROR;
@@ -552,7 +545,7 @@ static int sim800c_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -583,14 +576,14 @@ const struct netdev_ops sim800c_netdev_ops =
 #endif
 };
 
-static struct netdev *sim800c_netdev_add(const char *netdev_name)
+static struct netdev *sim800c_netdev_add(struct at_device *device, const char *netdev_name)
 {
 #define SIM800C_NETDEV_MTU       1500
     struct netdev *netdev = RT_NULL;
 
     RT_ASSERT(netdev_name);
 
-    netdev = (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+    netdev = at_device_netdev_alloc(device);
     if (netdev == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) netdev structure.", netdev_name);
@@ -615,22 +608,36 @@ static struct netdev *sim800c_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
-        if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
+        (resp) = at_device_resp_set_info(device, (resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_device_exec_cmd((device), (resp), (cmd)) < 0)                                       \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
             goto __exit;                                                                           \
         }                                                                                          \
     } while(0)                                                                                     \
 
+#define AT_EXEC_STEPS(device, resp, steps)                                                         \
+    do {                                                                                           \
+        if (at_device_exec_steps((device), (resp), (steps), sizeof(steps) / sizeof(steps[0])) < 0) \
+        {                                                                                          \
+            result = -RT_ERROR;                                                                    \
+            goto __exit;                                                                           \
+        }                                                                                          \
+    } while(0)                                                                                     \
+
+/* check SIM card, wait the GSM, GPRS network is registered and check signal strength */
+static const struct at_device_step sim800c_net_steps[] =
+{
+    {"AT+CPIN?",    "READY",     5000, 9,  0, 1000},
+    {"AT+CREG?",    "+CREG: 0,1|+CREG: 0,5", 300, 9, 0, 1000},
+    {"AT+CGREG?",   "+CGREG: 0,1|+CGREG: 0,5", 300, 19, 0, 1000},
+    {"AT+CSQ",      "+CSQ: 99,99", 300, 9, AT_DEVICE_STEP_EXCLUDE, 1000},
+};
+
 /* init for sim800c */
 static void sim800c_init_thread_entry(void *parameter)
 {
 #define INIT_RETRY                     5
-#define CPIN_RETRY                     10
-#define CSQ_RETRY                      10
-#define CREG_RETRY                     10
-#define CGREG_RETRY                    20
 
     int i, qimux, retry_num = INIT_RETRY;
     char parsed_data[10] = {0};
@@ -639,7 +646,7 @@ static void sim800c_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
@@ -652,7 +659,11 @@ static void sim800c_init_thread_entry(void *parameter)
     {
         rt_memset(parsed_data, 0, sizeof(parsed_data));
         rt_thread_mdelay(500);
-        sim800c_power_on(device);
+        if (sim800c_power_on(device) < 0)
+        {
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
         rt_thread_mdelay(1000);
 
         /* wait sim800c startup finish */
@@ -671,84 +682,8 @@ static void sim800c_init_thread_entry(void *parameter)
         {
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
-        /* check SIM card */
-        for (i = 0; i < CPIN_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 2, 5 * RT_TICK_PER_SECOND, "AT+CPIN?");
-
-            if (at_resp_get_line_by_kw(resp, "READY"))
-            {
-                LOG_D("sim800c device(%s) SIM card detection success.", device->name);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CPIN_RETRY)
-        {
-            LOG_E("sim800c device(%s) SIM card detection failed.", device->name);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* waiting for dirty data to be digested */
-        rt_thread_mdelay(10);
-
-        /* check the GSM network is registered */
-        for (i = 0; i < CREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CREG:", "+CREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("sim800c device(%s) GSM network is registered(%s),", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CREG_RETRY)
-        {
-            LOG_E("sim800c device(%s) GSM network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-        /* check the GPRS network is registered */
-        for (i = 0; i < CGREG_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                !strncmp(parsed_data, "0,5", sizeof(parsed_data)))
-            {
-                LOG_D("sim800c device(%s) GPRS network is registered(%s).", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CGREG_RETRY)
-        {
-            LOG_E("sim800c device(%s) GPRS network is register failed(%s).", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* check signal strength */
-        for (i = 0; i < CSQ_RETRY; i++)
-        {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CSQ");
-            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %s", &parsed_data);
-            if (strncmp(parsed_data, "99,99", sizeof(parsed_data)))
-            {
-                LOG_D("sim800c device(%s) signal strength: %s", device->name, parsed_data);
-                break;
-            }
-            rt_thread_mdelay(1000);
-        }
-        if (i == CSQ_RETRY)
-        {
-            LOG_E("sim800c device(%s) signal strength check failed (%s)", device->name, parsed_data);
-            result = -RT_ERROR;
-            goto __exit;
-        }
+        /* check SIM card, wait the GSM, GPRS network is registered and check signal strength */
+        AT_EXEC_STEPS(device, resp, sim800c_net_steps);
 
         /* the device default response timeout is 40 seconds, but it set to 15 seconds is convenient to use. */
         AT_SEND_CMD(client, resp, 2, 20 * 1000, "AT+CIPSHUT");
@@ -761,6 +696,11 @@ static void sim800c_init_thread_entry(void *parameter)
             AT_SEND_CMD(client, resp, 0, 300, "AT+CIPMUX=1");
         }
 
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+        /* the sent data is accepted when it's buffered in the module, "DATA ACCEPT:<n>,<length>" */
+        AT_SEND_CMD(client, resp, 0, 300, "AT+CIPQSEND=1");
+#endif
+
         AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
         at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
         if (rt_strcmp(parsed_data, "CHINA MOBILE") == 0)
@@ -811,15 +751,20 @@ static void sim800c_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     if (result == RT_EOK)
     {
         /* set network interface device status and address information */
         sim800c_netdev_set_info(device->netdev);
-        sim800c_netdev_check_link_status(device->netdev);
+        at_device_link_monitor(device, &sim800c_link_ops);
+#ifdef AT_USING_SOCKET
+        /* the data length of one send command, the class default is used if it's not probed */
+        at_device_probe_send_max(device, "AT+CIPSEND=?", "+CIPSEND:");
+#endif
 
+        at_device_set_ready(device, RT_TRUE);
         LOG_I("sim800c device(%s) network initialize success!", device->name);
 
     }
@@ -887,7 +832,7 @@ static int sim800c_init(struct at_device *device)
 #endif
 
     /* add sim800c device to the netdev list */
-    device->netdev = sim800c_netdev_add(sim800c->device_name);
+    device->netdev = sim800c_netdev_add(device, sim800c->device_name);
     if (device->netdev == RT_NULL)
     {
         LOG_E("sim800c device(%s) initialize failed, get network interface device failed.", sim800c->device_name);
@@ -910,6 +855,98 @@ static int sim800c_deinit(struct at_device *device)
     return sim800c_netdev_set_down(device->netdev);
 }
 
+/* enable the automatic sleep mode, the module enters sleep mode when the UART is idle */
+static int sim800c_sleep(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSCLK=2") < 0)
+    {
+        LOG_E("sim800c device(%s) enable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    return RT_EOK;
+}
+
+/* the first character on the UART wakes up the module, then disable the sleep mode */
+static int sim800c_wakeup(struct at_device *device)
+{
+    at_response_t resp = RT_NULL;
+
+    if (at_client_obj_wait_connect(device->client, SIM800C_WAIT_CONNECT_TIME))
+    {
+        LOG_E("sim800c device(%s) wakeup timeout.", device->name);
+        return -RT_ETIMEOUT;
+    }
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSCLK=0") < 0)
+    {
+        LOG_E("sim800c device(%s) disable sleep mode failed.", device->name);
+        at_device_resp_release(device, resp);
+        return -RT_ERROR;
+    }
+    at_device_resp_release(device, resp);
+
+    return RT_EOK;
+}
+
+/* get the signal strength (dBm) by the received signal strength indication */
+static int sim800c_get_signal(struct at_device *device, int *rssi)
+{
+    int result = RT_EOK, csq = 99, ber = 0;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(rssi);
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "AT+CSQ") < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CSQ:", "+CSQ: %d,%d", &csq, &ber) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* 99 not known or not detectable */
+    if (csq == 99)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    *rssi = -113 + 2 * csq;
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
 static int sim800c_control(struct at_device *device, int cmd, void *arg)
 {
     int result = -RT_ERROR;
@@ -922,16 +959,22 @@ static int sim800c_control(struct at_device *device, int cmd, void *arg)
     case AT_DEVICE_CTRL_POWER_OFF:
     case AT_DEVICE_CTRL_RESET:
     case AT_DEVICE_CTRL_LOW_POWER:
-    case AT_DEVICE_CTRL_SLEEP:
-    case AT_DEVICE_CTRL_WAKEUP:
     case AT_DEVICE_CTRL_NET_CONN:
     case AT_DEVICE_CTRL_NET_DISCONN:
     case AT_DEVICE_CTRL_SET_WIFI_INFO:
-    case AT_DEVICE_CTRL_GET_SIGNAL:
     case AT_DEVICE_CTRL_GET_GPS:
     case AT_DEVICE_CTRL_GET_VER:
         LOG_W("sim800c not support the control command(%d).", cmd);
         break;
+    case AT_DEVICE_CTRL_GET_SIGNAL:
+        result = sim800c_get_signal(device, (int *) arg);
+        break;
+    case AT_DEVICE_CTRL_SLEEP:
+        result = sim800c_sleep(device);
+        break;
+    case AT_DEVICE_CTRL_WAKEUP:
+        result = sim800c_wakeup(device);
+        break;
     default:
         LOG_E("input error control command(%d).", cmd);
         break;
@@ -947,16 +990,24 @@ const struct at_device_ops sim800c_device_ops =
     sim800c_control,
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_class sim800c_device_class;
+#endif
+
 static int sim800c_device_class_register(void)
 {
     struct at_device_class *class = RT_NULL;
 
+#ifdef AT_DEVICE_USING_STATIC
+    class = &sim800c_device_class;
+#else
     class = (struct at_device_class *) rt_calloc(1, sizeof(struct at_device_class));
     if (class == RT_NULL)
     {
         LOG_E("no memory for sim800c device class create.");
         return -RT_ENOMEM;
     }
+#endif
 
     /* fill sim800c device class object */
 #ifdef AT_USING_SOCKET
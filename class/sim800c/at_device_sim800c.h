@@ -45,6 +45,14 @@ struct at_device_sim800c
     int power_status_pin;
     size_t recv_line_num;
     struct at_device device;
+#ifdef AT_DEVICE_USING_STATIC
+    /* the static memory of the device, see AT_DEVICE_STATIC_BIND */
+#ifdef AT_USING_SOCKET
+    struct at_socket sockets[AT_DEVICE_SIM800C_SOCKETS_NUM];
+    struct at_device_socket_stats socket_stats[AT_DEVICE_SIM800C_SOCKETS_NUM];
+    rt_ubase_t recv_pool[AT_DEVICE_STATIC_RECV_SIZE / sizeof(rt_ubase_t)];
+#endif
+#endif /* AT_DEVICE_USING_STATIC */
 
     void *user_data;
 };
@@ -54,6 +62,11 @@ struct at_device_sim800c
 /* sim800c device socket initialize */
 int sim800c_socket_init(struct at_device *device);
 
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+/* the sent data size of the socket which is not acknowledged by the remote */
+int sim800c_socket_unacked(struct at_device *device, int device_socket);
+#endif
+
 /* sim800c device class socket register */
 int sim800c_socket_class_register(struct at_device_class *class);
 
@@ -38,9 +38,11 @@
 #if defined(AT_DEVICE_USING_SIM800C) && defined(AT_USING_SOCKET)
 
 #define SIM800C_MODULE_SEND_MAX_SIZE   1000
+/* the time to wait for the sent data acknowledged by the remote before closing the socket */
+#define SIM800C_ACK_WAIT_TIME          (10 * RT_TICK_PER_SECOND)
 
 /* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#define SET_EVENT(socket, event)       AT_DEVICE_SOCKET_EVENT(socket, event)
 
 /* AT socket event type */
 #define SIM800C_EVENT_CONN_OK          (1L << 0)
@@ -65,15 +67,85 @@ static int sim800c_socket_event_recv(struct at_device *device, uint32_t event, u
     int result = RT_EOK;
     rt_uint32_t recved;
 
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
+    result = at_device_socket_event_recv(device, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
     if (result != RT_EOK)
     {
-        return -RT_ETIMEOUT;
+        return result;
     }
 
     return recved;
 }
 
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+/**
+ * get the sent data size which is not acknowledged by the remote, the data is accepted by the
+ * module in the quick send mode before it's delivered.
+ *
+ * @param device the AT device object
+ * @param device_socket the device socket number
+ *
+ * @return >=0: the size of the data not acknowledged
+ *          -1: send AT commands error or response error
+ *          -5: no memory
+ */
+int sim800c_socket_unacked(struct at_device *device, int device_socket)
+{
+    int txlen = 0, acklen = 0, nacklen = 0;
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    /* "+CIPACK: <txlen>,<acklen>,<nacklen>" */
+    if (at_device_exec_cmd(device, resp, "AT+CIPACK=%d", device_socket) < 0 ||
+            at_resp_parse_line_args_by_kw(resp, "+CIPACK:", "+CIPACK: %d,%d,%d", &txlen, &acklen, &nacklen) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    result = nacklen;
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_release(device, resp);
+    }
+
+    return result;
+}
+
+/* wait for the sent data of the socket acknowledged by the remote */
+static void sim800c_socket_wait_ack(struct at_socket *socket)
+{
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
+    int nacklen = 0;
+
+    /* only the TCP data is acknowledged */
+    if (socket->type != AT_SOCKET_TCP)
+    {
+        return;
+    }
+
+    while ((nacklen = sim800c_socket_unacked(device, device_socket)) > 0)
+    {
+        if (rt_tick_get() - start_tick > SIM800C_ACK_WAIT_TIME)
+        {
+            LOG_W("sim800c device(%s) socket(%d) closed with %d bytes not acknowledged.",
+                    device->name, device_socket, nacklen);
+            break;
+        }
+        rt_thread_mdelay(500);
+    }
+}
+#endif /* AT_DEVICE_SIM800C_QUICK_SEND */
+
 /**
  * close socket by AT commands.
  *
@@ -91,19 +163,27 @@ static int sim800c_socket_close(struct at_socket *socket)
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+
+    /* send the coalesced data before closing the socket */
+    at_device_coalesce_close(socket);
     
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_take(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
         return -RT_ENOMEM;
     }
 
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+    /* the accepted data may be still in the module, don't drop it by closing the socket */
+    sim800c_socket_wait_ack(socket);
+#endif
+
     /* clear socket close event */
     event = SET_EVENT(device_socket, SIM800C_EVNET_CLOSE_OK);
     sim800c_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
     
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -119,7 +199,7 @@ static int sim800c_socket_close(struct at_socket *socket)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
     return result;
@@ -148,11 +228,15 @@ static int sim800c_socket_connect(struct at_socket *socket, char *ip, int32_t po
     int result = RT_EOK, event_result = 0;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    /* the new socket is counted on this device, select the AT device for the next new socket */
+    at_device_placement_update();
+
+    resp = at_device_resp_take(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
@@ -171,7 +255,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL, 
+            if (at_device_exec_cmd(device, RT_NULL, 
                     "AT+CIPSTART=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -180,7 +264,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL, 
+            if (at_device_exec_cmd(device, RT_NULL, 
                     "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
@@ -234,18 +318,24 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
     
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_CONNECT, start_tick);
+    }
+
     return result;
 }
 
 /**
- * send data to server or client by AT commands.
+ * send the data segments to server or client by AT commands, the segments are streamed into
+ * the send commands in order without being copied into one buffer.
  *
  * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
+ * @param iov send data segments
+ * @param iovcnt send data segments number
  * @param type connect socket type(tcp, udp)
  *
  * @return >=0: the size of send success
@@ -253,27 +343,52 @@ __exit:
  *          -2: waited socket event timeout
  *          -5: no memory
  */
-static int sim800c_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+static int sim800c_socket_sendv(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                                enum at_socket_type type)
 {
     uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
+    size_t bfsz = 0, cur_pkt_size = 0, sent_size = 0, send_max_size = 0;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    rt_mutex_t lock = device->client->lock;
 
-    RT_ASSERT(buff);
+    RT_ASSERT(iov);
+
+    bfsz = at_device_iov_len(iov, iovcnt);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    /* the TCP data is sent in chunks of the maximum send length, the UDP datagram is not split */
+    send_max_size = at_device_send_max(device, type, bfsz, SIM800C_MODULE_SEND_MAX_SIZE);
+    if (send_max_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the small writes are collected and sent by one send command when the coalescing is enabled */
+    result = at_device_coalesce_queue(socket, iov, iovcnt, type, send_max_size);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    /* the data is queued and sent in one burst after the device wakes up when it's sleeping */
+    result = at_device_sleep_queue(socket, iov, iovcnt, type);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    at_device_lock(device);
+
+    /* the response object reserved for the AT client lock holder is used */
+    resp = at_device_resp_take(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
+        at_device_unlock(device);
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
     /* clear socket connect event */
     event = SET_EVENT(device_socket, SIM800C_EVENT_SEND_OK | SIM800C_EVENT_SEND_FAIL);
     sim800c_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
@@ -283,24 +398,24 @@ static int sim800c_socket_send(struct at_socket *socket, const char *buff, size_
 
     while (sent_size < bfsz)
     {
-        if (bfsz - sent_size < SIM800C_MODULE_SEND_MAX_SIZE)
+        if (bfsz - sent_size < send_max_size)
         {
             cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            cur_pkt_size = SIM800C_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = send_max_size;
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
 
         /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
+        result = (int) at_device_iov_send(device, iov, iovcnt, sent_size, cur_pkt_size);
         if (result == 0)
         {
             result = -RT_ERROR;
@@ -326,11 +441,13 @@ static int sim800c_socket_send(struct at_socket *socket, const char *buff, size_
         /* check result */
         if (event_result & SIM800C_EVENT_SEND_FAIL)
         {
+            at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND_FAIL, 0);
             LOG_E("simm800c device(%s) socket(%d) send failed.",device->name, device_socket);
             result = -RT_ERROR;
             goto __exit;
         }
 
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_SEND, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -338,16 +455,36 @@ __exit:
     /* reset the end sign for data conflict */
     at_obj_set_end_sign(device->client, 0);
 
-    rt_mutex_release(lock);
+    at_device_resp_release(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_unlock(device);
 
     return result;
 }
 
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *         < 0: send failed, see sim800c_socket_sendv()
+ */
+static int sim800c_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    struct at_device_iovec iov;
+
+    RT_ASSERT(buff);
+
+    iov.base = buff;
+    iov.len = bfsz;
+
+    return sim800c_socket_sendv(socket, &iov, 1, type);
+}
+
 /**
  * domain resolve by AT commands.
  *
@@ -367,19 +504,21 @@ static int sim800c_domain_resolve(const char *name, char ip[16])
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
     struct at_device *device = RT_NULL;
+    rt_tick_t start_tick = rt_tick_get();
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
+    /* the domain name is resolved by the sim800c device of the default network interface device */
+    device = at_device_get_resolver(AT_DEVICE_CLASS_SIM800C);
     if (device == RT_NULL)
     {
-        LOG_E("get first initialization sim800c device failed.");
+        LOG_E("get sim800c device for domain resolve failed.");
         return -RT_ERROR;
     }
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_take(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for sim800c device(%s) response structure.", device->name);
@@ -390,7 +529,7 @@ static int sim800c_domain_resolve(const char *name, char ip[16])
     {
         int err_code = 0;
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -431,9 +570,14 @@ static int sim800c_domain_resolve(const char *name, char ip[16])
     }
 
 __exit:
+    if (result == RT_EOK)
+    {
+        at_device_stats_update(device, -1, AT_DEVICE_STATS_RESOLVE, start_tick);
+    }
+
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_release(device, resp);
     }
 
     return result;
@@ -469,6 +613,8 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     /* get the current socket by receive data */
     sscanf(data, "%d,%*s", &device_socket);
 
@@ -497,6 +643,18 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+    /* "DATA ACCEPT:<n>,<length>", the data is buffered in the module in the quick send mode */
+    if (rt_strncmp(data, "DATA ACCEPT:", rt_strlen("DATA ACCEPT:")) == 0)
+    {
+        sscanf(data, "DATA ACCEPT:%d,%*d", &device_socket);
+        sim800c_socket_event_send(device, SET_EVENT(device_socket, SIM800C_EVENT_SEND_OK));
+        return;
+    }
+#endif
+
     /* get the current socket by receive data */
     sscanf(data, "%d,%*s", &device_socket);
 
@@ -525,6 +683,8 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    at_device_stats_urc(device, data);
+
     /* get the current socket by receive data */
     sscanf(data, "%d,%*s", &device_socket);
 
@@ -576,9 +736,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    at_device_stats_urc(device, data);
+
+    recv_buf = (char *) at_device_recv_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
+        at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV_DROP, 0);
         LOG_E("no memory for sim800c device(%s) URC receive buffer (%d).", device->name, bfsz);
         /* read and clean the coming data */
         while (temp_size < bfsz)
@@ -604,9 +767,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
+    /* the received socket data proves the link is alive */
+    at_device_link_activity(device);
+
     /* get AT socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
+    at_device_stats_update(device, device_socket, AT_DEVICE_STATS_RECV, bfsz);
+
     /* notice the receive buffer and buffer size */
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
@@ -615,15 +783,41 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 }
 
 /* sim800c device URC table for the socket data */
+static void urc_pdp_deact_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get sim800c device by client name(%s) failed.", client_name);
+        return;
+    }
+
+    at_device_stats_urc(device, data);
+
+    LOG_E("sim800c device(%s) GPRS context is deactivated.", device->name);
+
+    /* the link is down, only the GPRS context is activated again */
+    at_device_link_reactivate(device);
+}
+
 static const struct at_urc urc_table[] = 
 {
     {"",            ", CONNECT OK\r\n",     urc_connect_func},
     {"",            ", CONNECT FAIL\r\n",   urc_connect_func},
     {"",            ", SEND OK\r\n",        urc_send_func},
     {"",            ", SEND FAIL\r\n",      urc_send_func},
+#ifdef AT_DEVICE_SIM800C_QUICK_SEND
+    {"DATA ACCEPT:", "\r\n",                urc_send_func},
+#endif
     {"",            ", CLOSE OK\r\n",       urc_close_func},
     {"",            ", CLOSED\r\n",         urc_close_func},
     {"+RECEIVE,",   "\r\n",                 urc_recv_func},
+    {"+PDP: DEACT", "\r\n",                 urc_pdp_deact_func},
 };
 
 static const struct at_socket_ops sim800c_socket_ops = 
@@ -651,6 +845,7 @@ int sim800c_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_SIM800C_SOCKETS_NUM;
     class->socket_ops = &sim800c_socket_ops;
+    class->socket_sendv = sim800c_socket_sendv;
 
     return RT_EOK;
 }
@@ -0,0 +1,722 @@
+#!/usr/bin/env python3
+#
+# File      : at_modem_emu.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+# Scriptable AT modem emulator for the Linux host build. It answers the AT commands of the
+# ESP8266 (CIPSTART/CIPSEND/+IPD) or EC20 (QIOPEN/QISEND/+QIURC) and carries the socket data
+# over the real host TCP/UDP sockets. The M26 and SIM800C models only answer the network
+# initialization and the GPRS context commands. It works on the standard input and output
+# (the host program starts it on a socketpair) or on a pty whose slave path is printed.
+#
+#   python3 at_modem_emu.py --model esp8266 [--baud 115200] [--delay 5] [--script rules.txt]
+#   python3 at_modem_emu.py --model ec20 --pty
+#   python3 at_modem_emu.py --model ec20 --log commands.txt
+#
+# The script file overrides the responses and injects the URCs, '#' starts a comment:
+#
+#   AT\+CSQ => \r\n+CSQ: 99,99\r\n\r\nOK\r\n     response of the matched command line
+#   AT\+QIOPEN=.* => !drop                        no response, the command is timeout
+#   @3000 \r\n+QIURC: "pdpdeact",1\r\n            inject the data at 3000 ms after startup
+#   @2500 AT\+QIACT=1 => !drop                    the rule takes effect at 2500 ms after startup
+#
+
+import argparse
+import heapq
+import itertools
+import os
+import queue
+import re
+import selectors
+import socket
+import sys
+import threading
+import time
+import tty
+
+
+def unescape(text):
+    return text.encode('latin-1').decode('unicode_escape').encode('latin-1')
+
+
+class Writer(threading.Thread):
+    """Serial output, the bytes are throttled to the baud rate (10 bits per byte)."""
+
+    def __init__(self, fd, baud):
+        super().__init__(daemon=True)
+        self.fd = fd
+        self.baud = baud
+        self.queue = queue.Queue()
+
+    def write(self, data):
+        if data:
+            self.queue.put(data)
+
+    def run(self):
+        while True:
+            data = self.queue.get()
+            if self.baud:
+                # the chunk is small enough to keep the byte timing of a real serial line
+                for pos in range(0, len(data), 64):
+                    chunk = data[pos:pos + 64]
+                    start = time.monotonic()
+                    os.write(self.fd, chunk)
+                    left = len(chunk) * 10.0 / self.baud - (time.monotonic() - start)
+                    if left > 0:
+                        time.sleep(left)
+            else:
+                view = memoryview(data)
+                while view:
+                    view = view[os.write(self.fd, view):]
+
+
+class Link:
+    """One module socket carried by a host socket."""
+
+    def __init__(self, link_id, kind, sock):
+        self.id = link_id
+        self.kind = kind
+        self.sock = sock
+        self.sent = 0
+        self.service = False    # unconnected UDP, the datagrams are sent to and received from any peers
+        self.peer = None        # the last peer of the unconnected UDP link
+
+
+class Modem:
+    """The common AT command line handling, the models implement the command responses."""
+
+    name = 'modem'
+    max_links = 5
+    recv_chunk = 1460
+
+    def __init__(self, args, writer):
+        self.args = args
+        self.writer = writer
+        self.echo = True
+        self.links = {}
+        self.data_left = 0
+        self.data_buf = b''
+        self.data_link = None
+        self.data_dest = None
+        self.input_done = 0.0
+        self.line = b''
+        self.skip_lf = False
+        self.timers = []
+        self.sequence = itertools.count()
+        self.selector = selectors.DefaultSelector()
+        self.rules = []
+        self.log = open(args.log, 'a') if args.log else None
+        if args.script:
+            self.load_script(args.script)
+
+    # ---------------- script ----------------
+
+    def load_script(self, path):
+        start = time.monotonic()
+        with open(path) as f:
+            for raw in f:
+                raw = raw.rstrip('\n')
+                if not raw.strip() or raw.lstrip().startswith('#'):
+                    continue
+                when = None
+                if raw.startswith('@'):
+                    delay, _, raw = raw[1:].partition(' ')
+                    when = start + int(delay) / 1000.0
+                    if ' => ' not in raw:
+                        self.at(when, self.writer.write, unescape(raw))
+                        continue
+                pattern, sep, response = raw.partition(' => ')
+                if not sep:
+                    sys.stderr.write('bad script line: %s\n' % raw)
+                    continue
+                rule = (re.compile(pattern.strip()), response.strip())
+                if when is None:
+                    self.rules.append(rule)
+                else:
+                    # the timed rule takes effect at the time, before the rules loaded earlier
+                    self.at(when, self.rules.insert, 0, rule)
+
+    # ---------------- timers ----------------
+
+    def at(self, when, func, *args):
+        heapq.heappush(self.timers, (when, next(self.sequence), func, args))
+
+    def later(self, ms, func, *args):
+        self.at(time.monotonic() + ms / 1000.0, func, *args)
+
+    def run_timers(self):
+        now = time.monotonic()
+        while self.timers and self.timers[0][0] <= now:
+            _, _, func, args = heapq.heappop(self.timers)
+            func(*args)
+        return (self.timers[0][0] - now) if self.timers else None
+
+    # ---------------- output ----------------
+
+    def reply(self, data):
+        """Reply the command after the module processing delay."""
+        if isinstance(data, str):
+            data = data.encode('latin-1')
+        if self.args.delay:
+            self.later(self.args.delay, self.writer.write, data)
+        else:
+            self.writer.write(data)
+
+    def info(self, *lines):
+        raise NotImplementedError
+
+    def ok(self):
+        self.reply(self.info())
+
+    # ---------------- input ----------------
+
+    def feed(self, data):
+        # the line feed of the command line ending is not a part of the following data
+        if self.skip_lf and data.startswith(b'\n'):
+            data = data[1:]
+        self.skip_lf = False
+
+        while data:
+            if self.data_left:
+                chunk = data[:self.data_left]
+                data = data[self.data_left:]
+                self.data_buf += chunk
+                self.data_left -= len(chunk)
+                if self.data_left == 0:
+                    self.data_done(self.data_link, self.data_buf)
+                    self.data_buf = b''
+                continue
+
+            pos = data.find(b'\r')
+            if pos < 0:
+                self.line += data
+                return
+            self.line += data[:pos]
+            data = data[pos + 1:]
+            if data.startswith(b'\n'):
+                data = data[1:]
+            else:
+                self.skip_lf = True
+            line, self.line = self.line.lstrip(b'\n').decode('latin-1'), b''
+            if self.echo:
+                self.writer.write((line + '\r\n').encode('latin-1'))
+            if line:
+                self.command(line)
+
+    def command(self, line):
+        if self.log:
+            self.log.write(line + '\n')
+            self.log.flush()
+
+        for pattern, response in self.rules:
+            if pattern.fullmatch(line):
+                if response != '!drop':
+                    self.reply(unescape(response))
+                return
+
+        if not line.upper().startswith('AT'):
+            self.reply('\r\nERROR\r\n')
+            return
+
+        # the concatenated commands are answered by one final result
+        parts = line[2:].split(';') if ';' in line else [line[2:]]
+        if len(parts) > 1:
+            for part in parts:
+                self.handle('AT' + part, quiet=True)
+            self.ok()
+            return
+        self.handle(line)
+
+    def handle(self, cmd, quiet=False):
+        upper = cmd.upper()
+        if upper in ('ATE0', 'ATE1', 'E0', 'E1'):
+            self.echo = upper.endswith('1')
+        elif not quiet:
+            if self.model_command(cmd) is not False:
+                return
+        if not quiet:
+            self.ok()
+
+    def model_command(self, cmd):
+        return False
+
+    # ---------------- sockets ----------------
+
+    def open_link(self, link_id, kind, host, port):
+        try:
+            if kind == 'TCP':
+                sock = socket.create_connection((host, port), timeout=5)
+            else:
+                sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+                sock.connect((host, port))
+        except OSError:
+            return False
+        sock.setblocking(False)
+        link = Link(link_id, kind, sock)
+        self.links[link_id] = link
+        self.selector.register(sock, selectors.EVENT_READ, link)
+        return True
+
+    def open_service(self, link_id, local_port):
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        try:
+            sock.bind(('0.0.0.0', local_port))
+        except OSError:
+            sock.close()
+            return False
+        sock.setblocking(False)
+        link = Link(link_id, 'UDP', sock)
+        link.service = True
+        self.links[link_id] = link
+        self.selector.register(sock, selectors.EVENT_READ, link)
+        return True
+
+    def close_link(self, link_id):
+        link = self.links.pop(link_id, None)
+        if link:
+            self.selector.unregister(link.sock)
+            link.sock.close()
+        return link is not None
+
+    def start_data(self, link, size, dest=None):
+        self.data_link = link
+        self.data_left = size
+        self.data_buf = b''
+        self.data_dest = dest
+
+    def data_done(self, link, data):
+        try:
+            if link.service:
+                dest = self.data_dest or link.peer
+                if dest is None:
+                    return False
+                link.sock.sendto(data, dest)
+            else:
+                link.sock.sendall(data)
+            link.sent += len(data)
+            return True
+        except (OSError, AttributeError):
+            return False
+
+    def link_readable(self, link):
+        peer = None
+        try:
+            if link.service:
+                data, peer = link.sock.recvfrom(65536)
+                link.peer = peer
+            else:
+                data = link.sock.recv(65536)
+        except BlockingIOError:
+            return
+        except OSError:
+            data = b''
+        if not data and not link.service:
+            self.close_link(link.id)
+            self.writer.write(self.closed_urc(link.id))
+            return
+        for pos in range(0, len(data), self.recv_chunk):
+            self.writer.write(self.recv_urc(link, data[pos:pos + self.recv_chunk], peer))
+
+    def resolve(self, name):
+        try:
+            return socket.gethostbyname(name)
+        except OSError:
+            return None
+
+    # ---------------- main loop ----------------
+
+    def throttle_input(self, size):
+        """The serial input takes the line time of the baud rate as the output does."""
+        if not self.args.baud:
+            return
+        now = time.monotonic()
+        self.input_done = max(self.input_done, now) + size * 10.0 / self.args.baud
+        if self.input_done > now:
+            time.sleep(self.input_done - now)
+
+    def serve(self, fd):
+        self.selector.register(fd, selectors.EVENT_READ, None)
+        while True:
+            timeout = self.run_timers()
+            for key, _ in self.selector.select(timeout):
+                if key.data is None:
+                    try:
+                        data = os.read(fd, 256 if self.args.baud else 4096)
+                    except OSError:
+                        data = b''
+                    if not data:
+                        return
+                    self.throttle_input(len(data))
+                    self.feed(data)
+                else:
+                    self.link_readable(key.data)
+
+
+class Esp8266(Modem):
+    name = 'esp8266'
+    max_links = 5
+    recv_chunk = 1460
+
+    def __init__(self, args, writer):
+        super().__init__(args, writer)
+        self.joined = False
+        self.mux = 0
+        self.dinfo = 0
+
+    def info(self, *lines):
+        return ''.join(line + '\r\n' for line in lines) + '\r\nOK\r\n'
+
+    def error(self, text=None):
+        self.reply((text + '\r\n' if text else '') + '\r\nERROR\r\n')
+
+    def closed_urc(self, link_id):
+        return ('%d,CLOSED\r\n' % link_id).encode()
+
+    def recv_urc(self, link, data, peer=None):
+        if self.dinfo:
+            host, port = peer or link.sock.getpeername()[:2]
+            return ('\r\n+IPD,%d,%d,%s,%d:' % (link.id, len(data), host, port)).encode() + data
+        return ('\r\n+IPD,%d,%d:' % (link.id, len(data))).encode() + data
+
+    def model_command(self, cmd):
+        m = re.fullmatch(r'AT\+CIPSTART=(\d),"(TCP|UDP)","([^"]+)",(\d+)(?:,(\d+))?(?:,(\d))?', cmd)
+        if m:
+            link_id = int(m.group(1))
+            if link_id in self.links:
+                self.error('ALREADY CONNECTED')
+                return True
+            # the UDP link in mode 2 receives from any peers on the local port
+            if m.group(2) == 'UDP' and m.group(6) == '2':
+                opened = self.open_service(link_id, int(m.group(5)))
+            else:
+                opened = self.open_link(link_id, m.group(2), m.group(3), int(m.group(4)))
+            if opened:
+                self.reply('%d,CONNECT\r\n\r\nOK\r\n' % link_id)
+            else:
+                self.error()
+            return True
+
+        m = re.fullmatch(r'AT\+CIPSEND=(\d),(\d+)(?:,"([^"]+)",(\d+))?', cmd)
+        if m:
+            link = self.links.get(int(m.group(1)))
+            if link is None:
+                self.error('link is not valid')
+            else:
+                self.reply('\r\nOK\r\n> ')
+                self.start_data(link, int(m.group(2)), (m.group(3), int(m.group(4))) if m.group(3) else None)
+            return True
+
+        m = re.fullmatch(r'AT\+CIPDINFO=(\d)', cmd)
+        if m:
+            self.dinfo = int(m.group(1))
+            self.ok()
+            return True
+
+        m = re.fullmatch(r'AT\+CIPCLOSE=(\d)', cmd)
+        if m:
+            link_id = int(m.group(1))
+            if link_id == 5:
+                for link_id in list(self.links):
+                    self.close_link(link_id)
+                self.ok()
+            elif self.close_link(link_id):
+                self.reply('%d,CLOSED\r\n\r\nOK\r\n' % link_id)
+            else:
+                self.error('UNLINK')
+            return True
+
+        m = re.fullmatch(r'AT\+CIPDOMAIN="([^"]+)"', cmd)
+        if m:
+            ip = self.resolve(m.group(1))
+            if ip:
+                self.reply(self.info('+CIPDOMAIN:%s' % ip))
+            else:
+                self.error('DNS Fail')
+            return True
+
+        m = re.fullmatch(r'AT\+CWJAP(_CUR|_DEF)?="([^"]*)",.*', cmd)
+        if m:
+            self.joined = True
+            self.reply('WIFI CONNECTED\r\nWIFI GOT IP\r\n\r\nOK\r\n')
+            return True
+
+        m = re.fullmatch(r'AT\+CIPMUX=(\d)', cmd)
+        if m:
+            self.mux = int(m.group(1))
+            self.ok()
+            return True
+
+        if cmd == 'AT+RST':
+            for link_id in list(self.links):
+                self.close_link(link_id)
+            self.joined = False
+            self.mux = 0
+            self.dinfo = 0
+            self.ok()
+            self.later(200, self.reset_done)
+            return True
+
+        if cmd == 'AT+CWJAP?':
+            if self.joined:
+                self.reply(self.info('+CWJAP:"host-ssid","5c:cf:7f:00:00:02",6,-45'))
+            else:
+                self.reply(self.info('No AP'))
+            return True
+
+        if cmd == 'AT+CIPSTATUS':
+            lines = ['STATUS:%d' % ((3 if self.links else 2) if self.joined else 5)]
+            for link in self.links.values():
+                host, port = link.sock.getpeername()[:2]
+                lines.append('+CIPSTATUS:%d,"%s","%s",%d,%d,0' % (link.id, link.kind, host, port,
+                                                                   link.sock.getsockname()[1]))
+            self.reply(self.info(*lines))
+            return True
+
+        responses = {
+            'AT+CIPMUX?': ['+CIPMUX:%d' % self.mux],
+            'AT+CIFSR': ['+CIFSR:STAIP,"192.168.1.100"', '+CIFSR:STAMAC,"5c:cf:7f:00:00:01"'],
+            'AT+CIPSTA?': ['+CIPSTA:ip:"192.168.1.100"', '+CIPSTA:gateway:"192.168.1.1"',
+                           '+CIPSTA:netmask:"255.255.255.0"'],
+            'AT+CIPDNS_CUR?': ['+CIPDNS_CUR:208.67.222.222'],
+            'AT+CWDHCP_CUR?': ['+CWDHCP_CUR:3'],
+            'AT+GMR': ['AT version:1.6.2.0(Apr 13 2018 11:10:59)', 'SDK version:2.2.1(6ab97e9)',
+                       'compile time:Jun  7 2018 19:34:26'],
+        }
+        if cmd in responses:
+            self.reply(self.info(*responses[cmd]))
+            return True
+        if cmd.startswith('AT+PING='):
+            self.reply(self.info('+20'))
+            return True
+
+        return False
+
+    def reset_done(self):
+        self.echo = True
+        self.writer.write(b'\r\nready\r\n')
+
+    def data_done(self, link, data):
+        if link.id in self.links and super().data_done(link, data):
+            self.reply('\r\nRecv %d bytes\r\n\r\nSEND OK\r\n' % len(data))
+        else:
+            self.reply('\r\nRecv %d bytes\r\n\r\nSEND FAIL\r\n' % len(data))
+
+
+class Ec20(Modem):
+    name = 'ec20'
+    max_links = 12
+    recv_chunk = 1500
+
+    def __init__(self, args, writer):
+        super().__init__(args, writer)
+        self.activated = False
+
+    def info(self, *lines):
+        return ''.join('\r\n' + line + '\r\n' for line in lines) + '\r\nOK\r\n'
+
+    def error(self):
+        self.reply('\r\nERROR\r\n')
+
+    def closed_urc(self, link_id):
+        return ('\r\n+QIURC: "closed",%d\r\n' % link_id).encode()
+
+    def recv_urc(self, link, data, peer=None):
+        if link.service:
+            return ('\r\n+QIURC: "recv",%d,%d,"%s",%d\r\n' % (link.id, len(data), peer[0], peer[1])).encode() + data
+        return ('\r\n+QIURC: "recv",%d,%d\r\n' % (link.id, len(data))).encode() + data
+
+    def model_command(self, cmd):
+        m = re.fullmatch(r'AT\+QIOPEN=1,(\d+),"(TCP|UDP|UDP SERVICE)","([^"]+)",(\d+),(\d+),\d+', cmd)
+        if m:
+            link_id = int(m.group(1))
+            if link_id in self.links:
+                self.error()
+                return True
+            self.ok()
+            if m.group(2) == 'UDP SERVICE':
+                opened = self.open_service(link_id, int(m.group(5)))
+            else:
+                opened = self.open_link(link_id, m.group(2), m.group(3), int(m.group(4)))
+            self.reply('\r\n+QIOPEN: %d,%d\r\n' % (link_id, 0 if opened else 566))
+            return True
+
+        if cmd == 'AT+QISEND=?':
+            self.reply(self.info('+QISEND: (0-11),(0-1460)'))
+            return True
+
+        m = re.fullmatch(r'AT\+QISEND=(\d+),(\d+)(?:,"([^"]+)",(\d+))?', cmd)
+        if m:
+            link = self.links.get(int(m.group(1)))
+            size = int(m.group(2))
+            if link is None:
+                self.error()
+            elif size == 0:
+                self.reply(self.info('+QISEND: %d,%d,0' % (link.sent, link.sent)))
+            else:
+                self.reply('\r\n> ')
+                self.start_data(link, size, (m.group(3), int(m.group(4))) if m.group(3) else None)
+            return True
+
+        m = re.fullmatch(r'AT\+QICLOSE=(\d+)(,\d+)?', cmd)
+        if m:
+            self.close_link(int(m.group(1)))
+            self.ok()
+            return True
+
+        m = re.fullmatch(r'AT\+QIDNSGIP=1,"([^"]+)"', cmd)
+        if m:
+            ip = self.resolve(m.group(1))
+            self.ok()
+            if ip:
+                self.reply('\r\n+QIURC: "dnsgip",0,1,600\r\n\r\n+QIURC: "dnsgip","%s"\r\n' % ip)
+            else:
+                self.reply('\r\n+QIURC: "dnsgip",565\r\n')
+            return True
+
+        if cmd == 'AT+QIACT=1':
+            self.activated = True
+        elif cmd == 'AT+QIDEACT=1':
+            self.activated = False
+            for link_id in list(self.links):
+                self.close_link(link_id)
+        elif cmd == 'AT+QIACT?':
+            self.reply(self.info('+QIACT: 1,1,1,"10.0.0.2"') if self.activated else self.info())
+            return True
+
+        responses = {
+            'AT+IPR?': ['+IPR: 115200'],
+            'ATI': ['Quectel', 'EC20F', 'Revision: EC20CEFAR06A03M4G'],
+            'AT+CPIN?': ['+CPIN: READY'],
+            'AT+CIMI': ['460001234567890'],
+            'AT+QCCID': ['+QCCID: 89860012345678901234'],
+            'AT+CSQ': ['+CSQ: 24,99'],
+            'AT+CREG?': ['+CREG: 0,1'],
+            'AT+CGREG?': ['+CGREG: 0,1'],
+            'AT+CEREG?': ['+CEREG: 0,1'],
+            'AT+COPS?': ['+COPS: 0,0,"CHINA MOBILE",7'],
+            'AT+CCLK?': ['+CCLK: "26/10/18,12:00:00+32"'],
+            'AT+GSN': ['866123456789012'],
+            'AT+QIDNSCFG=1': ['+QIDNSCFG: 1,"114.114.114.114","8.8.8.8"'],
+        }
+        if cmd in responses:
+            self.reply(self.info(*responses[cmd]))
+            return True
+
+        return False
+
+    def data_done(self, link, data):
+        if link.id in self.links and super().data_done(link, data):
+            self.reply('\r\nSEND OK\r\n')
+        else:
+            self.reply('\r\nSEND FAIL\r\n')
+
+
+class M26(Modem):
+    """The network initialization and the GPRS context commands, the sockets are not emulated."""
+
+    name = 'm26'
+    max_links = 6
+
+    def info(self, *lines):
+        return ''.join('\r\n' + line + '\r\n' for line in lines) + '\r\nOK\r\n'
+
+    def model_command(self, cmd):
+        if cmd == 'AT+QIDEACT':
+            self.reply('\r\nDEACT OK\r\n')
+            return True
+        if cmd == 'AT+QILOCIP':
+            self.reply('\r\n10.0.0.3\r\n')
+            return True
+
+        responses = {
+            'ATI': ['Quectel_Ltd', 'Quectel_M26', 'Revision: M26FBR03A01'],
+            'AT+CPIN?': ['+CPIN: READY'],
+            'AT+CSQ': ['+CSQ: 24,0'],
+            'AT+CREG?': ['+CREG: 0,1'],
+            'AT+CGREG?': ['+CGREG: 0,1'],
+            'AT+QIMODE?': ['+QIMODE: 0'],
+            'AT+QIMUX?': ['+QIMUX: 1'],
+            'AT+QNSTATUS': ['+QNSTATUS: 0'],
+            'AT+GSN': ['866123456789013'],
+            'AT+QIDNSCFG?': ['PrimaryDns:114.114.114.114', 'SecondaryDns:8.8.8.8'],
+        }
+        if cmd in responses:
+            self.reply(self.info(*responses[cmd]))
+            return True
+
+        return False
+
+
+class Sim800c(Modem):
+    """The network initialization and the GPRS context commands, the sockets are not emulated."""
+
+    name = 'sim800c'
+    max_links = 6
+
+    def info(self, *lines):
+        return ''.join('\r\n' + line + '\r\n' for line in lines) + '\r\nOK\r\n'
+
+    def model_command(self, cmd):
+        if cmd == 'AT+CIPSHUT':
+            self.reply('\r\nSHUT OK\r\n')
+            return True
+        if cmd == 'AT+CIFSR':
+            self.reply('\r\n10.0.0.4\r\n')
+            return True
+
+        responses = {
+            'ATI': ['SIM800 R14.18'],
+            'AT+CPIN?': ['+CPIN: READY'],
+            'AT+CSQ': ['+CSQ: 24,0'],
+            'AT+CREG?': ['+CREG: 0,1'],
+            'AT+CGREG?': ['+CGREG: 0,1'],
+            'AT+CIPMUX?': ['+CIPMUX: 1'],
+            'AT+COPS?': ['+COPS: 0,0,"CHINA MOBILE"'],
+            'AT+GSN': ['866123456789014'],
+            'AT+CDNSCFG?': ['PrimaryDns: 114.114.114.114', 'SecondaryDns: 8.8.8.8'],
+            'AT+CIPSEND=?': ['+CIPSEND: (0-5),(1-1460)'],
+        }
+        if cmd in responses:
+            self.reply(self.info(*responses[cmd]))
+            return True
+
+        return False
+
+
+MODELS = {cls.name: cls for cls in (Esp8266, Ec20, M26, Sim800c)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AT modem emulator for the at_device host build')
+    parser.add_argument('--model', choices=sorted(MODELS), default='esp8266')
+    parser.add_argument('--pty', action='store_true', help='serve on a pty, the slave path is printed')
+    parser.add_argument('--baud', type=int, default=0, help='serial rate in baud, 0 is unlimited')
+    parser.add_argument('--delay', type=int, default=0, help='command response delay in milliseconds')
+    parser.add_argument('--script', help='response override and URC injection script')
+    parser.add_argument('--log', help='append the received command lines to the file')
+    args = parser.parse_args()
+
+    if args.pty:
+        master, slave = os.openpty()
+        tty.setraw(slave)
+        print(os.ttyname(slave), flush=True)
+        in_fd = out_fd = master
+    else:
+        in_fd, out_fd = sys.stdin.fileno(), sys.stdout.fileno()
+
+    writer = Writer(out_fd, args.baud)
+    writer.start()
+
+    try:
+        MODELS[args.model](args, writer).serve(in_fd)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
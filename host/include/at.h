@@ -0,0 +1,182 @@
+/*
+ * File      : at.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The AT client API (AT component 1.3.0) for the Linux host build, the AT client works on a
+ * host file descriptor bound by rt_host_serial_bind().
+ */
+
+#ifndef __AT_H__
+#define __AT_H__
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AT_SW_VERSION                  "1.3.0"
+#define AT_SW_VERSION_NUM              0x10300
+
+#ifndef AT_CMD_MAX_LEN
+#define AT_CMD_MAX_LEN                 128
+#endif
+
+#define AT_CMD_END_MARK                "\r\n"
+
+enum at_status
+{
+    AT_STATUS_UNINITIALIZED = 0,
+    AT_STATUS_INITIALIZED,
+    AT_STATUS_CLI,
+};
+typedef enum at_status at_status_t;
+
+enum at_resp_status
+{
+     AT_RESP_OK = 0,                   /* AT response end is OK */
+     AT_RESP_ERROR = -1,               /* AT response end is ERROR */
+     AT_RESP_TIMEOUT = -2,             /* AT response is timeout */
+     AT_RESP_BUFF_FULL= -3,            /* AT response buffer is full */
+};
+typedef enum at_resp_status at_resp_status_t;
+
+struct at_response
+{
+    /* response buffer */
+    char *buf;
+    /* the maximum response buffer size */
+    rt_size_t buf_size;
+    /* the length of current response buffer */
+    rt_size_t buf_len;
+    /* the number of setting response lines
+     * == 0: the response data will auto return when received 'OK' or 'ERROR'
+     * != 0: the response data will return when received setting lines number data */
+    rt_size_t line_num;
+    /* the count of received response lines */
+    rt_size_t line_counts;
+    /* the maximum response time */
+    rt_int32_t timeout;
+};
+typedef struct at_response *at_response_t;
+
+struct at_client;
+
+/* URC(Unsolicited Result Code) object, such as: 'RING', 'READY' request by AT server */
+struct at_urc
+{
+    const char *cmd_prefix;
+    const char *cmd_suffix;
+    void (*func)(struct at_client *client, const char *data, rt_size_t size);
+};
+typedef struct at_urc *at_urc_t;
+
+struct at_urc_table
+{
+    rt_size_t urc_size;
+    const struct at_urc *urc;
+};
+
+struct at_client
+{
+    rt_device_t device;
+
+    at_status_t status;
+    char end_sign;
+
+    /* the current received one line data buffer */
+    char *recv_line_buf;
+    /* The length of the currently received one line data */
+    rt_size_t recv_line_len;
+    /* The maximum supported receive data length */
+    rt_size_t recv_bufsz;
+    rt_mutex_t lock;
+
+    at_response_t resp;
+    rt_sem_t resp_notice;
+    at_resp_status_t resp_status;
+
+    struct at_urc_table *urc_table;
+    rt_size_t urc_table_size;
+
+    rt_thread_t parser;
+};
+typedef struct at_client *at_client_t;
+
+/* AT client initialize and start */
+int at_client_init(const char *dev_name,  rt_size_t recv_bufsz);
+
+/* ========================== multiple AT client function ============================ */
+
+/* get AT client object */
+at_client_t at_client_get(const char *dev_name);
+at_client_t at_client_get_first(void);
+
+/* AT client wait for connection to external devices. */
+int at_client_obj_wait_connect(at_client_t client, rt_uint32_t timeout);
+
+/* AT client send or receive data */
+rt_size_t at_client_obj_send(at_client_t client, const char *buf, rt_size_t size);
+rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_int32_t timeout);
+
+/* set AT client a line end sign */
+void at_obj_set_end_sign(at_client_t client, char ch);
+
+/* Set URC(Unsolicited Result Code) table */
+int at_obj_set_urc_table(at_client_t client, const struct at_urc * table, rt_size_t size);
+
+/* AT client send commands to AT server and waiter response */
+int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr, ...);
+
+/* AT response object create and delete */
+at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
+void at_delete_resp(at_response_t resp);
+at_response_t at_resp_set_info(at_response_t resp, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
+
+/* AT response line buffer get and parse response buffer arguments */
+const char *at_resp_get_line(at_response_t resp, rt_size_t resp_line);
+const char *at_resp_get_line_by_kw(at_response_t resp, const char *keyword);
+int at_resp_parse_line_args(at_response_t resp, rt_size_t resp_line, const char *resp_expr, ...);
+int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const char *resp_expr, ...);
+
+/* ========================== single AT client function ============================ */
+
+#define at_exec_cmd(resp, ...)                   at_obj_exec_cmd(at_client_get_first(), resp, __VA_ARGS__)
+#define at_client_wait_connect(timeout)          at_client_obj_wait_connect(at_client_get_first(), timeout)
+#define at_client_send(buf, size)                at_client_obj_send(at_client_get_first(), buf, size)
+#define at_client_recv(buf, size, timeout)       at_client_obj_recv(at_client_get_first(), buf, size, timeout)
+#define at_set_end_sign(ch)                      at_obj_set_end_sign(at_client_get_first(), ch)
+#define at_set_urc_table(urc_table, table_sz)    at_obj_set_urc_table(at_client_get_first(), urc_table, table_sz)
+
+/* ========================== host serial binding ============================ */
+
+/* Bind the AT client device name to a host file descriptor, e.g. a pty or a socketpair */
+int rt_host_serial_bind(const char *dev_name, int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_H__ */
@@ -0,0 +1,40 @@
+/*
+ * File      : at_log.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#ifndef __AT_LOG_H__
+#define __AT_LOG_H__
+
+#ifdef LOG_TAG
+#define DBG_TAG                        LOG_TAG
+#endif
+
+#ifdef AT_DEBUG
+#define DBG_LVL                        DBG_LOG
+#else
+#define DBG_LVL                        DBG_INFO
+#endif
+
+#include <rtdbg.h>
+
+#endif /* __AT_LOG_H__ */
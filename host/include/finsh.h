@@ -0,0 +1,48 @@
+/*
+ * File      : finsh.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The msh command export for the Linux host build, the commands are executed from the
+ * standard input or the "-c" option of the host program.
+ */
+
+#ifndef __FINSH_H__
+#define __FINSH_H__
+
+#include <rtthread.h>
+
+typedef int (*msh_cmd_t)(int argc, char **argv);
+
+void rt_host_msh_register(const char *name, msh_cmd_t cmd, const char *desc);
+int msh_exec(char *cmd, rt_size_t length);
+
+#define MSH_CMD_EXPORT_ALIAS(command, alias, desc)                            \
+    static void __attribute__((constructor)) __msh_cmd_##alias(void)          \
+    {                                                                         \
+        rt_host_msh_register(#alias, (msh_cmd_t) command, #desc);             \
+    }
+
+#define MSH_CMD_EXPORT(command, desc)   MSH_CMD_EXPORT_ALIAS(command, command, desc)
+
+#endif /* __FINSH_H__ */
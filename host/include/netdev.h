@@ -0,0 +1,192 @@
+/*
+ * File      : netdev.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The network interface device API for the Linux host build.
+ */
+
+#ifndef __NETDEV_H__
+#define __NETDEV_H__
+
+#include <rtthread.h>
+#include <arpa/inet.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the maximum of all used hardware address lengths */
+#ifndef NETDEV_HWADDR_MAX_LEN
+#define NETDEV_HWADDR_MAX_LEN          8U
+#endif
+
+/* the maximum of dns server number supported */
+#ifndef NETDEV_DNS_SERVERS_NUM
+#define NETDEV_DNS_SERVERS_NUM         2U
+#endif
+
+/* whether the network interface device is 'up' */
+#define NETDEV_FLAG_UP                 0x01U
+/* if set, the netif has broadcast capability */
+#define NETDEV_FLAG_BROADCAST          0x02U
+/* if set, the interface has an active link */
+#define NETDEV_FLAG_LINK_UP            0x04U
+/* if set, the interface is configured using DHCP */
+#define NETDEV_FLAG_DHCP               0x08U
+/* if set, the interface has IGMP capability */
+#define NETDEV_FLAG_IGMP               0x10U
+/* if set, the interface has an active internet connection */
+#define NETDEV_FLAG_INTERNET_UP        0x80U
+
+typedef struct
+{
+    uint32_t addr;
+} ip_addr_t;
+
+#define ip_addr_cmp(addr1, addr2)      ((addr1)->addr == (addr2)->addr)
+
+enum netdev_cb_type
+{
+    NETDEV_CB_ADDR_IP,
+    NETDEV_CB_ADDR_NETMASK,
+    NETDEV_CB_ADDR_GATEWAY,
+    NETDEV_CB_ADDR_DNS_SERVER,
+    NETDEV_CB_STATUS_UP,
+    NETDEV_CB_STATUS_DOWN,
+    NETDEV_CB_STATUS_LINK_UP,
+    NETDEV_CB_STATUS_LINK_DOWN,
+    NETDEV_CB_STATUS_INTERNET_UP,
+    NETDEV_CB_STATUS_INTERNET_DOWN,
+    NETDEV_CB_STATUS_DHCP_ENABLE,
+    NETDEV_CB_STATUS_DHCP_DISABLE,
+};
+
+struct netdev;
+
+/* function prototype for network interface device status or address change callback functions */
+typedef void (*netdev_callback_fn )(struct netdev *netdev, enum netdev_cb_type type);
+
+struct netdev_ops;
+
+/* network interface device object */
+struct netdev
+{
+    rt_slist_t list;
+
+    char name[RT_NAME_MAX];                            /* network interface device name */
+    ip_addr_t ip_addr;                                 /* IP address */
+    ip_addr_t netmask;                                 /* subnet mask */
+    ip_addr_t gw;                                      /* gateway */
+    ip_addr_t dns_servers[NETDEV_DNS_SERVERS_NUM];     /* DNS server */
+    uint8_t hwaddr_len;                                /* hardware address length */
+    uint8_t hwaddr[NETDEV_HWADDR_MAX_LEN];             /* hardware address */
+
+    uint16_t flags;                                    /* network interface device status flag */
+    uint16_t mtu;                                      /* maximum transfer unit (in bytes) */
+    const struct netdev_ops *ops;                      /* network interface device operations */
+
+    netdev_callback_fn status_callback;                /* network interface device flags change callback */
+    netdev_callback_fn addr_callback;                  /* network interface device address information change callback */
+
+    void *sal_user_data;                               /* user-specific data for SAL */
+    void *user_data;                                   /* user-specific data */
+};
+
+/* The list of network interface device */
+extern struct netdev *netdev_list;
+/* The default network interface device */
+extern struct netdev *netdev_default;
+
+/* The network interface device ping response object */
+struct netdev_ping_resp
+{
+    ip_addr_t ip_addr;                           /* response IP address */
+    uint16_t data_len;                           /* response data length */
+    uint16_t ttl;                                /* time to live */
+    uint32_t ticks;                              /* response time, unit tick */
+    void *user_data;                             /* user-specific data */
+};
+
+/* The network interface device operations */
+struct netdev_ops
+{
+    /* set network interface device hardware status operations */
+    int (*set_up)(struct netdev *netdev);
+    int (*set_down)(struct netdev *netdev);
+
+    /* set network interface device address information operations */
+    int (*set_addr_info)(struct netdev *netdev, ip_addr_t *ip_addr, ip_addr_t *netmask, ip_addr_t *gw);
+    int (*set_dns_server)(struct netdev *netdev, uint8_t dns_num, ip_addr_t *dns_server);
+    int (*set_dhcp)(struct netdev *netdev, rt_bool_t is_enabled);
+
+    /* set network interface device common network interface device operations */
+    int (*ping)(struct netdev *netdev, const char *host, size_t data_len, uint32_t timeout, struct netdev_ping_resp *ping_resp);
+    void (*netstat)(struct netdev *netdev);
+};
+
+/* The network interface device registered and unregistered*/
+int netdev_register(struct netdev *netdev, const char *name, void *user_data);
+int netdev_unregister(struct netdev *netdev);
+
+/* Get network interface device object */
+struct netdev *netdev_get_first_by_flags(uint16_t flags);
+struct netdev *netdev_get_by_ipaddr(ip_addr_t *ip_addr);
+struct netdev *netdev_get_by_name(const char *name);
+
+/* Set default network interface device in list */
+void netdev_set_default(struct netdev *netdev);
+
+/* Set network interface device status */
+#define netdev_is_up(netdev)           (((netdev)->flags & NETDEV_FLAG_UP) ? (uint8_t)1 : (uint8_t)0)
+#define netdev_is_link_up(netdev)      (((netdev)->flags & NETDEV_FLAG_LINK_UP) ? (uint8_t)1 : (uint8_t)0)
+#define netdev_is_internet_up(netdev)  (((netdev)->flags & NETDEV_FLAG_INTERNET_UP) ? (uint8_t)1 : (uint8_t)0)
+#define netdev_is_dhcp_enabled(netdev) (((netdev)->flags & NETDEV_FLAG_DHCP) ? (uint8_t)1 : (uint8_t)0)
+
+/* Set network interface device status and address callback function */
+void netdev_set_status_callback(struct netdev *netdev, netdev_callback_fn status_callback);
+void netdev_set_addr_callback(struct netdev *netdev, netdev_callback_fn addr_callback);
+
+/* Set network interface device address information and status for low level network drivers */
+void netdev_low_level_set_ipaddr(struct netdev *netdev, const ip_addr_t *ipaddr);
+void netdev_low_level_set_netmask(struct netdev *netdev, const ip_addr_t *netmask);
+void netdev_low_level_set_gw(struct netdev *netdev, const ip_addr_t *gw);
+void netdev_low_level_set_dns_server(struct netdev *netdev, uint8_t dns_num, const ip_addr_t *dns_server);
+void netdev_low_level_set_status(struct netdev *netdev, rt_bool_t is_up);
+void netdev_low_level_set_link_status(struct netdev *netdev, rt_bool_t is_up);
+void netdev_low_level_set_dhcp_status(struct netdev *netdev, rt_bool_t is_enable);
+
+/* The IPv4 address conversion of the network interface device */
+int netdev_ipaddr_aton(const char *cp, ip_addr_t *addr);
+char *netdev_ipaddr_ntoa(const ip_addr_t *addr);
+
+#undef inet_aton
+#undef inet_ntoa
+#define inet_aton(cp, addr)            netdev_ipaddr_aton(cp, (ip_addr_t *)(addr))
+#define inet_ntoa(addr)                netdev_ipaddr_ntoa((const ip_addr_t *)&(addr))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NETDEV_H__ */
@@ -0,0 +1,69 @@
+/*
+ * File      : rtdbg.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The debug log macros for the Linux host build, the output level is limited by the file
+ * DBG_LVL and the runtime level set by the "-v" option of the host program.
+ */
+
+#ifndef RT_DBG_H__
+#define RT_DBG_H__
+
+#include <rtthread.h>
+
+#define DBG_ERROR           0
+#define DBG_WARNING         1
+#define DBG_INFO            2
+#define DBG_LOG             3
+
+#ifndef DBG_TAG
+#define DBG_TAG             "DBG"
+#endif
+
+#ifndef DBG_LVL
+#define DBG_LVL             DBG_WARNING
+#endif
+
+/* The runtime log level, it's set by the host program */
+extern int rt_host_log_level;
+
+#define dbg_log_line(lvl, level, color, fmt, ...)                                          \
+    do {                                                                                   \
+        if ((level) <= DBG_LVL && (level) <= rt_host_log_level)                            \
+        {                                                                                  \
+            rt_kprintf("\033[" #color "m[%u] " lvl "/%s: " fmt "\033[0m\n",                \
+                       rt_tick_get(), DBG_TAG, ##__VA_ARGS__);                             \
+        }                                                                                  \
+    } while (0)
+
+#define dbg_log(level, fmt, ...)  dbg_log_line("L", level, 0, fmt, ##__VA_ARGS__)
+#define dbg_raw(...)              rt_kprintf(__VA_ARGS__)
+
+#define LOG_D(fmt, ...)           dbg_log_line("D", DBG_LOG, 0, fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...)           dbg_log_line("I", DBG_INFO, 32, fmt, ##__VA_ARGS__)
+#define LOG_W(fmt, ...)           dbg_log_line("W", DBG_WARNING, 33, fmt, ##__VA_ARGS__)
+#define LOG_E(fmt, ...)           dbg_log_line("E", DBG_ERROR, 31, fmt, ##__VA_ARGS__)
+#define LOG_RAW(...)              dbg_raw(__VA_ARGS__)
+
+#endif /* RT_DBG_H__ */
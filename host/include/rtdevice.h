@@ -0,0 +1,88 @@
+/*
+ * File      : rtdevice.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The PIN device and work queue API for the Linux host build, the pins are virtual and keep
+ * the written level, the pin interrupt is not supported.
+ */
+
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIN_LOW                         0x00
+#define PIN_HIGH                        0x01
+
+#define PIN_MODE_OUTPUT                 0x00
+#define PIN_MODE_INPUT                  0x01
+#define PIN_MODE_INPUT_PULLUP           0x02
+#define PIN_MODE_INPUT_PULLDOWN         0x03
+#define PIN_MODE_OUTPUT_OD              0x04
+
+#define PIN_IRQ_MODE_RISING             0x00
+#define PIN_IRQ_MODE_FALLING            0x01
+#define PIN_IRQ_MODE_RISING_FALLING     0x02
+#define PIN_IRQ_MODE_HIGH_LEVEL         0x03
+#define PIN_IRQ_MODE_LOW_LEVEL          0x04
+
+#define PIN_IRQ_DISABLE                 0x00
+#define PIN_IRQ_ENABLE                  0x01
+
+void rt_pin_mode(rt_base_t pin, rt_base_t mode);
+void rt_pin_write(rt_base_t pin, rt_base_t value);
+int rt_pin_read(rt_base_t pin);
+rt_err_t rt_pin_attach_irq(rt_int32_t pin, rt_uint32_t mode, void (*hdr)(void *args), void *args);
+rt_err_t rt_pin_detach_irq(rt_int32_t pin);
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint32_t enabled);
+
+struct rt_work
+{
+    rt_list_t list;
+
+    void (*work_func)(struct rt_work *work, void *work_data);
+    void *work_data;
+};
+
+struct rt_delayed_work
+{
+    struct rt_work work;
+    struct rt_timer timer;
+};
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data);
+void rt_delayed_work_init(struct rt_delayed_work *work,
+                          void (*work_func)(struct rt_work *work, void *work_data), void *work_data);
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_DEVICE_H__ */
@@ -0,0 +1,433 @@
+/*
+ * File      : rtthread.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The minimal RT-Thread kernel API for the Linux host build of at_device, the threads and
+ * IPC objects are implemented by POSIX threads, one tick is one millisecond.
+ */
+
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include <rtconfig.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef signed   char                   rt_int8_t;
+typedef signed   short                  rt_int16_t;
+typedef signed   int                    rt_int32_t;
+typedef unsigned char                   rt_uint8_t;
+typedef unsigned short                  rt_uint16_t;
+typedef unsigned int                    rt_uint32_t;
+typedef signed long long                rt_int64_t;
+typedef unsigned long long              rt_uint64_t;
+typedef int                             rt_bool_t;
+typedef long                            rt_base_t;
+typedef unsigned long                   rt_ubase_t;
+typedef rt_base_t                       rt_err_t;
+typedef rt_uint32_t                     rt_time_t;
+typedef rt_uint32_t                     rt_tick_t;
+typedef rt_base_t                       rt_flag_t;
+typedef rt_ubase_t                      rt_size_t;
+typedef rt_base_t                       rt_off_t;
+
+#define RT_TRUE                         1
+#define RT_FALSE                        0
+
+#define RT_NULL                         ((void *)0)
+
+#define RT_UINT8_MAX                    0xff
+#define RT_UINT16_MAX                   0xffff
+#define RT_UINT32_MAX                   0xffffffff
+#define RT_TICK_MAX                     RT_UINT32_MAX
+
+#define RT_EOK                          0
+#define RT_ERROR                        1
+#define RT_ETIMEOUT                     2
+#define RT_EFULL                        3
+#define RT_EEMPTY                       4
+#define RT_ENOMEM                       5
+#define RT_ENOSYS                       6
+#define RT_EBUSY                        7
+#define RT_EIO                          8
+#define RT_EINTR                        9
+#define RT_EINVAL                       10
+
+#define RT_WAITING_FOREVER              -1
+#define RT_WAITING_NO                   0
+
+#define RT_IPC_FLAG_FIFO                0x00
+#define RT_IPC_FLAG_PRIO                0x01
+#define RT_IPC_CMD_RESET                0x01
+
+#define RT_EVENT_FLAG_AND               0x01
+#define RT_EVENT_FLAG_OR                0x02
+#define RT_EVENT_FLAG_CLEAR             0x04
+
+#define RT_TIMER_FLAG_DEACTIVATED       0x0
+#define RT_TIMER_FLAG_ACTIVATED         0x1
+#define RT_TIMER_FLAG_ONE_SHOT          0x0
+#define RT_TIMER_FLAG_PERIODIC          0x2
+#define RT_TIMER_FLAG_HARD_TIMER        0x0
+#define RT_TIMER_FLAG_SOFT_TIMER        0x4
+#define RT_TIMER_CTRL_SET_TIME          0x0
+#define RT_TIMER_CTRL_GET_TIME          0x1
+#define RT_TIMER_CTRL_SET_ONESHOT       0x2
+#define RT_TIMER_CTRL_SET_PERIODIC      0x3
+
+#define rt_inline                       static __inline
+#define RT_WEAK                         __attribute__((weak))
+#define ALIGN(n)                        __attribute__((aligned(n)))
+#define RT_ALIGN(size, align)           (((size) + (align) - 1) & ~((align) - 1))
+#define RT_ALIGN_DOWN(size, align)      ((size) & ~((align) - 1))
+#define RT_UNUSED(x)                    ((void)(x))
+
+#define RT_ASSERT(EX)                                                         \
+    do {                                                                      \
+        if (!(EX))                                                            \
+        {                                                                     \
+            rt_assert_handler(#EX, __FUNCTION__, __LINE__);                   \
+        }                                                                     \
+    } while (0)
+
+/* ==================== list ==================== */
+
+struct rt_list_node
+{
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+};
+typedef struct rt_list_node rt_list_t;
+
+struct rt_slist_node
+{
+    struct rt_slist_node *next;
+};
+typedef struct rt_slist_node rt_slist_t;
+
+#define rt_container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+
+#define RT_LIST_OBJECT_INIT(object)     { &(object), &(object) }
+#define RT_SLIST_OBJECT_INIT(object)    { RT_NULL }
+
+rt_inline void rt_list_init(rt_list_t *l)
+{
+    l->next = l->prev = l;
+}
+
+rt_inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n)
+{
+    l->prev->next = n;
+    n->prev = l->prev;
+    l->prev = n;
+    n->next = l;
+}
+
+rt_inline void rt_list_remove(rt_list_t *n)
+{
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+    n->next = n->prev = n;
+}
+
+rt_inline int rt_list_isempty(const rt_list_t *l)
+{
+    return l->next == l;
+}
+
+#define rt_list_entry(node, type, member) rt_container_of(node, type, member)
+
+rt_inline void rt_slist_init(rt_slist_t *l)
+{
+    l->next = RT_NULL;
+}
+
+rt_inline void rt_slist_append(rt_slist_t *l, rt_slist_t *n)
+{
+    struct rt_slist_node *node = l;
+
+    while (node->next)
+    {
+        node = node->next;
+    }
+
+    node->next = n;
+    n->next = RT_NULL;
+}
+
+rt_inline void rt_slist_insert(rt_slist_t *l, rt_slist_t *n)
+{
+    n->next = l->next;
+    l->next = n;
+}
+
+rt_inline unsigned int rt_slist_len(const rt_slist_t *l)
+{
+    unsigned int len = 0;
+    const rt_slist_t *list = l->next;
+
+    while (list != RT_NULL)
+    {
+        list = list->next;
+        len++;
+    }
+
+    return len;
+}
+
+rt_inline rt_slist_t *rt_slist_remove(rt_slist_t *l, rt_slist_t *n)
+{
+    struct rt_slist_node *node = l;
+
+    while (node->next && node->next != n)
+    {
+        node = node->next;
+    }
+
+    if (node->next != RT_NULL)
+    {
+        node->next = node->next->next;
+    }
+
+    return l;
+}
+
+rt_inline rt_slist_t *rt_slist_first(rt_slist_t *l)
+{
+    return l->next;
+}
+
+rt_inline rt_slist_t *rt_slist_next(rt_slist_t *n)
+{
+    return n->next;
+}
+
+rt_inline int rt_slist_isempty(rt_slist_t *l)
+{
+    return l->next == RT_NULL;
+}
+
+#define rt_slist_entry(node, type, member) rt_container_of(node, type, member)
+
+#define rt_slist_for_each(pos, head) \
+    for (pos = (head)->next; pos != RT_NULL; pos = pos->next)
+
+/* ==================== kernel objects ==================== */
+
+struct rt_object
+{
+    char       name[RT_NAME_MAX];
+    rt_uint8_t type;
+    rt_uint8_t flag;
+    rt_list_t  list;
+};
+
+#define RT_Object_Class_Static          0x80
+
+struct rt_thread
+{
+    struct rt_object parent;
+    pthread_t tid;
+    void (*entry)(void *parameter);
+    void *parameter;
+    rt_uint32_t stack_size;
+    rt_uint8_t current_priority;
+    rt_uint32_t init_tick;
+    void *user_data;
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_semaphore
+{
+    struct rt_object parent;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_uint32_t value;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_mutex
+{
+    struct rt_object parent;
+    pthread_mutex_t lock;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_event
+{
+    struct rt_object parent;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_uint32_t set;
+};
+typedef struct rt_event *rt_event_t;
+
+struct rt_memheap
+{
+    struct rt_object parent;
+    void *start_addr;                            /* The pool memory, carved into the blocks */
+    rt_size_t pool_size;
+    rt_size_t available_size;
+    rt_size_t max_used_size;
+    struct rt_memheap *next;                     /* The memory heaps searched by rt_free() */
+};
+
+struct rt_timer
+{
+    struct rt_object parent;
+    void (*timeout_func)(void *parameter);
+    void *parameter;
+    rt_tick_t init_tick;
+    rt_tick_t timeout_tick;
+    rt_list_t list;
+};
+typedef struct rt_timer *rt_timer_t;
+
+struct rt_device
+{
+    struct rt_object parent;
+    int fd;                                      /* The host file descriptor of the serial */
+    void *user_data;
+};
+typedef struct rt_device *rt_device_t;
+
+/* ==================== kernel API ==================== */
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line);
+
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+
+rt_base_t rt_hw_interrupt_disable(void);
+void rt_hw_interrupt_enable(rt_base_t level);
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+rt_err_t rt_thread_init(struct rt_thread *thread, const char *name, void (*entry)(void *parameter),
+                        void *parameter, void *stack_start, rt_uint32_t stack_size, rt_uint8_t priority,
+                        rt_uint32_t tick);
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_thread_t rt_thread_self(void);
+rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+rt_err_t rt_thread_yield(void);
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_detach(rt_sem_t sem);
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_delete(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout);
+rt_err_t rt_sem_trytake(rt_sem_t sem);
+rt_err_t rt_sem_release(rt_sem_t sem);
+rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg);
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_delete(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag);
+rt_err_t rt_event_detach(rt_event_t event);
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_event_delete(rt_event_t event);
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set);
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt, rt_int32_t timeout,
+                       rt_uint32_t *recved);
+rt_err_t rt_event_control(rt_event_t event, int cmd, void *arg);
+
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter),
+                   void *parameter, rt_tick_t time, rt_uint8_t flag);
+rt_err_t rt_timer_detach(rt_timer_t timer);
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter), void *parameter,
+                           rt_tick_t time, rt_uint8_t flag);
+rt_err_t rt_timer_delete(rt_timer_t timer);
+rt_err_t rt_timer_start(rt_timer_t timer);
+rt_err_t rt_timer_stop(rt_timer_t timer);
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
+
+void *rt_malloc(rt_size_t size);
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void *rt_realloc(void *ptr, rt_size_t size);
+void rt_free(void *ptr);
+
+rt_err_t rt_memheap_init(struct rt_memheap *memheap, const char *name, void *start_addr, rt_size_t size);
+void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
+void rt_memheap_free(void *ptr);
+
+rt_device_t rt_device_find(const char *name);
+
+void rt_kprintf(const char *fmt, ...);
+#define rt_snprintf                     snprintf
+#define rt_vsnprintf                    vsnprintf
+#define rt_sprintf                      sprintf
+#define rt_memset                       memset
+#define rt_memcpy                       memcpy
+#define rt_memmove                      memmove
+#define rt_memcmp                       memcmp
+#define rt_strstr                       strstr
+#define rt_strcmp                       strcmp
+#define rt_strncmp                      strncmp
+#define rt_strncpy                      strncpy
+#define rt_strlen                       strlen
+#define rt_strdup                       strdup
+
+/* ==================== components initialization ==================== */
+
+typedef int (*init_fn_t)(void);
+
+void rt_host_init_register(init_fn_t fn, int level, const char *name);
+int rt_components_init(void);
+
+#define RT_HOST_INIT_EXPORT(fn, level)                                        \
+    static void __attribute__((constructor)) __rt_init_##fn(void)             \
+    {                                                                         \
+        rt_host_init_register(fn, level, #fn);                                \
+    }
+
+#define INIT_BOARD_EXPORT(fn)           RT_HOST_INIT_EXPORT(fn, 1)
+#define INIT_PREV_EXPORT(fn)            RT_HOST_INIT_EXPORT(fn, 2)
+#define INIT_DEVICE_EXPORT(fn)          RT_HOST_INIT_EXPORT(fn, 3)
+#define INIT_COMPONENT_EXPORT(fn)       RT_HOST_INIT_EXPORT(fn, 4)
+#define INIT_ENV_EXPORT(fn)             RT_HOST_INIT_EXPORT(fn, 5)
+#define INIT_APP_EXPORT(fn)             RT_HOST_INIT_EXPORT(fn, 6)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_THREAD_H__ */
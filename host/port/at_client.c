@@ -0,0 +1,817 @@
+/*
+ * File      : at_client.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The AT client of the Linux host build, the line parser follows the AT component 1.3.0, the
+ * serial device is a host file descriptor (a pty or one end of a socketpair).
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <at.h>
+
+#define DBG_TAG              "at.clnt"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#define AT_RESP_END_OK       "OK"
+#define AT_RESP_END_ERROR    "ERROR"
+#define AT_RESP_END_FAIL     "FAIL"
+#define AT_END_CR_LF         "\r\n"
+
+#define AT_CLIENT_NUM_MAX    4
+#define HOST_SERIAL_NUM_MAX  4
+#define HOST_SERIAL_BUF_SIZE 1024
+
+/* the host serial device, the received data is buffered for the AT client getchar */
+struct host_serial
+{
+    struct rt_device parent;
+
+    char buf[HOST_SERIAL_BUF_SIZE];
+    rt_size_t pos;
+    rt_size_t len;
+};
+
+static struct host_serial host_serial_table[HOST_SERIAL_NUM_MAX] = { 0 };
+static struct at_client at_client_table[AT_CLIENT_NUM_MAX] = { 0 };
+
+/**
+ * This function will bind the AT client device name to a host file descriptor.
+ *
+ * @param dev_name the device name used by at_client_init()
+ * @param fd the host file descriptor, e.g. the pty master or a socketpair
+ *
+ * @return 0: bind successfully
+ *        -1: no free serial device
+ */
+int rt_host_serial_bind(const char *dev_name, int fd)
+{
+    int idx;
+
+    for (idx = 0; idx < HOST_SERIAL_NUM_MAX; idx++)
+    {
+        if (host_serial_table[idx].parent.parent.name[0] == '\0')
+        {
+            rt_strncpy(host_serial_table[idx].parent.parent.name, dev_name, RT_NAME_MAX - 1);
+            host_serial_table[idx].parent.fd = fd;
+            return RT_EOK;
+        }
+    }
+
+    return -RT_ERROR;
+}
+
+rt_device_t rt_device_find(const char *name)
+{
+    int idx;
+
+    for (idx = 0; idx < HOST_SERIAL_NUM_MAX; idx++)
+    {
+        if (rt_strncmp(host_serial_table[idx].parent.parent.name, name, RT_NAME_MAX) == 0)
+        {
+            return &(host_serial_table[idx].parent);
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * Create response object.
+ *
+ * @param buf_size the maximum response buffer size
+ * @param line_num the number of setting response lines
+ *         = 0: the response data will auto return when received 'OK' or 'ERROR'
+ *        != 0: the response data will return when received setting lines number data
+ * @param timeout the maximum response time
+ *
+ * @return != RT_NULL: response object
+ *          = RT_NULL: no memory
+ */
+at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    at_response_t resp = RT_NULL;
+
+    resp = (at_response_t) rt_calloc(1, sizeof(struct at_response));
+    if (resp == RT_NULL)
+    {
+        LOG_E("AT create response object failed! No memory for response object!");
+        return RT_NULL;
+    }
+
+    resp->buf = (char *) rt_calloc(1, buf_size);
+    if (resp->buf == RT_NULL)
+    {
+        LOG_E("AT create response object failed! No memory for response buffer!");
+        rt_free(resp);
+        return RT_NULL;
+    }
+
+    resp->buf_size = buf_size;
+    resp->line_num = line_num;
+    resp->line_counts = 0;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+void at_delete_resp(at_response_t resp)
+{
+    if (resp && resp->buf)
+    {
+        rt_free(resp->buf);
+    }
+
+    if (resp)
+    {
+        rt_free(resp);
+    }
+}
+
+at_response_t at_resp_set_info(at_response_t resp, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    RT_ASSERT(resp);
+
+    if (resp->buf_size != buf_size)
+    {
+        resp->buf_size = buf_size;
+
+        resp->buf = (char *) rt_realloc(resp->buf, buf_size);
+        if (!resp->buf)
+        {
+            LOG_D("No memory for realloc response buffer size(%d).", buf_size);
+            return RT_NULL;
+        }
+    }
+
+    resp->line_num = line_num;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+const char *at_resp_get_line(at_response_t resp, rt_size_t resp_line)
+{
+    char *resp_buf = resp->buf;
+    rt_size_t line_num = 1;
+
+    RT_ASSERT(resp);
+
+    if (resp_line > resp->line_counts || resp_line <= 0)
+    {
+        LOG_E("AT response get line failed! Input response line(%d) error!", resp_line);
+        return RT_NULL;
+    }
+
+    for (line_num = 1; line_num <= resp->line_counts; line_num++)
+    {
+        if (resp_line == line_num)
+        {
+            return resp_buf;
+        }
+
+        resp_buf += strlen(resp_buf) + 1;
+    }
+
+    return RT_NULL;
+}
+
+const char *at_resp_get_line_by_kw(at_response_t resp, const char *keyword)
+{
+    char *resp_buf = resp->buf;
+    rt_size_t line_num = 1;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(keyword);
+
+    for (line_num = 1; line_num <= resp->line_counts; line_num++)
+    {
+        if (strstr(resp_buf, keyword))
+        {
+            return resp_buf;
+        }
+
+        resp_buf += strlen(resp_buf) + 1;
+    }
+
+    return RT_NULL;
+}
+
+int at_resp_parse_line_args(at_response_t resp, rt_size_t resp_line, const char *resp_expr, ...)
+{
+    va_list args;
+    int resp_args_num = 0;
+    const char *resp_line_buf = RT_NULL;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(resp_expr);
+
+    if ((resp_line_buf = at_resp_get_line(resp, resp_line)) == RT_NULL)
+    {
+        return -1;
+    }
+
+    va_start(args, resp_expr);
+    resp_args_num = vsscanf(resp_line_buf, resp_expr, args);
+    va_end(args);
+
+    return resp_args_num;
+}
+
+int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const char *resp_expr, ...)
+{
+    va_list args;
+    int resp_args_num = 0;
+    const char *resp_line_buf = RT_NULL;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(resp_expr);
+
+    if ((resp_line_buf = at_resp_get_line_by_kw(resp, keyword)) == RT_NULL)
+    {
+        return -1;
+    }
+
+    va_start(args, resp_expr);
+    resp_args_num = vsscanf(resp_line_buf, resp_expr, args);
+    va_end(args);
+
+    return resp_args_num;
+}
+
+/**
+ * Send commands to AT server and wait response.
+ *
+ * @param client current AT client object
+ * @param resp AT response object, using RT_NULL when you don't care response
+ * @param cmd_expr AT commands expression
+ *
+ * @return 0 : success
+ *        -1 : response status error
+ *        -2 : wait timeout
+ */
+int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr, ...)
+{
+    va_list args;
+    char send_buf[AT_CMD_MAX_LEN + 2];
+    rt_size_t cmd_size = 0;
+    rt_err_t result = RT_EOK;
+
+    RT_ASSERT(cmd_expr);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+
+    client->resp_status = AT_RESP_OK;
+    client->resp = resp;
+
+    if (resp != RT_NULL)
+    {
+        resp->buf_len = 0;
+        resp->line_counts = 0;
+    }
+
+    /* the stale response notice of the previous timeout command is dropped */
+    rt_sem_control(client->resp_notice, RT_IPC_CMD_RESET, RT_NULL);
+
+    va_start(args, cmd_expr);
+    cmd_size = vsnprintf(send_buf, AT_CMD_MAX_LEN, cmd_expr, args);
+    va_end(args);
+    if (cmd_size > AT_CMD_MAX_LEN - 1)
+    {
+        cmd_size = AT_CMD_MAX_LEN - 1;
+    }
+    LOG_D("%.*s", cmd_size, send_buf);
+    rt_memcpy(send_buf + cmd_size, AT_END_CR_LF, 2);
+    at_client_obj_send(client, send_buf, cmd_size + 2);
+
+    if (resp != RT_NULL)
+    {
+        if (rt_sem_take(client->resp_notice, resp->timeout) != RT_EOK)
+        {
+            LOG_D("execute command (%.*s) timeout (%d ticks)!", cmd_size, send_buf, resp->timeout);
+            client->resp_status = AT_RESP_TIMEOUT;
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
+        if (client->resp_status != AT_RESP_OK)
+        {
+            LOG_E("execute command (%.*s) failed!", cmd_size, send_buf);
+            result = -RT_ERROR;
+            goto __exit;
+        }
+    }
+
+__exit:
+    client->resp = RT_NULL;
+
+    rt_mutex_release(client->lock);
+
+    return result;
+}
+
+/**
+ * Waiting for connection to external devices.
+ *
+ * @param client current AT client object
+ * @param timeout millisecond for timeout
+ *
+ * @return 0 : success
+ *        -2 : timeout
+ *        -5 : no memory
+ */
+int at_client_obj_wait_connect(at_client_t client, rt_uint32_t timeout)
+{
+    rt_err_t result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    rt_tick_t start_time = 0;
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(16, 0, rt_tick_from_millisecond(500));
+    if (resp == RT_NULL)
+    {
+        LOG_E("No memory for response object!");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+    client->resp = resp;
+
+    start_time = rt_tick_get();
+
+    while (1)
+    {
+        /* Check whether it is timeout */
+        if (rt_tick_get() - start_time > rt_tick_from_millisecond(timeout))
+        {
+            LOG_E("wait connect timeout (%d millisecond)!", timeout);
+            result = -RT_ETIMEOUT;
+            break;
+        }
+
+        /* Check whether it is already connected */
+        resp->buf_len = 0;
+        resp->line_counts = 0;
+        client->resp = resp;
+        at_client_obj_send(client, "AT\r\n", 4);
+
+        if (rt_sem_take(client->resp_notice, resp->timeout) != RT_EOK)
+        {
+            continue;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    at_delete_resp(resp);
+
+    client->resp = RT_NULL;
+
+    rt_mutex_release(client->lock);
+
+    return result;
+}
+
+/**
+ * Send data to AT server, send data don't have end sign(eg: \r\n).
+ *
+ * @param client current AT client object
+ * @param buf   send data buffer
+ * @param size  send fixed data size
+ *
+ * @return >0: send data size
+ *         =0: send failed
+ */
+rt_size_t at_client_obj_send(at_client_t client, const char *buf, rt_size_t size)
+{
+    rt_size_t sent = 0;
+    ssize_t len = 0;
+
+    RT_ASSERT(buf);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return 0;
+    }
+
+    while (sent < size)
+    {
+        len = write(client->device->fd, buf + sent, size - sent);
+        if (len < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            break;
+        }
+        sent += len;
+    }
+
+    return sent;
+}
+
+static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeout)
+{
+    struct host_serial *serial = (struct host_serial *) client->device;
+    struct pollfd pfd;
+    ssize_t len = 0;
+
+    if (serial->pos >= serial->len)
+    {
+        pfd.fd = serial->parent.fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        if (poll(&pfd, 1, (timeout < 0) ? -1 : (int) (timeout * 1000 / RT_TICK_PER_SECOND)) <= 0)
+        {
+            return -RT_ETIMEOUT;
+        }
+
+        len = read(serial->parent.fd, serial->buf, sizeof(serial->buf));
+        if (len <= 0)
+        {
+            /* the peer is closed, don't spin on the end of file */
+            rt_thread_mdelay(100);
+            return -RT_EIO;
+        }
+
+        serial->pos = 0;
+        serial->len = (rt_size_t) len;
+    }
+
+    *ch = serial->buf[serial->pos++];
+
+    return RT_EOK;
+}
+
+/**
+ * AT client receive fixed-length data, it's called in the URC function of the parser thread.
+ *
+ * @param client current AT client object
+ * @param buf   receive data buffer
+ * @param size  receive fixed data size
+ * @param timeout  receive data timeout (ms)
+ *
+ * @return >0: receive data size
+ *         =0: receive failed
+ */
+rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_int32_t timeout)
+{
+    rt_size_t read_idx = 0;
+    char ch;
+
+    RT_ASSERT(buf);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return 0;
+    }
+
+    while (read_idx < size)
+    {
+        if (at_client_getchar(client, &ch, rt_tick_from_millisecond(timeout)) != RT_EOK)
+        {
+            LOG_E("AT Client receive failed, uart device get data error");
+            return 0;
+        }
+
+        buf[read_idx++] = ch;
+    }
+
+    return read_idx;
+}
+
+void at_obj_set_end_sign(at_client_t client, char ch)
+{
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return;
+    }
+
+    client->end_sign = ch;
+}
+
+int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_size_t table_sz)
+{
+    struct at_urc_table *new_table = RT_NULL;
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    new_table = (struct at_urc_table *) rt_realloc(client->urc_table,
+            (client->urc_table_size + 1) * sizeof(struct at_urc_table));
+    if (new_table == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    new_table[client->urc_table_size].urc = urc_table;
+    new_table[client->urc_table_size].urc_size = table_sz;
+    client->urc_table = new_table;
+    client->urc_table_size++;
+
+    return RT_EOK;
+}
+
+at_client_t at_client_get(const char *dev_name)
+{
+    int idx = 0;
+
+    RT_ASSERT(dev_name);
+
+    for (idx = 0; idx < AT_CLIENT_NUM_MAX; idx++)
+    {
+        if (at_client_table[idx].device &&
+                rt_strcmp(at_client_table[idx].device->parent.name, dev_name) == 0)
+        {
+            return &at_client_table[idx];
+        }
+    }
+
+    return RT_NULL;
+}
+
+at_client_t at_client_get_first(void)
+{
+    if (at_client_table[0].device == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    return &at_client_table[0];
+}
+
+static const struct at_urc *get_urc_obj(at_client_t client)
+{
+    rt_size_t i, j, prefix_len, suffix_len;
+    rt_size_t bufsz;
+    char *buffer = RT_NULL;
+    const struct at_urc *urc = RT_NULL;
+
+    if (client->urc_table == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    buffer = client->recv_line_buf;
+    bufsz = client->recv_line_len;
+
+    for (i = 0; i < client->urc_table_size; i++)
+    {
+        for (j = 0; j < client->urc_table[i].urc_size; j++)
+        {
+            urc = client->urc_table[i].urc + j;
+
+            prefix_len = rt_strlen(urc->cmd_prefix);
+            suffix_len = rt_strlen(urc->cmd_suffix);
+            if (bufsz < prefix_len + suffix_len)
+            {
+                continue;
+            }
+            if ((prefix_len ? !rt_strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
+                    && (suffix_len ? !rt_strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
+            {
+                return urc;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+static int at_recv_readline(at_client_t client)
+{
+    rt_size_t read_len = 0;
+    char ch = 0, last_ch = 0;
+    rt_bool_t is_full = RT_FALSE;
+
+    rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+    client->recv_line_len = 0;
+
+    while (1)
+    {
+        if (at_client_getchar(client, &ch, RT_WAITING_FOREVER) != RT_EOK)
+        {
+            continue;
+        }
+
+        if (read_len < client->recv_bufsz)
+        {
+            client->recv_line_buf[read_len++] = ch;
+            client->recv_line_len = read_len;
+        }
+        else
+        {
+            is_full = RT_TRUE;
+        }
+
+        /* is newline or URC data */
+        if ((ch == '\n' && last_ch == '\r') || (client->end_sign != 0 && ch == client->end_sign)
+                || get_urc_obj(client))
+        {
+            if (is_full)
+            {
+                LOG_E("read line failed. The line data length is out of buffer size(%d)!", client->recv_bufsz);
+                rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+                client->recv_line_len = 0;
+                return -RT_EFULL;
+            }
+            break;
+        }
+        last_ch = ch;
+    }
+
+    return read_len;
+}
+
+static void client_parser(at_client_t client)
+{
+    const struct at_urc *urc;
+
+    while (1)
+    {
+        if (at_recv_readline(client) > 0)
+        {
+            if ((urc = get_urc_obj(client)) != RT_NULL)
+            {
+                /* current receive is request, try to execute related operations */
+                if (urc->func != RT_NULL)
+                {
+                    urc->func(client, client->recv_line_buf, client->recv_line_len);
+                }
+            }
+            else if (client->resp != RT_NULL)
+            {
+                at_response_t resp = client->resp;
+                char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+
+                /* current receive is response */
+                client->recv_line_buf[client->recv_line_len - 1] = '\0';
+                if (resp->buf_len + client->recv_line_len < resp->buf_size)
+                {
+                    /* copy response lines, separated by '\0' */
+                    rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
+
+                    /* update the current response information */
+                    resp->buf_len += client->recv_line_len;
+                    resp->line_counts++;
+                }
+                else
+                {
+                    client->resp_status = AT_RESP_BUFF_FULL;
+                    LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!", resp->buf_size);
+                }
+                /* check response result */
+                if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
+                {
+                    /* get the end sign, return response state END_OK.*/
+                    client->resp_status = AT_RESP_OK;
+                }
+                else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
+                        && resp->line_num == 0)
+                {
+                    /* get the end data by response result, return response state END_OK. */
+                    client->resp_status = AT_RESP_OK;
+                }
+                else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
+                        || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
+                {
+                    client->resp_status = AT_RESP_ERROR;
+                }
+                else if (resp->line_counts == resp->line_num && resp->line_num)
+                {
+                    /* get the end data by response line, return response state END_OK.*/
+                    client->resp_status = AT_RESP_OK;
+                }
+                else
+                {
+                    continue;
+                }
+
+                client->resp = RT_NULL;
+                rt_sem_release(client->resp_notice);
+            }
+            else
+            {
+                LOG_D("unrecognized line: %.*s", client->recv_line_len, client->recv_line_buf);
+            }
+        }
+    }
+}
+
+/**
+ * AT client initialize.
+ *
+ * @param dev_name AT client device name, it's bound by rt_host_serial_bind()
+ * @param recv_bufsz the maximum number of receive buffer length
+ *
+ * @return 0 : initialize success
+ *        -1 : initialize failed
+ *        -5 : no memory
+ */
+int at_client_init(const char *dev_name, rt_size_t recv_bufsz)
+{
+    int idx = 0;
+    char name[RT_NAME_MAX];
+    at_client_t client = RT_NULL;
+
+    RT_ASSERT(dev_name);
+    RT_ASSERT(recv_bufsz > 0);
+
+    if (at_client_get(dev_name) != RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    for (idx = 0; idx < AT_CLIENT_NUM_MAX && at_client_table[idx].device; idx++);
+
+    if (idx >= AT_CLIENT_NUM_MAX)
+    {
+        LOG_E("AT client initialize failed! Check the maximum number(%d) of AT client.", AT_CLIENT_NUM_MAX);
+        return -RT_EFULL;
+    }
+
+    client = &at_client_table[idx];
+    client->recv_bufsz = recv_bufsz;
+
+    client->device = rt_device_find(dev_name);
+    if (client->device == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! Not find the device(%s), bind it by the -u or -e option.", dev_name);
+        return -RT_ERROR;
+    }
+
+    client->recv_line_buf = (char *) rt_calloc(1, recv_bufsz);
+    if (client->recv_line_buf == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! No memory for receive buffer.");
+        client->device = RT_NULL;
+        return -RT_ENOMEM;
+    }
+
+    rt_snprintf(name, RT_NAME_MAX, "at_%d", idx);
+    client->lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
+    client->resp_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    client->urc_table = RT_NULL;
+    client->urc_table_size = 0;
+
+    client->parser = rt_thread_create(name, (void (*)(void *parameter)) client_parser, client,
+                                      2048, RT_THREAD_PRIORITY_MAX / 3 - 1, 5);
+    if (client->lock == RT_NULL || client->resp_notice == RT_NULL || client->parser == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! No memory for the client objects.");
+        client->device = RT_NULL;
+        return -RT_ENOMEM;
+    }
+
+    client->status = AT_STATUS_INITIALIZED;
+    rt_thread_startup(client->parser);
+
+    LOG_I("AT client(V%s) on device %s initialize success.", AT_SW_VERSION, dev_name);
+
+    return RT_EOK;
+}
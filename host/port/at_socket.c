@@ -0,0 +1,556 @@
+/*
+ * File      : at_socket.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The AT socket layer of the Linux host build, the sockets are allocated on the AT device of the
+ * default network interface device like the SAL AT socket, the socket descriptor is global.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.skt"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#define AT_SOCKET_MAGIC      0xA100
+
+#ifndef AT_SOCKETS_NUM
+#define AT_SOCKETS_NUM       32
+#endif
+
+static struct at_socket *sockets[AT_SOCKETS_NUM] = { 0 };
+
+struct at_socket *at_get_socket(int socket)
+{
+    if (socket < 0 || socket >= AT_SOCKETS_NUM)
+    {
+        return RT_NULL;
+    }
+
+    if (sockets[socket] == RT_NULL || sockets[socket]->magic != AT_SOCKET_MAGIC)
+    {
+        return RT_NULL;
+    }
+
+    return sockets[socket];
+}
+
+/* the receive packet buffer is allocated by the AT device and freed here */
+static void at_recvpkt_put(rt_slist_t *rlist, const char *ptr, size_t length)
+{
+    at_recv_pkt_t pkt = RT_NULL;
+
+    pkt = (at_recv_pkt_t) rt_calloc(1, sizeof(struct at_recv_pkt));
+    if (pkt == RT_NULL)
+    {
+        LOG_E("No memory for receive packet table!");
+        rt_free((void *) ptr);
+        return;
+    }
+
+    pkt->bfsz_totle = length;
+    pkt->bfsz_index = 0;
+    pkt->buff = (char *) ptr;
+
+    rt_slist_append(rlist, &(pkt->list));
+}
+
+static void at_recvpkt_all_delete(rt_slist_t *rlist)
+{
+    at_recv_pkt_t pkt = RT_NULL;
+    rt_slist_t *node = RT_NULL;
+
+    while ((node = rt_slist_first(rlist)) != RT_NULL)
+    {
+        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
+        rt_slist_remove(rlist, node);
+        rt_free(pkt->buff);
+        rt_free(pkt);
+    }
+}
+
+static size_t at_recvpkt_get(rt_slist_t *rlist, char *mem, size_t len)
+{
+    rt_slist_t *node = RT_NULL;
+    at_recv_pkt_t pkt = RT_NULL;
+    size_t content_pos = 0, page_pos = 0;
+
+    while (content_pos < len && (node = rt_slist_first(rlist)) != RT_NULL)
+    {
+        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
+        page_pos = pkt->bfsz_totle - pkt->bfsz_index;
+        if (page_pos > len - content_pos)
+        {
+            page_pos = len - content_pos;
+        }
+
+        rt_memcpy(mem + content_pos, pkt->buff + pkt->bfsz_index, page_pos);
+        content_pos += page_pos;
+        pkt->bfsz_index += page_pos;
+
+        if (pkt->bfsz_index >= pkt->bfsz_totle)
+        {
+            rt_slist_remove(rlist, node);
+            rt_free(pkt->buff);
+            rt_free(pkt);
+        }
+    }
+
+    return content_pos;
+}
+
+static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+{
+    rt_base_t level;
+
+    RT_ASSERT(buff);
+    RT_ASSERT(event == AT_SOCKET_EVT_RECV);
+
+    /* the socket can't be freed while the received data is put */
+    level = rt_hw_interrupt_disable();
+
+    /* check the socket object status */
+    if (sock->magic != AT_SOCKET_MAGIC)
+    {
+        rt_hw_interrupt_enable(level);
+        rt_free((void *) buff);
+        return;
+    }
+
+    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+    at_recvpkt_put(&(sock->recvpkt_list), buff, bfsz);
+    rt_mutex_release(sock->recv_lock);
+
+    rt_sem_release(sock->recv_notice);
+
+    rt_hw_interrupt_enable(level);
+}
+
+static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+{
+    rt_base_t level;
+
+    RT_ASSERT(event == AT_SOCKET_EVT_CLOSED);
+
+    level = rt_hw_interrupt_disable();
+
+    /* check the socket object status */
+    if (sock->magic == AT_SOCKET_MAGIC)
+    {
+        sock->state = AT_SOCKET_CLOSED;
+        rt_sem_release(sock->recv_notice);
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/* the AT device of the default network interface device, as the AT socket component selects it */
+static struct at_device *at_default_device(void)
+{
+    struct at_device *device = RT_NULL;
+
+    if (netdev_default && netdev_is_up(netdev_default))
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev_default->name);
+    }
+
+    return device ? device : at_device_get_first_initialized();
+}
+
+static struct at_socket *alloc_socket(enum at_socket_type type)
+{
+    char name[RT_NAME_MAX];
+    int socket = 0, idx = 0;
+    rt_base_t level;
+    struct at_device *device = RT_NULL;
+    struct at_socket *sock = RT_NULL;
+
+    /* the sockets are placed on the default network interface device, the placement policy
+     * selects it again after each socket connect */
+    device = at_default_device();
+    if (device == RT_NULL)
+    {
+        LOG_E("no AT device for the socket.");
+        return RT_NULL;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (socket = 0; socket < AT_SOCKETS_NUM && sockets[socket]; socket++);
+    for (idx = 0; idx < (int) device->class->socket_num && device->sockets[idx].magic; idx++);
+
+    if (socket >= AT_SOCKETS_NUM || idx >= (int) device->class->socket_num)
+    {
+        rt_hw_interrupt_enable(level);
+        LOG_E("no free socket on AT device(%s).", device->name);
+        return RT_NULL;
+    }
+
+    sock = &(device->sockets[idx]);
+    sock->magic = AT_SOCKET_MAGIC;
+    sockets[socket] = sock;
+
+    sock->socket = socket;
+    sock->device = (void *) device;
+    sock->type = type;
+    sock->state = AT_SOCKET_OPEN;
+    sock->ops = device->class->socket_ops;
+    sock->recv_timeout = 0;
+    sock->send_timeout = 0;
+    sock->user_data = (void *) idx;
+    rt_slist_init(&(sock->recvpkt_list));
+
+    rt_snprintf(name, RT_NAME_MAX, "at_sr%d", socket);
+    sock->recv_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    sock->recv_lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
+
+    rt_hw_interrupt_enable(level);
+
+    /* set AT socket receive data and closed callback function */
+    sock->ops->at_set_event_cb(AT_SOCKET_EVT_RECV, at_recv_notice_cb);
+    sock->ops->at_set_event_cb(AT_SOCKET_EVT_CLOSED, at_closed_notice_cb);
+
+    return sock;
+}
+
+static void free_socket(struct at_socket *sock)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+
+    if (sock->recv_notice)
+    {
+        rt_sem_delete(sock->recv_notice);
+    }
+
+    if (sock->recv_lock)
+    {
+        rt_mutex_delete(sock->recv_lock);
+    }
+
+    at_recvpkt_all_delete(&(sock->recvpkt_list));
+
+    sockets[sock->socket] = RT_NULL;
+    rt_memset(sock, 0x00, sizeof(struct at_socket));
+
+    rt_hw_interrupt_enable(level);
+}
+
+int at_socket(int domain, int type, int protocol)
+{
+    struct at_socket *sock = RT_NULL;
+    enum at_socket_type socket_type;
+
+    /* check socket family protocol */
+    RT_ASSERT(domain == AF_INET);
+
+    switch (type)
+    {
+    case SOCK_STREAM:
+        socket_type = AT_SOCKET_TCP;
+        break;
+
+    case SOCK_DGRAM:
+        socket_type = AT_SOCKET_UDP;
+        break;
+
+    default:
+        LOG_E("Don't support socket type (%d)!", type);
+        errno = EINVAL;
+        return -1;
+    }
+
+    sock = alloc_socket(socket_type);
+    if (sock == RT_NULL)
+    {
+        errno = ENFILE;
+        return -1;
+    }
+
+    return sock->socket;
+}
+
+int at_closesocket(int socket)
+{
+    struct at_socket *sock = RT_NULL;
+    int result = 0;
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (sock->state == AT_SOCKET_CONNECT)
+    {
+        if (sock->ops->at_closesocket(sock) != 0)
+        {
+            result = -1;
+        }
+    }
+
+    free_socket(sock);
+
+    return result;
+}
+
+int at_shutdown(int socket, int how)
+{
+    return at_closesocket(socket);
+}
+
+/* convert the IPv4 socket address to the IP address string and port */
+static int socketaddr_to_ipaddr_port(const struct sockaddr *sockaddr, char ipstr[16], int *port)
+{
+    const struct sockaddr_in *sin = (const struct sockaddr_in *) sockaddr;
+    const uint8_t *addr = (const uint8_t *) &(sin->sin_addr.s_addr);
+
+    rt_snprintf(ipstr, 16, "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+    *port = ntohs(sin->sin_port);
+
+    return 0;
+}
+
+int at_connect(int socket, const struct sockaddr *name, socklen_t namelen)
+{
+    struct at_socket *sock = RT_NULL;
+    char ipstr[16] = { 0 };
+    int port = 0;
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (sock->state != AT_SOCKET_OPEN)
+    {
+        errno = EISCONN;
+        return -1;
+    }
+
+    socketaddr_to_ipaddr_port(name, ipstr, &port);
+
+    if (sock->ops->at_connect(sock, ipstr, port, sock->type, RT_TRUE) < 0)
+    {
+        errno = ECONNREFUSED;
+        return -1;
+    }
+
+    sock->state = AT_SOCKET_CONNECT;
+
+    return 0;
+}
+
+int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen)
+{
+    struct at_socket *sock = RT_NULL;
+    rt_int32_t timeout;
+    size_t recv_len = 0;
+
+    if (mem == RT_NULL || len == 0)
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    timeout = (sock->recv_timeout == 0) ? RT_WAITING_FOREVER : rt_tick_from_millisecond(sock->recv_timeout);
+
+    while (1)
+    {
+        rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+        recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *) mem, len);
+        rt_mutex_release(sock->recv_lock);
+
+        if (recv_len > 0)
+        {
+            return (int) recv_len;
+        }
+
+        /* the closed socket returns the end of file after the received data is read */
+        if (sock->state == AT_SOCKET_CLOSED)
+        {
+            return 0;
+        }
+
+        if (rt_sem_take(sock->recv_notice, timeout) != RT_EOK)
+        {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+}
+
+int at_recv(int socket, void *mem, size_t len, int flags)
+{
+    return at_recvfrom(socket, mem, len, flags, RT_NULL, RT_NULL);
+}
+
+int at_sendto(int socket, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen)
+{
+    struct at_socket *sock = RT_NULL;
+    char ipstr[16] = { 0 };
+    int port = 0, len = 0;
+
+    if (data == RT_NULL || size == 0)
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    /* the UDP socket is connected to the destination on the first sending */
+    if (sock->type == AT_SOCKET_UDP && sock->state == AT_SOCKET_OPEN && to)
+    {
+        socketaddr_to_ipaddr_port(to, ipstr, &port);
+        if (sock->ops->at_connect(sock, ipstr, port, sock->type, RT_TRUE) < 0)
+        {
+            errno = EIO;
+            return -1;
+        }
+        sock->state = AT_SOCKET_CONNECT;
+    }
+
+    if (sock->state != AT_SOCKET_CONNECT)
+    {
+        errno = ENOTCONN;
+        return -1;
+    }
+
+    len = sock->ops->at_send(sock, (const char *) data, size, sock->type);
+    if (len < 0)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    /* the AT device sends the whole data or fails, some return the last chunk size */
+    return (int) size;
+}
+
+int at_send(int socket, const void *data, size_t size, int flags)
+{
+    return at_sendto(socket, data, size, flags, RT_NULL, 0);
+}
+
+int at_setsockopt(int socket, int level, int optname, const void *optval, socklen_t optlen)
+{
+    struct at_socket *sock = RT_NULL;
+    const struct timeval *tv = (const struct timeval *) optval;
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (level != SOL_SOCKET || optval == RT_NULL || optlen < sizeof(struct timeval))
+    {
+        errno = ENOPROTOOPT;
+        return -1;
+    }
+
+    switch (optname)
+    {
+    case SO_RCVTIMEO:
+        sock->recv_timeout = tv->tv_sec * 1000 + tv->tv_usec / 1000;
+        break;
+
+    case SO_SNDTIMEO:
+        sock->send_timeout = tv->tv_sec * 1000 + tv->tv_usec / 1000;
+        break;
+
+    default:
+        errno = ENOPROTOOPT;
+        return -1;
+    }
+
+    return 0;
+}
+
+struct hostent *at_gethostbyname(const char *name)
+{
+    static struct hostent s_hostent;
+    static char *s_aliases;
+    static struct in_addr s_hostent_addr;
+    static char *s_hostent_addr_list[2];
+    static char s_hostname[64];
+    char ipstr[16] = { 0 };
+    struct at_device *device = RT_NULL;
+    uint8_t addr[4];
+
+    if (name == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    if (sscanf(name, "%hhu.%hhu.%hhu.%hhu", &addr[0], &addr[1], &addr[2], &addr[3]) == 4)
+    {
+        rt_strncpy(ipstr, name, sizeof(ipstr) - 1);
+    }
+    else
+    {
+        device = at_default_device();
+        if (device == RT_NULL || device->class->socket_ops->at_domain_resolve(name, ipstr) < 0 ||
+                sscanf(ipstr, "%hhu.%hhu.%hhu.%hhu", &addr[0], &addr[1], &addr[2], &addr[3]) != 4)
+        {
+            return RT_NULL;
+        }
+    }
+
+    rt_memcpy(&(s_hostent_addr.s_addr), addr, sizeof(addr));
+    s_hostent_addr_list[0] = (char *) &s_hostent_addr;
+    s_hostent_addr_list[1] = RT_NULL;
+    rt_strncpy(s_hostname, name, sizeof(s_hostname) - 1);
+    s_aliases = RT_NULL;
+
+    s_hostent.h_name = s_hostname;
+    s_hostent.h_aliases = &s_aliases;
+    s_hostent.h_addrtype = AF_INET;
+    s_hostent.h_length = sizeof(struct in_addr);
+    s_hostent.h_addr_list = s_hostent_addr_list;
+
+    return &s_hostent;
+}
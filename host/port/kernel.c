@@ -0,0 +1,1031 @@
+/*
+ * File      : kernel.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The RT-Thread kernel shim of the Linux host build, the threads, IPC objects and timers are
+ * implemented by POSIX threads, the critical section is one process wide recursive mutex.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define DBG_TAG              "host"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#define HOST_INIT_MAX        64
+#define HOST_PIN_MAX         256
+
+int rt_host_log_level = DBG_INFO;
+
+static pthread_mutex_t host_critical_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_mutex_t host_print_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread rt_thread_t host_thread_self = RT_NULL;
+static struct rt_thread host_main_thread = { { "main" } };
+
+static void host_object_init(struct rt_object *object, const char *name);
+static struct rt_memheap *host_memheap_find(void *ptr);
+
+/* ==================== misc ==================== */
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    rt_kprintf("(%s) assertion failed at function:%s, line number:%d \n", ex, func, (int) line);
+    abort();
+}
+
+void rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+
+    pthread_mutex_lock(&host_print_lock);
+    va_start(args, fmt);
+    vfprintf(stdout, fmt, args);
+    va_end(args);
+    fflush(stdout);
+    pthread_mutex_unlock(&host_print_lock);
+}
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void *rt_realloc(void *ptr, rt_size_t size)
+{
+    return realloc(ptr, size);
+}
+
+void rt_free(void *ptr)
+{
+    /* the memory heap blocks are freed by rt_free() as RT_USING_MEMHEAP_AS_HEAP */
+    if (host_memheap_find(ptr))
+    {
+        rt_memheap_free(ptr);
+        return;
+    }
+
+    free(ptr);
+}
+
+/* ==================== memory heap ==================== */
+
+/* the first fit memory heap, the free adjacent blocks are merged by the allocation */
+struct host_memheap_block
+{
+    rt_size_t size;                              /* Block size with the header */
+    rt_size_t used;
+    struct rt_memheap *heap;
+    rt_size_t reserved;
+};
+
+#define HOST_MEMHEAP_ALIGN   sizeof(struct host_memheap_block)
+
+static struct rt_memheap *host_memheap_list = RT_NULL;
+
+static struct rt_memheap *host_memheap_find(void *ptr)
+{
+    struct rt_memheap *heap = RT_NULL;
+
+    for (heap = host_memheap_list; heap; heap = heap->next)
+    {
+        if ((char *) ptr >= (char *) heap->start_addr && (char *) ptr < (char *) heap->start_addr + heap->pool_size)
+        {
+            return heap;
+        }
+    }
+
+    return RT_NULL;
+}
+
+rt_err_t rt_memheap_init(struct rt_memheap *memheap, const char *name, void *start_addr, rt_size_t size)
+{
+    struct host_memheap_block *block = RT_NULL;
+    rt_base_t level;
+
+    size = RT_ALIGN_DOWN(size, HOST_MEMHEAP_ALIGN);
+    if (size < 2 * HOST_MEMHEAP_ALIGN)
+    {
+        return -RT_ERROR;
+    }
+
+    host_object_init(&(memheap->parent), name);
+    memheap->start_addr = start_addr;
+    memheap->pool_size = size;
+    memheap->available_size = size;
+    memheap->max_used_size = 0;
+
+    block = (struct host_memheap_block *) start_addr;
+    block->size = size;
+    block->used = 0;
+    block->heap = memheap;
+
+    level = rt_hw_interrupt_disable();
+    memheap->next = host_memheap_list;
+    host_memheap_list = memheap;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
+{
+    struct host_memheap_block *block = RT_NULL, *next = RT_NULL;
+    char *end = (char *) heap->start_addr + heap->pool_size;
+    rt_base_t level;
+
+    size = RT_ALIGN(size, HOST_MEMHEAP_ALIGN) + HOST_MEMHEAP_ALIGN;
+
+    level = rt_hw_interrupt_disable();
+
+    for (block = (struct host_memheap_block *) heap->start_addr; (char *) block < end;
+            block = (struct host_memheap_block *) ((char *) block + block->size))
+    {
+        if (block->used)
+        {
+            continue;
+        }
+
+        /* merge the following free blocks */
+        next = (struct host_memheap_block *) ((char *) block + block->size);
+        while ((char *) next < end && next->used == 0)
+        {
+            block->size += next->size;
+            next = (struct host_memheap_block *) ((char *) block + block->size);
+        }
+
+        if (block->size < size)
+        {
+            continue;
+        }
+
+        /* split the rest of the block */
+        if (block->size - size >= 2 * HOST_MEMHEAP_ALIGN)
+        {
+            next = (struct host_memheap_block *) ((char *) block + size);
+            next->size = block->size - size;
+            next->used = 0;
+            next->heap = heap;
+            block->size = size;
+        }
+
+        block->used = 1;
+        heap->available_size -= block->size;
+        if (heap->pool_size - heap->available_size > heap->max_used_size)
+        {
+            heap->max_used_size = heap->pool_size - heap->available_size;
+        }
+
+        rt_hw_interrupt_enable(level);
+        return (char *) block + HOST_MEMHEAP_ALIGN;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_NULL;
+}
+
+void rt_memheap_free(void *ptr)
+{
+    struct host_memheap_block *block = RT_NULL;
+    rt_base_t level;
+
+    if (ptr == RT_NULL)
+    {
+        return;
+    }
+
+    block = (struct host_memheap_block *) ((char *) ptr - HOST_MEMHEAP_ALIGN);
+    RT_ASSERT(block->used);
+
+    level = rt_hw_interrupt_disable();
+    block->used = 0;
+    block->heap->available_size += block->size;
+    rt_hw_interrupt_enable(level);
+}
+
+/* ==================== tick ==================== */
+
+static rt_uint64_t host_time_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (rt_uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    static rt_uint64_t start_ms = 0;
+
+    if (start_ms == 0)
+    {
+        start_ms = host_time_ms();
+    }
+
+    return (rt_tick_t) (host_time_ms() - start_ms) * RT_TICK_PER_SECOND / 1000;
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    if (ms < 0)
+    {
+        return (rt_tick_t) RT_WAITING_FOREVER;
+    }
+
+    return (rt_tick_t) ((rt_uint64_t) ms * RT_TICK_PER_SECOND / 1000);
+}
+
+/* get the absolute time for the condition wait after the timeout ticks */
+static void host_abstime(struct timespec *ts, rt_int32_t timeout)
+{
+    rt_uint64_t ms = (rt_uint64_t) timeout * 1000 / RT_TICK_PER_SECOND;
+
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000;
+    if (ts->tv_nsec >= 1000000000)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+static void host_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* wait the condition, return -RT_ETIMEOUT when it's timeout */
+static rt_err_t host_cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock, const struct timespec *ts)
+{
+    if (ts == RT_NULL)
+    {
+        pthread_cond_wait(cond, lock);
+        return RT_EOK;
+    }
+
+    return (pthread_cond_timedwait(cond, lock, ts) == ETIMEDOUT) ? -RT_ETIMEOUT : RT_EOK;
+}
+
+static void host_object_init(struct rt_object *object, const char *name)
+{
+    rt_memset(object, 0x00, sizeof(struct rt_object));
+    if (name)
+    {
+        rt_strncpy(object->name, name, RT_NAME_MAX - 1);
+    }
+}
+
+/* ==================== critical section ==================== */
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    pthread_mutex_lock(&host_critical_lock);
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    pthread_mutex_unlock(&host_critical_lock);
+}
+
+void rt_enter_critical(void)
+{
+    pthread_mutex_lock(&host_critical_lock);
+}
+
+void rt_exit_critical(void)
+{
+    pthread_mutex_unlock(&host_critical_lock);
+}
+
+/* ==================== thread ==================== */
+
+static void *host_thread_entry(void *parameter)
+{
+    rt_thread_t thread = (rt_thread_t) parameter;
+
+    host_thread_self = thread;
+    thread->entry(thread->parameter);
+
+    /* the thread object is freed when the thread exits like the dynamic thread */
+    if ((thread->parent.type & RT_Object_Class_Static) == 0)
+    {
+        rt_free(thread);
+    }
+
+    return RT_NULL;
+}
+
+/* the stack is not used, the host thread runs on its own stack */
+rt_err_t rt_thread_init(struct rt_thread *thread, const char *name, void (*entry)(void *parameter),
+                        void *parameter, void *stack_start, rt_uint32_t stack_size, rt_uint8_t priority,
+                        rt_uint32_t tick)
+{
+    RT_ASSERT(thread);
+
+    host_object_init(&(thread->parent), name);
+    thread->parent.type = RT_Object_Class_Static;
+    thread->entry = entry;
+    thread->parameter = parameter;
+    thread->stack_size = stack_size;
+    thread->current_priority = priority;
+
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    rt_thread_t thread = (rt_thread_t) rt_calloc(1, sizeof(struct rt_thread));
+
+    if (thread == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    host_object_init(&(thread->parent), name);
+    thread->entry = entry;
+    thread->parameter = parameter;
+    thread->stack_size = stack_size;
+    thread->current_priority = priority;
+
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    pthread_attr_t attr;
+    int result;
+
+    RT_ASSERT(thread);
+
+    thread->init_tick = rt_tick_get();
+
+    /* the stack size of the target is too small for the host C library */
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    result = pthread_create(&(thread->tid), &attr, host_thread_entry, thread);
+    pthread_attr_destroy(&attr);
+
+    return (result == 0) ? RT_EOK : -RT_ERROR;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return host_thread_self ? host_thread_self : &host_main_thread;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    usleep((useconds_t) ((rt_uint64_t) tick * 1000000 / RT_TICK_PER_SECOND));
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+rt_err_t rt_thread_yield(void)
+{
+    sched_yield();
+    return RT_EOK;
+}
+
+/* ==================== semaphore ==================== */
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    host_object_init(&(sem->parent), name);
+    pthread_mutex_init(&(sem->lock), RT_NULL);
+    host_cond_init(&(sem->cond));
+    sem->value = value;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    pthread_cond_destroy(&(sem->cond));
+    pthread_mutex_destroy(&(sem->lock));
+
+    return RT_EOK;
+}
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    rt_sem_t sem = (rt_sem_t) rt_malloc(sizeof(struct rt_semaphore));
+
+    if (sem)
+    {
+        rt_sem_init(sem, name, value, flag);
+    }
+
+    return sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    rt_sem_detach(sem);
+    rt_free(sem);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
+{
+    struct timespec ts;
+    rt_err_t result = RT_EOK;
+
+    if (timeout >= 0)
+    {
+        host_abstime(&ts, timeout);
+    }
+
+    pthread_mutex_lock(&(sem->lock));
+    while (sem->value == 0 && result == RT_EOK)
+    {
+        result = (timeout == 0) ? -RT_ETIMEOUT :
+                 host_cond_wait(&(sem->cond), &(sem->lock), (timeout < 0) ? RT_NULL : &ts);
+    }
+    if (sem->value > 0)
+    {
+        sem->value--;
+        result = RT_EOK;
+    }
+    pthread_mutex_unlock(&(sem->lock));
+
+    return result;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+    return rt_sem_take(sem, 0);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    pthread_mutex_lock(&(sem->lock));
+    sem->value++;
+    pthread_cond_signal(&(sem->cond));
+    pthread_mutex_unlock(&(sem->lock));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
+{
+    if (cmd != RT_IPC_CMD_RESET)
+    {
+        return -RT_ERROR;
+    }
+
+    pthread_mutex_lock(&(sem->lock));
+    sem->value = (rt_uint32_t) (rt_ubase_t) arg;
+    pthread_mutex_unlock(&(sem->lock));
+
+    return RT_EOK;
+}
+
+/* ==================== mutex ==================== */
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    pthread_mutexattr_t attr;
+
+    host_object_init(&(mutex->parent), name);
+
+    /* the RT-Thread mutex can be taken recursively by the owner thread */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&(mutex->lock), &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex)
+{
+    pthread_mutex_destroy(&(mutex->lock));
+
+    return RT_EOK;
+}
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    rt_mutex_t mutex = (rt_mutex_t) rt_malloc(sizeof(struct rt_mutex));
+
+    if (mutex)
+    {
+        rt_mutex_init(mutex, name, flag);
+    }
+
+    return mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    rt_mutex_detach(mutex);
+    rt_free(mutex);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
+{
+    struct timespec ts;
+
+    if (timeout < 0)
+    {
+        pthread_mutex_lock(&(mutex->lock));
+        return RT_EOK;
+    }
+
+    if (timeout == 0)
+    {
+        return (pthread_mutex_trylock(&(mutex->lock)) == 0) ? RT_EOK : -RT_ETIMEOUT;
+    }
+
+    /* the timed lock only supports the realtime clock */
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout / RT_TICK_PER_SECOND;
+    ts.tv_nsec += (long) (timeout % RT_TICK_PER_SECOND) * (1000000000 / RT_TICK_PER_SECOND);
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    return (pthread_mutex_timedlock(&(mutex->lock), &ts) == 0) ? RT_EOK : -RT_ETIMEOUT;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    return (pthread_mutex_unlock(&(mutex->lock)) == 0) ? RT_EOK : -RT_ERROR;
+}
+
+/* ==================== event ==================== */
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+{
+    host_object_init(&(event->parent), name);
+    pthread_mutex_init(&(event->lock), RT_NULL);
+    host_cond_init(&(event->cond));
+    event->set = 0;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_detach(rt_event_t event)
+{
+    pthread_cond_destroy(&(event->cond));
+    pthread_mutex_destroy(&(event->lock));
+
+    return RT_EOK;
+}
+
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
+{
+    rt_event_t event = (rt_event_t) rt_malloc(sizeof(struct rt_event));
+
+    if (event)
+    {
+        rt_event_init(event, name, flag);
+    }
+
+    return event;
+}
+
+rt_err_t rt_event_delete(rt_event_t event)
+{
+    rt_event_detach(event);
+    rt_free(event);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    if (set == 0)
+    {
+        return -RT_ERROR;
+    }
+
+    pthread_mutex_lock(&(event->lock));
+    event->set |= set;
+    pthread_cond_broadcast(&(event->cond));
+    pthread_mutex_unlock(&(event->lock));
+
+    return RT_EOK;
+}
+
+static rt_bool_t host_event_match(rt_event_t event, rt_uint32_t set, rt_uint8_t option)
+{
+    if (option & RT_EVENT_FLAG_AND)
+    {
+        return ((event->set & set) == set) ? RT_TRUE : RT_FALSE;
+    }
+
+    return (event->set & set) ? RT_TRUE : RT_FALSE;
+}
+
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t option, rt_int32_t timeout,
+                       rt_uint32_t *recved)
+{
+    struct timespec ts;
+    rt_err_t result = RT_EOK;
+
+    if (set == 0)
+    {
+        return -RT_ERROR;
+    }
+
+    if (timeout > 0)
+    {
+        host_abstime(&ts, timeout);
+    }
+
+    pthread_mutex_lock(&(event->lock));
+
+    while (host_event_match(event, set, option) == RT_FALSE)
+    {
+        if (timeout == 0)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+
+        if (host_cond_wait(&(event->cond), &(event->lock), (timeout < 0) ? RT_NULL : &ts) != RT_EOK &&
+                host_event_match(event, set, option) == RT_FALSE)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+    }
+
+    if (result == RT_EOK)
+    {
+        if (recved)
+        {
+            *recved = event->set & set;
+        }
+
+        if (option & RT_EVENT_FLAG_CLEAR)
+        {
+            event->set &= ~set;
+        }
+    }
+
+    pthread_mutex_unlock(&(event->lock));
+
+    return result;
+}
+
+rt_err_t rt_event_control(rt_event_t event, int cmd, void *arg)
+{
+    if (cmd != RT_IPC_CMD_RESET)
+    {
+        return -RT_ERROR;
+    }
+
+    pthread_mutex_lock(&(event->lock));
+    event->set = 0;
+    pthread_mutex_unlock(&(event->lock));
+
+    return RT_EOK;
+}
+
+/* ==================== timer ==================== */
+
+/* all soft timers run in one timer thread, the active timers are in the list */
+static rt_list_t host_timer_list = RT_LIST_OBJECT_INIT(host_timer_list);
+static pthread_mutex_t host_timer_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_cond_t host_timer_cond;
+static rt_bool_t host_timer_started = RT_FALSE;
+
+static void *host_timer_entry(void *parameter)
+{
+    struct timespec ts;
+    rt_list_t *node = RT_NULL;
+    rt_timer_t timer = RT_NULL, next = RT_NULL;
+    void (*timeout_func)(void *parameter) = RT_NULL;
+    void *timeout_param = RT_NULL;
+
+    pthread_mutex_lock(&host_timer_lock);
+
+    while (1)
+    {
+        next = RT_NULL;
+        for (node = host_timer_list.next; node != &host_timer_list; node = node->next)
+        {
+            timer = rt_list_entry(node, struct rt_timer, list);
+            if (next == RT_NULL || (rt_int32_t) (timer->timeout_tick - next->timeout_tick) < 0)
+            {
+                next = timer;
+            }
+        }
+
+        if (next == RT_NULL)
+        {
+            pthread_cond_wait(&host_timer_cond, &host_timer_lock);
+            continue;
+        }
+
+        if ((rt_int32_t) (next->timeout_tick - rt_tick_get()) > 0)
+        {
+            host_abstime(&ts, (rt_int32_t) (next->timeout_tick - rt_tick_get()));
+            pthread_cond_timedwait(&host_timer_cond, &host_timer_lock, &ts);
+            continue;
+        }
+
+        /* the periodic timer is started again before the timeout function */
+        rt_list_remove(&(next->list));
+        if (next->parent.flag & RT_TIMER_FLAG_PERIODIC)
+        {
+            next->timeout_tick = rt_tick_get() + next->init_tick;
+            rt_list_insert_before(&host_timer_list, &(next->list));
+        }
+        else
+        {
+            next->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+
+        timeout_func = next->timeout_func;
+        timeout_param = next->parameter;
+        timeout_func(timeout_param);
+    }
+
+    return RT_NULL;
+}
+
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter),
+                   void *parameter, rt_tick_t time, rt_uint8_t flag)
+{
+    host_object_init(&(timer->parent), name);
+    timer->parent.flag = flag & ~RT_TIMER_FLAG_ACTIVATED;
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+    timer->timeout_tick = 0;
+    rt_list_init(&(timer->list));
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer)
+{
+    return rt_timer_stop(timer);
+}
+
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter), void *parameter,
+                           rt_tick_t time, rt_uint8_t flag)
+{
+    rt_timer_t timer = (rt_timer_t) rt_malloc(sizeof(struct rt_timer));
+
+    if (timer)
+    {
+        rt_timer_init(timer, name, timeout, parameter, time, flag);
+    }
+
+    return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer)
+{
+    rt_timer_stop(timer);
+    rt_free(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    pthread_t tid;
+
+    pthread_mutex_lock(&host_timer_lock);
+
+    if (host_timer_started == RT_FALSE)
+    {
+        host_cond_init(&host_timer_cond);
+        pthread_create(&tid, RT_NULL, host_timer_entry, RT_NULL);
+        pthread_detach(tid);
+        host_timer_started = RT_TRUE;
+    }
+
+    rt_list_remove(&(timer->list));
+    timer->timeout_tick = rt_tick_get() + timer->init_tick;
+    timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
+    rt_list_insert_before(&host_timer_list, &(timer->list));
+    pthread_cond_signal(&host_timer_cond);
+
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    pthread_mutex_lock(&host_timer_lock);
+
+    if ((timer->parent.flag & RT_TIMER_FLAG_ACTIVATED) == 0)
+    {
+        pthread_mutex_unlock(&host_timer_lock);
+        return -RT_ERROR;
+    }
+
+    rt_list_remove(&(timer->list));
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
+{
+    pthread_mutex_lock(&host_timer_lock);
+
+    switch (cmd)
+    {
+    case RT_TIMER_CTRL_SET_TIME:
+        timer->init_tick = *(rt_tick_t *) arg;
+        break;
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *) arg = timer->init_tick;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        timer->parent.flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        timer->parent.flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    default:
+        break;
+    }
+
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+/* ==================== work queue ==================== */
+
+static void host_work_entry(void *parameter)
+{
+    rt_thread_t thread = rt_thread_self();
+    struct rt_work *work = (struct rt_work *) parameter;
+
+    /* the delayed work sleeps in its own thread before the work function */
+    if (thread->user_data)
+    {
+        rt_thread_delay((rt_tick_t) (rt_ubase_t) thread->user_data);
+    }
+
+    work->work_func(work, work->work_data);
+}
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data)
+{
+    rt_list_init(&(work->list));
+    work->work_func = work_func;
+    work->work_data = work_data;
+}
+
+void rt_delayed_work_init(struct rt_delayed_work *work,
+                          void (*work_func)(struct rt_work *work, void *work_data), void *work_data)
+{
+    rt_work_init(&(work->work), work_func, work_data);
+}
+
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time)
+{
+    rt_thread_t tid;
+
+    /* the work function may block on the AT commands, run it in its own thread */
+    tid = rt_thread_create("work", host_work_entry, work, 0, RT_THREAD_PRIORITY_MAX / 2, 20);
+    if (tid == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    tid->user_data = (void *) (rt_ubase_t) time;
+
+    return rt_thread_startup(tid);
+}
+
+/* ==================== pin ==================== */
+
+static rt_uint8_t host_pins[HOST_PIN_MAX];
+
+void rt_pin_mode(rt_base_t pin, rt_base_t mode)
+{
+}
+
+void rt_pin_write(rt_base_t pin, rt_base_t value)
+{
+    if (pin >= 0 && pin < HOST_PIN_MAX)
+    {
+        host_pins[pin] = (rt_uint8_t) value;
+    }
+}
+
+int rt_pin_read(rt_base_t pin)
+{
+    return (pin >= 0 && pin < HOST_PIN_MAX) ? host_pins[pin] : PIN_LOW;
+}
+
+rt_err_t rt_pin_attach_irq(rt_int32_t pin, rt_uint32_t mode, void (*hdr)(void *args), void *args)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_pin_detach_irq(rt_int32_t pin)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint32_t enabled)
+{
+    return -RT_ENOSYS;
+}
+
+/* ==================== components initialization ==================== */
+
+struct host_init
+{
+    init_fn_t fn;
+    int level;
+    const char *name;
+};
+
+static struct host_init host_inits[HOST_INIT_MAX];
+static int host_init_num = 0;
+
+void rt_host_init_register(init_fn_t fn, int level, const char *name)
+{
+    if (host_init_num < HOST_INIT_MAX)
+    {
+        host_inits[host_init_num].fn = fn;
+        host_inits[host_init_num].level = level;
+        host_inits[host_init_num].name = name;
+        host_init_num++;
+    }
+}
+
+int rt_components_init(void)
+{
+    int level, i;
+
+    for (level = 1; level <= 6; level++)
+    {
+        for (i = 0; i < host_init_num; i++)
+        {
+            if (host_inits[i].level == level)
+            {
+                LOG_D("initialize %s", host_inits[i].name);
+                host_inits[i].fn();
+            }
+        }
+    }
+
+    return RT_EOK;
+}
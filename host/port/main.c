@@ -0,0 +1,620 @@
+/*
+ * File      : main.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The host program of the Linux host build, the AT devices are attached to a serial device
+ * (e.g. a pty of the modem emulator or a USB serial of the real module) or to a modem emulator
+ * started on a socketpair, then the msh commands are executed.
+ *
+ *   at_host -d esp8266='!python3 host/at_modem_emu.py --model esp8266' -c 'at_device stats'
+ *   at_host -d ec20=/dev/ttyUSB2 -t 60000
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include <at_device.h>
+#include <finsh.h>
+
+#ifdef AT_DEVICE_USING_ESP8266
+#include <at_device_esp8266.h>
+#endif
+#ifdef AT_DEVICE_USING_EC20
+#include <at_device_ec20.h>
+#endif
+#ifdef AT_DEVICE_USING_M26
+#include <at_device_m26.h>
+#endif
+#ifdef AT_DEVICE_USING_SIM800C
+#include <at_device_sim800c.h>
+#endif
+
+#define DBG_TAG              "host"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#define HOST_DEVICE_NUM_MAX  4
+#define HOST_CMD_NUM_MAX     16
+#define HOST_MSH_NUM_MAX     32
+#define HOST_MSH_ARG_MAX     16
+#define HOST_RECV_BUFF_LEN   512
+
+struct host_msh
+{
+    const char *name;
+    msh_cmd_t cmd;
+    const char *desc;
+};
+
+static struct host_msh host_msh_table[HOST_MSH_NUM_MAX];
+static int host_msh_num = 0;
+
+void rt_host_msh_register(const char *name, msh_cmd_t cmd, const char *desc)
+{
+    if (host_msh_num < HOST_MSH_NUM_MAX)
+    {
+        host_msh_table[host_msh_num].name = name;
+        host_msh_table[host_msh_num].cmd = cmd;
+        host_msh_table[host_msh_num].desc = desc;
+        host_msh_num++;
+    }
+}
+
+int msh_exec(char *cmd, rt_size_t length)
+{
+    char *argv[HOST_MSH_ARG_MAX];
+    char line[256];
+    int argc = 0, i;
+    char *ptr = RT_NULL;
+
+    rt_snprintf(line, sizeof(line), "%.*s", (int) length, cmd);
+
+    for (ptr = strtok(line, " \t\r\n"); ptr && argc < HOST_MSH_ARG_MAX; ptr = strtok(RT_NULL, " \t\r\n"))
+    {
+        argv[argc++] = ptr;
+    }
+
+    if (argc == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < host_msh_num; i++)
+    {
+        if (rt_strcmp(host_msh_table[i].name, argv[0]) == 0)
+        {
+            return host_msh_table[i].cmd(argc, argv);
+        }
+    }
+
+    rt_kprintf("%s: command not found.\n", argv[0]);
+
+    return -RT_ERROR;
+}
+
+static int help(int argc, char **argv)
+{
+    int i;
+
+    rt_kprintf("RT-Thread shell commands:\n");
+    for (i = 0; i < host_msh_num; i++)
+    {
+        rt_kprintf("%-16s - %s\n", host_msh_table[i].name, host_msh_table[i].desc);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(help, RT-Thread shell help);
+
+static int msleep(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        rt_kprintf("msleep <ms>\n");
+        return -RT_ERROR;
+    }
+
+    rt_thread_mdelay(atoi(argv[1]));
+
+    return 0;
+}
+MSH_CMD_EXPORT(msleep, delay in milliseconds);
+
+/* connect to the TCP server, send the message and print the response */
+static int tcp_test(int argc, char **argv)
+{
+    struct hostent *host = RT_NULL;
+    struct sockaddr_in addr;
+    struct timeval timeout = { 5, 0 };
+    char buff[HOST_RECV_BUFF_LEN];
+    int sock = -1, len = 0;
+
+    if (argc != 4)
+    {
+        rt_kprintf("tcp_test <host> <port> <message>\n");
+        return -RT_ERROR;
+    }
+
+    host = at_gethostbyname(argv[1]);
+    if (host == RT_NULL)
+    {
+        rt_kprintf("resolve %s failed.\n", argv[1]);
+        return -RT_ERROR;
+    }
+
+    rt_memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(atoi(argv[2]));
+    rt_memcpy(&(addr.sin_addr), host->h_addr_list[0], sizeof(addr.sin_addr));
+
+    sock = at_socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        rt_kprintf("create socket failed.\n");
+        return -RT_ERROR;
+    }
+
+    at_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (at_connect(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+            at_send(sock, argv[3], rt_strlen(argv[3]), 0) < 0)
+    {
+        rt_kprintf("connect or send to %s:%s failed.\n", argv[1], argv[2]);
+        at_closesocket(sock);
+        return -RT_ERROR;
+    }
+
+    len = at_recv(sock, buff, sizeof(buff) - 1, 0);
+    if (len > 0)
+    {
+        buff[len] = '\0';
+        rt_kprintf("recv(%d): %s\n", len, buff);
+    }
+    else
+    {
+        rt_kprintf("recv failed(%d).\n", len);
+    }
+
+    at_closesocket(sock);
+
+    return (len > 0) ? 0 : -RT_ERROR;
+}
+MSH_CMD_EXPORT(tcp_test, connect TCP server and send the message);
+
+static int udp_test(int argc, char **argv)
+{
+    struct hostent *host = RT_NULL;
+    struct sockaddr_in addr, from;
+    struct timeval timeout = { 5, 0 };
+    socklen_t fromlen;
+    char buff[HOST_RECV_BUFF_LEN];
+    int sock = -1, len = 0, idx;
+
+    if (argc < 4 || argc % 2 != 0)
+    {
+        rt_kprintf("udp_test <message> <host> <port> [<host> <port> ...]\n");
+        return -RT_ERROR;
+    }
+
+    sock = at_socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        rt_kprintf("create socket failed.\n");
+        return -RT_ERROR;
+    }
+
+    at_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (at_device_udp_open(sock, 0) < 0)
+    {
+        rt_kprintf("open unconnected UDP socket failed.\n");
+        at_closesocket(sock);
+        return -RT_ERROR;
+    }
+
+    /* the message is sent to every peer by the same socket, one reply is received from each */
+    for (idx = 2; idx < argc; idx += 2)
+    {
+        host = at_gethostbyname(argv[idx]);
+        if (host == RT_NULL)
+        {
+            rt_kprintf("resolve %s failed.\n", argv[idx]);
+            len = -1;
+            break;
+        }
+
+        rt_memset(&addr, 0x00, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(atoi(argv[idx + 1]));
+        rt_memcpy(&(addr.sin_addr), host->h_addr_list[0], sizeof(addr.sin_addr));
+
+        if (at_device_udp_sendto(sock, argv[1], rt_strlen(argv[1]), (struct sockaddr *) &addr, sizeof(addr)) < 0)
+        {
+            rt_kprintf("send to %s:%s failed.\n", argv[idx], argv[idx + 1]);
+            len = -1;
+            break;
+        }
+
+        fromlen = sizeof(from);
+        len = at_device_udp_recvfrom(sock, buff, sizeof(buff) - 1, (struct sockaddr *) &from, &fromlen);
+        if (len <= 0)
+        {
+            rt_kprintf("recv failed(%d).\n", len);
+            break;
+        }
+
+        buff[len] = '\0';
+        rt_kprintf("recv(%d) from %s:%d: %s\n", len, inet_ntoa(from.sin_addr), ntohs(from.sin_port), buff);
+    }
+
+    at_closesocket(sock);
+
+    return (len > 0) ? 0 : -RT_ERROR;
+}
+MSH_CMD_EXPORT(udp_test, send the message to the UDP peers by one unconnected socket);
+
+/* open the serial device in the raw mode */
+static int host_serial_open(const char *path)
+{
+    struct termios tio;
+    int fd;
+
+    fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        LOG_E("open serial device(%s) failed(%s).", path, strerror(errno));
+        return -1;
+    }
+
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+/* start the modem emulator command on one end of a socketpair, it works on stdin and stdout */
+static int host_emulator_start(const char *cmd)
+{
+    int fds[2];
+    pid_t pid;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+    {
+        LOG_E("create socketpair failed(%s).", strerror(errno));
+        return -1;
+    }
+
+    pid = fork();
+    if (pid < 0)
+    {
+        LOG_E("start modem emulator failed(%s).", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+
+    if (pid == 0)
+    {
+        dup2(fds[1], STDIN_FILENO);
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execl("/bin/sh", "sh", "-c", cmd, (char *) RT_NULL);
+        _exit(127);
+    }
+
+    close(fds[1]);
+
+    return fds[0];
+}
+
+/* register the AT device of the model on the AT client */
+static int host_device_register(const char *model, int index, const char *client_name, int socket_num)
+{
+    char *device_name = (char *) rt_calloc(1, RT_NAME_MAX);
+
+    if (device_name == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+#ifdef AT_DEVICE_USING_ESP8266
+    if (rt_strcmp(model, "esp8266") == 0)
+    {
+        struct at_device_esp8266 *esp8266 = rt_calloc(1, sizeof(struct at_device_esp8266));
+
+        rt_snprintf(device_name, RT_NAME_MAX, "esp%d", index);
+        esp8266->device_name = device_name;
+        esp8266->client_name = (char *) client_name;
+        esp8266->wifi_ssid = "host-ssid";
+        esp8266->wifi_password = "host-password";
+        esp8266->recv_line_num = HOST_RECV_BUFF_LEN;
+        esp8266->device.socket_num = socket_num;
+#ifdef AT_DEVICE_USING_STATIC
+        AT_DEVICE_STATIC_BIND(esp8266);
+#endif
+
+        return at_device_register(&(esp8266->device), esp8266->device_name, esp8266->client_name,
+                                  AT_DEVICE_CLASS_ESP8266, (void *) esp8266);
+    }
+#endif /* AT_DEVICE_USING_ESP8266 */
+
+#ifdef AT_DEVICE_USING_EC20
+    if (rt_strcmp(model, "ec20") == 0)
+    {
+        struct at_device_ec20 *ec20 = rt_calloc(1, sizeof(struct at_device_ec20));
+
+        rt_snprintf(device_name, RT_NAME_MAX, "e%d", index);
+        ec20->device_name = device_name;
+        ec20->client_name = (char *) client_name;
+        ec20->power_pin = -1;
+        ec20->power_status_pin = -1;
+        ec20->recv_line_num = HOST_RECV_BUFF_LEN;
+        ec20->wakeup_pin = -1;
+        ec20->device.socket_num = socket_num;
+#ifdef AT_DEVICE_USING_STATIC
+        AT_DEVICE_STATIC_BIND(ec20);
+#endif
+
+        return at_device_register(&(ec20->device), ec20->device_name, ec20->client_name,
+                                  AT_DEVICE_CLASS_EC20, (void *) ec20);
+    }
+#endif /* AT_DEVICE_USING_EC20 */
+
+#ifdef AT_DEVICE_USING_M26
+    if (rt_strcmp(model, "m26") == 0)
+    {
+        struct at_device_m26 *m26 = rt_calloc(1, sizeof(struct at_device_m26));
+
+        rt_snprintf(device_name, RT_NAME_MAX, "m%d", index);
+        m26->device_name = device_name;
+        m26->client_name = (char *) client_name;
+        m26->power_pin = -1;
+        m26->power_status_pin = -1;
+        m26->recv_line_num = HOST_RECV_BUFF_LEN;
+        m26->device.socket_num = socket_num;
+#ifdef AT_DEVICE_USING_STATIC
+        AT_DEVICE_STATIC_BIND(m26);
+#endif
+
+        return at_device_register(&(m26->device), m26->device_name, m26->client_name,
+                                  AT_DEVICE_CLASS_M26_MC20, (void *) m26);
+    }
+#endif /* AT_DEVICE_USING_M26 */
+
+#ifdef AT_DEVICE_USING_SIM800C
+    if (rt_strcmp(model, "sim800c") == 0)
+    {
+        struct at_device_sim800c *sim800c = rt_calloc(1, sizeof(struct at_device_sim800c));
+
+        rt_snprintf(device_name, RT_NAME_MAX, "s%d", index);
+        sim800c->device_name = device_name;
+        sim800c->client_name = (char *) client_name;
+        sim800c->power_pin = -1;
+        sim800c->power_status_pin = -1;
+        sim800c->recv_line_num = HOST_RECV_BUFF_LEN;
+        sim800c->device.socket_num = socket_num;
+#ifdef AT_DEVICE_USING_STATIC
+        AT_DEVICE_STATIC_BIND(sim800c);
+#endif
+
+        return at_device_register(&(sim800c->device), sim800c->device_name, sim800c->client_name,
+                                  AT_DEVICE_CLASS_SIM800C, (void *) sim800c);
+    }
+#endif /* AT_DEVICE_USING_SIM800C */
+
+    LOG_E("not supported AT device model(%s).", model);
+    rt_free(device_name);
+
+    return -RT_ERROR;
+}
+
+/* wait the network of all AT devices ready in the timeout */
+static int host_device_wait_ready(char client_name[][RT_NAME_MAX], int device_num, int timeout)
+{
+    rt_tick_t deadline = rt_tick_get() + rt_tick_from_millisecond(timeout);
+    rt_int32_t left;
+    struct at_device *device = RT_NULL;
+    int idx;
+
+    for (idx = 0; idx < device_num; idx++)
+    {
+        /* the AT client of the device is got when its initialization starts */
+        while ((device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name[idx])) == RT_NULL &&
+                (rt_int32_t) (deadline - rt_tick_get()) > 0)
+        {
+            rt_thread_mdelay(10);
+        }
+        left = (rt_int32_t) (deadline - rt_tick_get());
+        if (device == RT_NULL || at_device_wait_ready(device, (left > 0) ? left : 0) < 0)
+        {
+            return -RT_ETIMEOUT;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static void usage(const char *name)
+{
+    rt_kprintf("Usage: %s [options]\n"
+               "  -d model=serial   attach the AT device model (esp8266, ec20, m26, sim800c) to the serial device path,\n"
+               "                    the serial starting with '!' is the modem emulator command line\n"
+               "  -t ms             wait all AT devices network ready before the commands\n"
+               "  -p policy         socket placement policy on the AT devices, first, least or signal\n"
+               "  -s sockets        sockets number used on each AT device, default the module maximum\n"
+               "  -c command        execute the msh command, it can be used several times\n"
+               "  -C directory      store the AT device cache files in the directory (AT_DEVICE_CACHE_USING_FILE)\n"
+               "  -v level          log level, 0: error, 1: warning, 2: info, 3: debug\n"
+               "The msh commands are read from the standard input without the -c option.\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    char *models[HOST_DEVICE_NUM_MAX];
+    char *cmds[HOST_CMD_NUM_MAX];
+    char client_name[HOST_DEVICE_NUM_MAX][RT_NAME_MAX];
+    char line[256];
+    char *serial = RT_NULL;
+    int model_num = 0, cmd_num = 0, ready_timeout = 0, socket_num = 0;
+    int opt, idx, fd, result = 0;
+#ifdef AT_DEVICE_CACHE_USING_FILE
+    char *cache_path = RT_NULL;
+#endif
+
+    /* the emulator exits when the host closes the socketpair, don't die on its broken pipe */
+    signal(SIGPIPE, SIG_IGN);
+
+    while ((opt = getopt(argc, argv, "d:t:p:s:c:C:v:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+            if (model_num < HOST_DEVICE_NUM_MAX && rt_strstr(optarg, "="))
+            {
+                models[model_num++] = optarg;
+                break;
+            }
+            usage(argv[0]);
+            return 1;
+        case 't':
+            ready_timeout = atoi(optarg);
+            break;
+        case 'p':
+            if (rt_strcmp(optarg, "first") == 0)
+            {
+                at_device_set_placement(AT_DEVICE_PLACEMENT_FIRST);
+                break;
+            }
+            else if (rt_strcmp(optarg, "least") == 0)
+            {
+                at_device_set_placement(AT_DEVICE_PLACEMENT_LEAST_LOADED);
+                break;
+            }
+            else if (rt_strcmp(optarg, "signal") == 0)
+            {
+                at_device_set_placement(AT_DEVICE_PLACEMENT_BEST_SIGNAL);
+                break;
+            }
+            usage(argv[0]);
+            return 1;
+        case 's':
+            socket_num = atoi(optarg);
+            break;
+        case 'c':
+            if (cmd_num < HOST_CMD_NUM_MAX)
+            {
+                cmds[cmd_num++] = optarg;
+            }
+            break;
+        case 'C':
+#ifdef AT_DEVICE_CACHE_USING_FILE
+            cache_path = optarg;
+            break;
+#else
+            LOG_E("the cache files need AT_DEVICE_USING_CACHE and AT_DEVICE_CACHE_USING_FILE.");
+            return 1;
+#endif
+        case 'v':
+            rt_host_log_level = atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    /* the serial devices are bound before the AT device classes initialize the AT clients */
+    for (idx = 0; idx < model_num; idx++)
+    {
+        serial = rt_strstr(models[idx], "=");
+        *serial++ = '\0';
+
+        fd = (serial[0] == '!') ? host_emulator_start(serial + 1) : host_serial_open(serial);
+        if (fd < 0)
+        {
+            return 1;
+        }
+
+        rt_snprintf(client_name[idx], RT_NAME_MAX, "uart%d", idx + 1);
+        rt_host_serial_bind(client_name[idx], fd);
+    }
+
+    rt_components_init();
+
+#ifdef AT_DEVICE_CACHE_USING_FILE
+    /* the cached module information is used by the device initialization */
+    if (cache_path && at_device_cache_file_init(cache_path) < 0)
+    {
+        return 1;
+    }
+#endif
+
+    for (idx = 0; idx < model_num; idx++)
+    {
+        if (host_device_register(models[idx], idx, client_name[idx], socket_num) < 0)
+        {
+            return 1;
+        }
+    }
+
+    if (ready_timeout > 0 && host_device_wait_ready(client_name, model_num, ready_timeout) < 0)
+    {
+        LOG_E("wait AT device network ready timeout(%d ms).", ready_timeout);
+        return 2;
+    }
+
+    if (cmd_num > 0)
+    {
+        for (idx = 0; idx < cmd_num; idx++)
+        {
+            if (msh_exec(cmds[idx], rt_strlen(cmds[idx])) < 0)
+            {
+                result = 3;
+            }
+        }
+
+        return result;
+    }
+
+    rt_kprintf("msh >");
+    while (fgets(line, sizeof(line), stdin))
+    {
+        msh_exec(line, rt_strlen(line));
+        rt_kprintf("msh >");
+    }
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+/*
+ * File      : netdev.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The network interface device of the Linux host build, it keeps the device list, the default
+ * device and the address information set by the AT device classes.
+ */
+
+#include <stdlib.h>
+
+#include <netdev.h>
+
+#define DBG_TAG              "netdev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+struct netdev *netdev_list = RT_NULL;
+struct netdev *netdev_default = RT_NULL;
+
+int netdev_register(struct netdev *netdev, const char *name, void *user_data)
+{
+    rt_base_t level;
+    uint16_t flags_mask;
+    int index;
+
+    RT_ASSERT(netdev);
+    RT_ASSERT(name);
+
+    /* clean network interface device */
+    flags_mask = NETDEV_FLAG_UP | NETDEV_FLAG_LINK_UP | NETDEV_FLAG_INTERNET_UP | NETDEV_FLAG_DHCP;
+    netdev->flags &= ~flags_mask;
+
+    rt_memset(&(netdev->ip_addr), 0x00, sizeof(ip_addr_t));
+    rt_memset(&(netdev->netmask), 0x00, sizeof(ip_addr_t));
+    rt_memset(&(netdev->gw), 0x00, sizeof(ip_addr_t));
+    for (index = 0; index < NETDEV_DNS_SERVERS_NUM; index++)
+    {
+        rt_memset(&(netdev->dns_servers[index]), 0x00, sizeof(ip_addr_t));
+    }
+    netdev->status_callback = RT_NULL;
+    netdev->addr_callback = RT_NULL;
+
+    rt_strncpy(netdev->name, name, RT_NAME_MAX - 1);
+    netdev->user_data = user_data;
+
+    /* initialize current network interface device single list */
+    rt_slist_init(&(netdev->list));
+
+    level = rt_hw_interrupt_disable();
+
+    if (netdev_list == RT_NULL)
+    {
+        netdev_list = netdev;
+        netdev_default = netdev;
+    }
+    else
+    {
+        /* tail insertion */
+        rt_slist_append(&(netdev_list->list), &(netdev->list));
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+int netdev_unregister(struct netdev *netdev)
+{
+    rt_base_t level;
+
+    RT_ASSERT(netdev);
+
+    if (netdev_list == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    if (netdev_list == netdev)
+    {
+        netdev_list = (netdev->list.next) ? rt_slist_entry(netdev->list.next, struct netdev, list) : RT_NULL;
+    }
+    else
+    {
+        rt_slist_remove(&(netdev_list->list), &(netdev->list));
+    }
+
+    if (netdev_default == netdev)
+    {
+        netdev_default = netdev_list;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+struct netdev *netdev_get_first_by_flags(uint16_t flags)
+{
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+
+    if (netdev_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    if (netdev_list->flags & flags)
+    {
+        return netdev_list;
+    }
+
+    rt_slist_for_each(node, &(netdev_list->list))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        if (netdev && (netdev->flags & flags) == flags)
+        {
+            return netdev;
+        }
+    }
+
+    return RT_NULL;
+}
+
+struct netdev *netdev_get_by_ipaddr(ip_addr_t *ip_addr)
+{
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+
+    if (netdev_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    if (ip_addr_cmp(&(netdev_list->ip_addr), ip_addr))
+    {
+        return netdev_list;
+    }
+
+    rt_slist_for_each(node, &(netdev_list->list))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        if (netdev && ip_addr_cmp(&(netdev->ip_addr), ip_addr))
+        {
+            return netdev;
+        }
+    }
+
+    return RT_NULL;
+}
+
+struct netdev *netdev_get_by_name(const char *name)
+{
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+
+    if (netdev_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    if (rt_strncmp(netdev_list->name, name, RT_NAME_MAX) == 0)
+    {
+        return netdev_list;
+    }
+
+    rt_slist_for_each(node, &(netdev_list->list))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        if (netdev && rt_strncmp(netdev->name, name, RT_NAME_MAX) == 0)
+        {
+            return netdev;
+        }
+    }
+
+    return RT_NULL;
+}
+
+void netdev_set_default(struct netdev *netdev)
+{
+    if (netdev)
+    {
+        netdev_default = netdev;
+        LOG_D("Setting default network interface device name(%s) successfully.", netdev->name);
+    }
+}
+
+void netdev_set_status_callback(struct netdev *netdev, netdev_callback_fn status_callback)
+{
+    RT_ASSERT(netdev);
+
+    netdev->status_callback = status_callback;
+}
+
+void netdev_set_addr_callback(struct netdev *netdev, netdev_callback_fn addr_callback)
+{
+    RT_ASSERT(netdev);
+
+    netdev->addr_callback = addr_callback;
+}
+
+void netdev_low_level_set_ipaddr(struct netdev *netdev, const ip_addr_t *ip_addr)
+{
+    if (netdev && ip_addr && !ip_addr_cmp(&(netdev->ip_addr), ip_addr))
+    {
+        netdev->ip_addr = *ip_addr;
+
+        if (netdev->addr_callback)
+        {
+            netdev->addr_callback(netdev, NETDEV_CB_ADDR_IP);
+        }
+    }
+}
+
+void netdev_low_level_set_netmask(struct netdev *netdev, const ip_addr_t *netmask)
+{
+    if (netdev && netmask && !ip_addr_cmp(&(netdev->netmask), netmask))
+    {
+        netdev->netmask = *netmask;
+
+        if (netdev->addr_callback)
+        {
+            netdev->addr_callback(netdev, NETDEV_CB_ADDR_NETMASK);
+        }
+    }
+}
+
+void netdev_low_level_set_gw(struct netdev *netdev, const ip_addr_t *gw)
+{
+    if (netdev && gw && !ip_addr_cmp(&(netdev->gw), gw))
+    {
+        netdev->gw = *gw;
+
+        if (netdev->addr_callback)
+        {
+            netdev->addr_callback(netdev, NETDEV_CB_ADDR_GATEWAY);
+        }
+    }
+}
+
+void netdev_low_level_set_dns_server(struct netdev *netdev, uint8_t dns_num, const ip_addr_t *dns_server)
+{
+    if (netdev && dns_server && dns_num < NETDEV_DNS_SERVERS_NUM &&
+            !ip_addr_cmp(&(netdev->dns_servers[dns_num]), dns_server))
+    {
+        netdev->dns_servers[dns_num] = *dns_server;
+
+        if (netdev->addr_callback)
+        {
+            netdev->addr_callback(netdev, NETDEV_CB_ADDR_DNS_SERVER);
+        }
+    }
+}
+
+/* update the status flag and call the status change callback when it's changed */
+static void netdev_low_level_set_flag(struct netdev *netdev, uint16_t flag, rt_bool_t is_set,
+                                      enum netdev_cb_type set_type, enum netdev_cb_type clear_type)
+{
+    if (netdev == RT_NULL || ((netdev->flags & flag) ? RT_TRUE : RT_FALSE) == (is_set ? RT_TRUE : RT_FALSE))
+    {
+        return;
+    }
+
+    if (is_set)
+    {
+        netdev->flags |= flag;
+    }
+    else
+    {
+        netdev->flags &= ~flag;
+    }
+
+    if (netdev->status_callback)
+    {
+        netdev->status_callback(netdev, is_set ? set_type : clear_type);
+    }
+}
+
+void netdev_low_level_set_status(struct netdev *netdev, rt_bool_t is_up)
+{
+    netdev_low_level_set_flag(netdev, NETDEV_FLAG_UP, is_up, NETDEV_CB_STATUS_UP, NETDEV_CB_STATUS_DOWN);
+}
+
+void netdev_low_level_set_link_status(struct netdev *netdev, rt_bool_t is_up)
+{
+    netdev_low_level_set_flag(netdev, NETDEV_FLAG_LINK_UP, is_up,
+                              NETDEV_CB_STATUS_LINK_UP, NETDEV_CB_STATUS_LINK_DOWN);
+
+    /* the AT device has the internet connection when the link is up */
+    netdev_low_level_set_flag(netdev, NETDEV_FLAG_INTERNET_UP, is_up,
+                              NETDEV_CB_STATUS_INTERNET_UP, NETDEV_CB_STATUS_INTERNET_DOWN);
+}
+
+void netdev_low_level_set_dhcp_status(struct netdev *netdev, rt_bool_t is_enable)
+{
+    netdev_low_level_set_flag(netdev, NETDEV_FLAG_DHCP, is_enable,
+                              NETDEV_CB_STATUS_DHCP_ENABLE, NETDEV_CB_STATUS_DHCP_DISABLE);
+}
+
+int netdev_ipaddr_aton(const char *cp, ip_addr_t *addr)
+{
+    unsigned int a, b, c, d;
+    char end;
+
+    if (sscanf(cp, "%u.%u.%u.%u%c", &a, &b, &c, &d, &end) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+    {
+        return 0;
+    }
+
+    if (addr)
+    {
+        addr->addr = htonl((a << 24) | (b << 16) | (c << 8) | d);
+    }
+
+    return 1;
+}
+
+char *netdev_ipaddr_ntoa(const ip_addr_t *addr)
+{
+    static char str[16];
+    uint32_t ip = ntohl(addr->addr);
+
+    rt_snprintf(str, sizeof(str), "%u.%u.%u.%u",
+                (ip >> 24) & 0xFF, (ip >> 16) & 0xFF, (ip >> 8) & 0xFF, ip & 0xFF);
+
+    return str;
+}
+
+/* the SAL protocol family information is not used by the host build */
+int sal_at_netdev_set_pf_info(struct netdev *netdev)
+{
+    RT_ASSERT(netdev);
+
+    return 0;
+}
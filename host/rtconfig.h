@@ -0,0 +1,57 @@
+/*
+ * File      : rtconfig.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * The configuration of the Linux host build, the AT device classes are selected by the
+ * Makefile (AT_DEVICE_USING_XXX), the optional features can be added by CFLAGS.
+ */
+
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX                    16
+#define RT_TICK_PER_SECOND             1000
+#define RT_THREAD_PRIORITY_MAX         32
+#define RT_ALIGN_SIZE                  8
+
+#define RT_USING_PIN
+#define RT_USING_NETDEV
+#define RT_USING_FINSH
+#define FINSH_USING_MSH
+/* the DFS file API is the host one, see include/dfs_posix.h */
+#define RT_USING_DFS
+
+#define RT_USING_SAL
+#define SAL_USING_AT
+#define AT_USING_CLIENT
+#define AT_USING_SOCKET
+#define AT_CMD_MAX_LEN                 128
+
+#define PKG_USING_AT_DEVICE
+
+/* the device initialization runs in the background like a real target */
+#define AT_DEVICE_ESP8266_INIT_ASYN
+#define AT_DEVICE_EC20_INIT_ASYN
+
+#endif /* RT_CONFIG_H__ */
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# File      : test_cache.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+# Test of the AT device persistent cache (AT_DEVICE_USING_CACHE) with the file backend. The
+# host program is built with the cache and boots the emulated EC20 several times on the same
+# cache directory, the commands received by the emulator show the cache miss, hit, identity
+# change and invalid identity.
+#
+#   python3 test_cache.py
+#   python3 test_cache.py --host build_cache/at_host     use the built host program
+#
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+EMULATOR = os.path.join(HERE, 'at_modem_emu.py')
+CACHE_FLAGS = '-DAT_DEVICE_USING_CACHE -DAT_DEVICE_CACHE_USING_FILE'
+
+# the IMEI of the emulated EC20 and the one of another module
+IMEI = '866123456789012'
+OTHER_IMEI = '866000000000099'
+
+
+def build(path):
+    subprocess.check_call(['make', '-C', HERE, '-s', 'CLASSES=ec20', 'BUILD=' + path,
+                           'CFLAGS_EXTRA=' + CACHE_FLAGS])
+    return os.path.join(path, 'at_host')
+
+
+def boot(host, work, cache_dir, rules=()):
+    """Boot the emulated EC20 once, return the received command lines and the cache file."""
+    script = os.path.join(work, 'rules.txt')
+    log = os.path.join(work, 'commands.txt')
+    with open(script, 'w') as f:
+        f.writelines(rule + '\n' for rule in rules)
+    if os.path.exists(log):
+        os.remove(log)
+
+    emulator = '!%s %s --model ec20 --script %s --log %s' % (sys.executable, EMULATOR, script, log)
+    proc = subprocess.run([host, '-d', 'ec20=' + emulator, '-C', cache_dir, '-t', '20000',
+                           '-v', '0', '-c', 'msleep 1'],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=60,
+                          universal_newlines=True)
+    if proc.returncode != 0:
+        sys.exit('host program exit %d\n%s' % (proc.returncode, proc.stdout))
+
+    with open(log) as f:
+        commands = f.read().splitlines()
+    cache_file = os.path.join(cache_dir, 'e0.cache')
+    cache = ''
+    if os.path.exists(cache_file):
+        with open(cache_file) as f:
+            cache = f.read()
+    return commands, cache
+
+
+def check(name, condition, failures):
+    print('%s %s' % ('PASS' if condition else 'FAIL', name))
+    if not condition:
+        failures.append(name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AT device persistent cache test')
+    parser.add_argument('--host', help='host program built with the cache, default built in a temporary directory')
+    args = parser.parse_args()
+
+    failures = []
+    with tempfile.TemporaryDirectory() as work:
+        host = args.host or build(os.path.join(work, 'build'))
+        cache_dir = os.path.join(work, 'cache')
+        os.mkdir(cache_dir)
+
+        # the first boot reads the operator and caches it with the IMEI
+        commands, cache = boot(host, work, cache_dir)
+        check('miss: operator queried', commands.count('AT+COPS?') == 1, failures)
+        check('miss: IMEI read once', commands.count('AT+GSN') == 1, failures)
+        check('miss: identity and IMEI cached', ('identity=' in cache and 'imei=%s' % IMEI in cache), failures)
+
+        # the same module, firmware and SIM card use the cached values
+        commands, cache = boot(host, work, cache_dir)
+        check('hit: operator not queried', 'AT+COPS?' not in commands, failures)
+        check('hit: IMEI read once for the identity', commands.count('AT+GSN') == 1, failures)
+
+        # another module with the same SIM card and firmware invalidates the cache
+        commands, cache = boot(host, work, cache_dir,
+                               [r'AT\+GSN => \r\n%s\r\n\r\nOK\r\n' % OTHER_IMEI])
+        check('identity change: operator queried', commands.count('AT+COPS?') == 1, failures)
+        check('identity change: new IMEI cached', 'imei=%s' % OTHER_IMEI in cache and IMEI not in cache,
+              failures)
+
+        # the identity with an empty field (no ICCID) isn't used and the cache is erased
+        commands, cache = boot(host, work, cache_dir, [r'AT\+QCCID => \r\nOK\r\n'])
+        check('invalid identity: operator queried', commands.count('AT+COPS?') == 1, failures)
+        check('invalid identity: identity not cached', 'identity=' not in cache, failures)
+
+        mode = os.stat(os.path.join(cache_dir, 'e0.cache')).st_mode & 0o777
+        check('cache file mode 0644', mode == 0o644 & ~current_umask(), failures)
+
+    sys.exit(1 if failures else 0)
+
+
+def current_umask():
+    mask = os.umask(0)
+    os.umask(mask)
+    return mask
+
+
+if __name__ == '__main__':
+    main()
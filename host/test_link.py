@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# File      : test_link.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+# Test of the socket placement on the AT device link loss. The host program boots two emulated
+# EC20 with the first device placement policy, the sockets are allocated on the default network
+# interface device as the AT socket component does. The PDP context of the first EC20 is
+# deactivated and can't be activated again, the new sockets are placed on the second EC20.
+#
+#   python3 test_link.py
+#   python3 test_link.py --host build/at_host     use the built host program
+#
+
+import argparse
+import json
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+EMULATOR = os.path.join(HERE, 'at_modem_emu.py')
+
+# the context is deactivated after the device is ready, and the reactivation is never answered
+LINK_LOSS_RULES = [
+    r'@2500 AT\+QIACT=1 => !drop',
+    r'@3000 \r\n+QIURC: "pdpdeact",1\r\n',
+]
+
+
+def build(path):
+    subprocess.check_call(['make', '-C', HERE, '-s', 'CLASSES=ec20', 'BUILD=' + path])
+    return os.path.join(path, 'at_host')
+
+
+def serve(server):
+    """Accept the connections and read until they are closed."""
+    while True:
+        conn, _ = server.accept()
+        threading.Thread(target=lambda c: (c.recv(1024), c.close()), args=(conn,), daemon=True).start()
+
+
+def run(host, work, port):
+    """Connect once before and after the link loss, return the AT device of every connection."""
+    script = os.path.join(work, 'rules.txt')
+    with open(script, 'w') as f:
+        f.writelines(rule + '\n' for rule in LINK_LOSS_RULES)
+
+    lossy = '!%s %s --model ec20 --script %s' % (sys.executable, EMULATOR, script)
+    normal = '!%s %s --model ec20' % (sys.executable, EMULATOR)
+    connect = 'at_bench connect 127.0.0.1 %d -n 1' % port
+    proc = subprocess.run([host, '-d', 'ec20=' + lossy, '-d', 'ec20=' + normal, '-p', 'first',
+                           '-t', '20000', '-v', '0', '-c', connect, '-c', 'msleep 3500', '-c', connect],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=60,
+                          universal_newlines=True)
+    if proc.returncode != 0:
+        sys.exit('host program exit %d\n%s' % (proc.returncode, proc.stdout))
+
+    results = [json.loads(line[len('BENCH '):]) for line in proc.stdout.splitlines() if line.startswith('BENCH ')]
+    return [(result['device'], result['failed']) for result in results]
+
+
+def check(name, condition, failures):
+    print('%s %s' % ('PASS' if condition else 'FAIL', name))
+    if not condition:
+        failures.append(name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AT device link loss placement test')
+    parser.add_argument('--host', help='host program, default built in a temporary directory')
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.bind(('127.0.0.1', 0))
+    server.listen(8)
+    threading.Thread(target=serve, args=(server,), daemon=True).start()
+
+    failures = []
+    with tempfile.TemporaryDirectory() as work:
+        host = args.host or build(os.path.join(work, 'build'))
+        results = run(host, work, server.getsockname()[1])
+
+    check('two connections', len(results) == 2, failures)
+    if len(results) == 2:
+        check('link up: socket placed on the first device', results[0] == ('e0', 0), failures)
+        check('link down: socket placed on the second device', results[1] == ('e1', 0), failures)
+
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -64,6 +64,89 @@ extern "C" {
 #define AT_DEVICE_CTRL_GET_SIGNAL      0x0AL
 #define AT_DEVICE_CTRL_GET_GPS         0x0BL
 #define AT_DEVICE_CTRL_GET_VER         0x0CL
+#define AT_DEVICE_CTRL_GET_STATS       0x0DL
+#define AT_DEVICE_CTRL_SOCKET_COALESCE 0x0EL /* the argument is struct at_device_socket_coalesce */
+#define AT_DEVICE_CTRL_SOCKET_FLUSH    0x0FL /* the argument is the AT socket number (int *) */
+
+/* The default timeout in milliseconds of the power status pin changes */
+#ifndef AT_DEVICE_POWER_TIMEOUT
+#define AT_DEVICE_POWER_TIMEOUT        10000
+#endif
+
+/* The maximum UDP payload of one datagram, the IPv4 MTU without the IP and UDP headers */
+#ifndef AT_DEVICE_UDP_SEND_MAX
+#define AT_DEVICE_UDP_SEND_MAX         1472
+#endif
+
+/* The number and the buffer size of the preallocated AT response objects of every AT device, the */
+/* first AT_DEVICE_RESP_LOCK_NUM objects are reserved for the AT client lock holder */
+#ifndef AT_DEVICE_RESP_NUM
+#define AT_DEVICE_RESP_NUM             4
+#endif
+#ifndef AT_DEVICE_RESP_LOCK_NUM
+#define AT_DEVICE_RESP_LOCK_NUM        2
+#endif
+#ifndef AT_DEVICE_RESP_BUF_SIZE
+#ifdef AT_DEVICE_USING_STATIC
+#define AT_DEVICE_RESP_BUF_SIZE        512 /* the longest response of the classes, no heap response in the static build */
+#else
+#define AT_DEVICE_RESP_BUF_SIZE        256
+#endif
+#endif
+
+/* The static memory build, the AT device classes, sockets, events, network interface devices and */
+/* received data buffers come from the memory declared in the AT device config structures */
+#ifdef AT_DEVICE_USING_STATIC
+/* The received data heap size of every AT device */
+#ifndef AT_DEVICE_STATIC_RECV_SIZE
+#define AT_DEVICE_STATIC_RECV_SIZE     8192
+#endif
+/* The maximum number of the AT devices using the UDP, sleep and link monitor status, and the */
+/* maximum sockets number of the device classes using the unconnected UDP sockets */
+#ifndef AT_DEVICE_STATIC_DEVICE_NUM
+#define AT_DEVICE_STATIC_DEVICE_NUM    2
+#endif
+#ifndef AT_DEVICE_STATIC_SOCKET_NUM
+#define AT_DEVICE_STATIC_SOCKET_NUM    12
+#endif
+#if defined(AT_USING_SOCKET) && !defined(RT_USING_MEMHEAP_AS_HEAP)
+#error "AT_DEVICE_USING_STATIC needs RT_USING_MEMHEAP_AS_HEAP, the AT socket layer frees the received data by rt_free()"
+#endif
+#ifdef AT_DEVICE_USING_COALESCE
+#error "AT_DEVICE_USING_STATIC can't be used with AT_DEVICE_USING_COALESCE, the coalescing buffers are allocated on the heap"
+#endif
+#endif /* AT_DEVICE_USING_STATIC */
+
+/* AT device socket placement policy */
+#define AT_DEVICE_PLACEMENT_FIRST          0x00 /* the first initialized device */
+#define AT_DEVICE_PLACEMENT_LEAST_LOADED   0x01 /* the device with the fewest sockets in use */
+#define AT_DEVICE_PLACEMENT_BEST_SIGNAL    0x02 /* the device with the strongest signal */
+
+/* The signal strength (dBm) of AT_DEVICE_CTRL_GET_SIGNAL when it's unknown */
+#define AT_DEVICE_SIGNAL_UNKNOWN       (-255)
+
+/* The reserved AT device socket event bit, it's set while the device link is down */
+#define AT_DEVICE_EVENT_LINK_DOWN      (1UL << 31)
+
+/* The AT device socket event, the low bits are the event types of the device class and every */
+/* device socket has its own bit above them, so the class supports AT_DEVICE_EVENT_SOCKETS_MAX sockets */
+#define AT_DEVICE_EVENT_TYPE_BITS      8
+#define AT_DEVICE_EVENT_SOCKETS_MAX    (31 - AT_DEVICE_EVENT_TYPE_BITS)
+#define AT_DEVICE_SOCKET_EVENT(socket, event) ((1UL << (AT_DEVICE_EVENT_TYPE_BITS + (socket))) | (event))
+
+/* AT device statistics counter type */
+#define AT_DEVICE_STATS_CMD            0x01 /* AT command issued */
+#define AT_DEVICE_STATS_URC            0x02 /* socket URC dispatched */
+#define AT_DEVICE_STATS_SEND           0x03 /* data chunk sent, the value is the chunk size */
+#define AT_DEVICE_STATS_SEND_FAIL      0x04 /* "SEND FAIL" result received */
+#define AT_DEVICE_STATS_RECV           0x05 /* data received, the value is the data size */
+#define AT_DEVICE_STATS_RECV_DROP      0x06 /* received data dropped for no memory */
+#define AT_DEVICE_STATS_CONNECT        0x07 /* socket connected, the value is the connect start tick */
+#define AT_DEVICE_STATS_RESOLVE        0x08 /* domain resolved, the value is the resolve start tick */
+
+/* AT device trace event type, the other event types are the statistics counter types */
+#define AT_DEVICE_TRACE_RESP           0x10 /* AT command response, the length is the response lines */
+#define AT_DEVICE_TRACE_TAG_LEN        12
 
 /* Name type */
 #define AT_DEVICE_NAMETYPE_DEVICE      0x01
@@ -79,6 +162,74 @@ struct at_device_ssid_pwd
     char *password;
 };
 
+/* AT device low power mode configuration, the cellular modules request the PSM and eDRX timers,
+ * the WiFi modules enter the modem sleep mode */
+struct at_device_low_power
+{
+    rt_bool_t psm;                               /* Enable power saving mode */
+    char *psm_tau;                               /* Requested periodic TAU timer, e.g. "00100001" */
+    char *psm_active;                            /* Requested active time, e.g. "00000101" */
+    rt_bool_t edrx;                              /* Enable extended discontinuous reception */
+    char *edrx_value;                            /* Requested eDRX cycle, e.g. "0101" */
+};
+
+/* AT device socket statistics counters */
+struct at_device_socket_stats
+{
+    rt_uint32_t send_bytes;                      /* Data bytes sent */
+    rt_uint32_t send_chunks;                     /* Data chunks sent by the send commands */
+    rt_uint32_t send_fails;                      /* "SEND FAIL" results */
+    rt_uint32_t recv_bytes;                      /* Data bytes received */
+    rt_uint32_t recv_drops;                      /* Received data dropped for no memory */
+};
+
+/* AT device statistics counters, the latency is in milliseconds */
+struct at_device_stats
+{
+    rt_uint32_t cmds;                            /* AT commands issued */
+    rt_uint32_t urcs;                            /* Socket URCs dispatched */
+    rt_uint32_t resp_allocs;                     /* Response objects created on the heap */
+    struct at_device_socket_stats socket;        /* Sum of all sockets */
+    rt_uint32_t connects;                        /* Sockets connected */
+    rt_uint32_t connect_time;                    /* Total connect latency */
+    rt_uint32_t connect_time_max;                /* Maximum connect latency */
+    rt_uint32_t resolves;                        /* Domain names resolved */
+    rt_uint32_t resolve_time;                    /* Total domain resolve latency */
+    rt_uint32_t resolve_time_max;                /* Maximum domain resolve latency */
+};
+
+/* AT device socket small writes coalescing control argument */
+struct at_device_socket_coalesce
+{
+    int socket;                                  /* AT socket number */
+    rt_bool_t enable;                            /* Enable the coalescing */
+    rt_uint32_t delay;                           /* Time in milliseconds to collect the writes, 0 for default */
+};
+
+/* AT device preallocated AT response object */
+struct at_device_resp
+{
+    struct at_response resp;                     /* AT response object, it must be the first member */
+    char buf[AT_DEVICE_RESP_BUF_SIZE];           /* AT response buffer */
+};
+
+#ifdef AT_USING_SOCKET
+/* AT device socket data segment of the vectored send */
+struct at_device_iovec
+{
+    const void *base;                            /* Data segment address */
+    rt_size_t len;                               /* Data segment length */
+};
+
+/* AT device unconnected UDP socket received datagram header, it's put before every datagram */
+struct at_device_udp_head
+{
+    char ip[16];                                 /* Source IP address, empty if the module doesn't report it */
+    int port;                                    /* Source port */
+    rt_size_t len;                               /* Datagram length */
+};
+#endif
+
 /* AT device operations */
 struct at_device_ops
 {
@@ -94,6 +245,9 @@ struct at_device_class
 #ifdef AT_USING_SOCKET
     uint32_t socket_num;                         /* The maximum number of sockets support */
     const struct at_socket_ops *socket_ops;      /* AT device socket operations */
+    int (*socket_sendv)(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                        enum at_socket_type type); /* AT device socket vectored send operation */
+    int (*socket_udp_open)(struct at_socket *socket, int local_port); /* Open unconnected UDP socket, optional */
 #endif
     rt_slist_t list;                             /* AT device class list */
 };
@@ -106,21 +260,112 @@ struct at_device
     struct at_client *client;                    /* AT Client object for AT device */
     struct netdev *netdev;                       /* Network interface device for AT device */
 #ifdef AT_USING_SOCKET
+    rt_uint32_t socket_num;                      /* Sockets number used on the device, 0 for the class maximum */
     rt_event_t socket_event;                     /* AT device socket event */
     struct at_socket *sockets;                   /* AT device sockets list */
+    struct at_device_socket_stats *socket_stats; /* AT device sockets statistics counters */
+    rt_size_t send_max_size;                     /* Maximum data length of one send command probed, 0 if unknown */
+#endif
+    struct at_device_stats stats;                /* AT device statistics counters */
+    struct at_device_resp resps[AT_DEVICE_RESP_NUM]; /* Preallocated AT response objects */
+    rt_uint32_t resps_busy;                      /* Bit mask of the response objects in use */
+    rt_thread_t lock_owner;                      /* Thread holding the AT client lock by at_device_lock() */
+    rt_uint32_t lock_depth;                      /* Nested at_device_lock() calls of the lock owner */
+#ifdef AT_DEVICE_USING_STATIC
+    struct rt_semaphore resp_sem;                /* Free response objects not reserved for the lock holder */
+    struct netdev netdev_obj;                    /* Network interface device object */
+#ifdef AT_USING_SOCKET
+    struct rt_event socket_event_obj;            /* Socket event object */
+    struct rt_memheap recv_heap;                 /* Received data heap */
+    void *recv_pool;                             /* Received data heap memory, see AT_DEVICE_STATIC_BIND */
+    rt_size_t recv_pool_size;                    /* Received data heap memory size */
 #endif
+#endif /* AT_DEVICE_USING_STATIC */
     rt_slist_t list;                             /* AT device list */
 
     void *user_data;                             /* User-specific data */
 };
 
+#ifdef AT_DEVICE_USING_STATIC
+/* Bind the sockets, the sockets statistics counters and the received data heap memory declared in */
+/* the AT device config structure (in the class maximum sockets number) before registering the device */
+#ifdef AT_USING_SOCKET
+#define AT_DEVICE_STATIC_BIND(config)                                                  \
+    do                                                                                 \
+    {                                                                                  \
+        (config)->device.sockets = (config)->sockets;                                  \
+        (config)->device.socket_stats = (config)->socket_stats;                        \
+        (config)->device.recv_pool = (config)->recv_pool;                              \
+        (config)->device.recv_pool_size = sizeof((config)->recv_pool);                 \
+    } while (0)
+#else
+#define AT_DEVICE_STATIC_BIND(config)
+#endif /* AT_USING_SOCKET */
+#endif /* AT_DEVICE_USING_STATIC */
+
+/* AT device initialize sequence step flags */
+#define AT_DEVICE_STEP_COALESCE        0x01U /* the step can be coalesced with the adjacent steps */
+#define AT_DEVICE_STEP_EXCLUDE         0x02U /* retry while the keyword is found in the response */
+#define AT_DEVICE_STEP_OPTIONAL        0x04U /* the step failure is ignored */
+
+/* AT device initialize sequence step */
+struct at_device_step
+{
+    const char *cmd;                             /* AT command line */
+    const char *keyword;                         /* Expected keywords separated by '|', RT_NULL for "OK" only */
+    rt_uint32_t timeout;                         /* Response timeout in milliseconds */
+    rt_uint8_t retry;                            /* Retry times when the step failed */
+    rt_uint8_t flags;                            /* Step flags */
+    rt_uint16_t delay;                           /* Retry delay in milliseconds */
+    rt_uint16_t delay_max;                       /* Retry delay doubled up to it, no backoff if less than delay */
+};
+
+/* AT device link status polling command and response parser, the command and parser are run by
+ * the shared link monitor thread and must not block, see at_device_link_monitor() */
+struct at_device_link_ops
+{
+    const char *cmd;                             /* Link status query AT command line, answered at once */
+    rt_bool_t (*parse)(at_response_t resp);      /* Parse the response only, return RT_TRUE if the link is up */
+    int (*reactivate)(struct at_device *device); /* Reactivate the data context, RT_NULL if not supports */
+};
+
+#ifdef AT_DEVICE_USING_CACHE
+/* The maximum length of the module identity, the comma separated fields (e.g. firmware, IMEI, ICCID) */
+#define AT_DEVICE_CACHE_IDENTITY_LEN   96
+
+/* AT device persistent cache backend operations */
+struct at_device_cache_ops
+{
+    int (*read)(const char *name, const char *key, char *value, rt_size_t size);
+    int (*write)(const char *name, const char *key, const char *value);
+    int (*erase)(const char *name);
+};
+#endif /* AT_DEVICE_USING_CACHE */
+
 /* Get AT device object */
 struct at_device *at_device_get_first_initialized(void);
 struct at_device *at_device_get_by_name(int type, const char *name);
 #ifdef AT_USING_SOCKET
 struct at_device *at_device_get_by_socket(int at_socket);
+/* AT device socket placement */
+void at_device_set_placement(int policy);
+struct at_device *at_device_placement_update(void);
+struct at_device *at_device_get_resolver(uint16_t class_id);
+/* AT device socket send size */
+int at_device_probe_send_max(struct at_device *device, const char *cmd, const char *keyword);
+rt_size_t at_device_send_max(struct at_device *device, enum at_socket_type type, rt_size_t size, rt_size_t class_max);
+rt_size_t at_device_iov_len(const struct at_device_iovec *iov, int iovcnt);
+rt_size_t at_device_iov_copy(char *buff, const struct at_device_iovec *iov, int iovcnt, rt_size_t offset, rt_size_t len);
+rt_size_t at_device_iov_send(struct at_device *device, const struct at_device_iovec *iov, int iovcnt,
+                             rt_size_t offset, rt_size_t len);
+int at_device_socket_sendv(int at_socket, const struct at_device_iovec *iov, int iovcnt);
 #endif
 
+/* AT device network ready status */
+void at_device_set_ready(struct at_device *device, rt_bool_t is_ready);
+int at_device_wait_ready(struct at_device *device, rt_int32_t timeout);
+struct at_device *at_device_wait_first_ready(rt_int32_t timeout);
+
 /* AT device control operaions */
 int at_device_control(struct at_device *device, int cmd, void *arg);
 /* Register AT device class object */
@@ -128,6 +373,98 @@ int at_device_class_register(struct at_device_class *class, uint16_t class_id);
 /* Register AT device object */
 int at_device_register(struct at_device *device, const char *device_name,
                         const char *at_client_name, uint16_t class_id, void *user_data);
+/* Execute AT device initialize sequence steps */
+int at_device_exec_steps(struct at_device *device, at_response_t resp,
+                         const struct at_device_step *steps, rt_size_t step_num);
+
+/* AT device preallocated AT response objects */
+at_response_t at_device_resp_take(struct at_device *device, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
+at_response_t at_device_resp_set_info(struct at_device *device, at_response_t resp,
+                                      rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
+void at_device_resp_release(struct at_device *device, at_response_t resp);
+
+/* AT device network interface device and received data buffer, from the static memory in the static build */
+struct netdev *at_device_netdev_alloc(struct at_device *device);
+#ifdef AT_USING_SOCKET
+void *at_device_recv_alloc(struct at_device *device, rt_size_t size);
+#endif
+
+/* AT device statistics counters */
+int at_device_exec_cmd(struct at_device *device, at_response_t resp, const char *cmd_expr, ...);
+void at_device_stats_update(struct at_device *device, int socket, int type, rt_uint32_t value);
+void at_device_stats_urc(struct at_device *device, const char *data);
+
+/* AT device client lock and the optional AT command latency and lock time profiling */
+void at_device_lock(struct at_device *device);
+void at_device_unlock(struct at_device *device);
+#ifdef AT_DEVICE_USING_PROFILE
+void at_device_profile_cmd(struct at_device *device, const char *cmd, rt_tick_t start_tick);
+void at_device_profile_reset(void);
+void at_device_profile_dump(struct at_device *device);
+#endif
+
+/* AT device binary trace ring buffer */
+#ifdef AT_DEVICE_USING_TRACE
+void at_device_trace(struct at_device *device, rt_uint8_t type, int socket, rt_uint32_t len,
+                     int result, const char *tag);
+void at_device_trace_reset(void);
+void at_device_trace_dump(void);
+#endif
+
+/* AT device sleep status and the sending data queue while sleeping */
+void at_device_sleep_set(struct at_device *device, rt_bool_t is_sleep, rt_uint32_t sleep_time);
+rt_bool_t at_device_is_sleep(struct at_device *device);
+#ifdef AT_USING_SOCKET
+int at_device_sleep_queue(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                          enum at_socket_type type);
+rt_bool_t at_device_sleep_is_flushing(struct at_device *device);
+
+/* AT device socket small writes coalescing */
+int at_device_coalesce_set(int at_socket, rt_bool_t enable, rt_uint32_t delay);
+int at_device_coalesce_flush(int at_socket);
+int at_device_coalesce_queue(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                             enum at_socket_type type, rt_size_t send_max_size);
+void at_device_coalesce_close(struct at_socket *socket);
+void at_device_coalesce_reset(struct at_device *device, int device_socket);
+
+/* AT device unconnected UDP sockets, the datagrams are sent to and received from any peers */
+int at_device_udp_open(int at_socket, int local_port);
+int at_device_udp_sendto(int at_socket, const void *data, rt_size_t size,
+                         const struct sockaddr *to, socklen_t tolen);
+int at_device_udp_recvfrom(int at_socket, void *mem, rt_size_t len,
+                           struct sockaddr *from, socklen_t *fromlen);
+rt_bool_t at_device_udp_is_unconnected(struct at_device *device, int device_socket);
+void at_device_udp_set_dest(struct at_device *device, int device_socket, const char *ip, int port);
+rt_bool_t at_device_udp_get_dest(struct at_device *device, int device_socket, char ip[16], int *port);
+void at_device_udp_head_set(struct at_device_udp_head *head, const char *ip, int port, rt_size_t len);
+void at_device_udp_reset(struct at_device *device, int device_socket);
+#endif
+
+/* AT device power sequencing */
+int at_device_pin_wait(rt_base_t pin, rt_base_t level, rt_uint32_t timeout);
+int at_device_power_switch(struct at_device *device, rt_base_t power_pin, rt_base_t status_pin,
+                           rt_bool_t is_on, rt_uint32_t timeout);
+
+/* AT device shared link monitor service */
+int at_device_link_monitor(struct at_device *device, const struct at_device_link_ops *ops);
+void at_device_link_notify(struct at_device *device, rt_bool_t is_up);
+void at_device_link_reactivate(struct at_device *device);
+void at_device_link_activity(struct at_device *device);
+#ifdef AT_USING_SOCKET
+rt_err_t at_device_socket_event_recv(struct at_device *device, rt_uint32_t set, rt_uint8_t option,
+                                     rt_int32_t timeout, rt_uint32_t *recved);
+#endif
+
+#ifdef AT_DEVICE_USING_CACHE
+/* AT device persistent cache operations */
+int at_device_cache_register(const struct at_device_cache_ops *ops);
+int at_device_cache_check(struct at_device *device, const char *identity);
+int at_device_cache_get(struct at_device *device, const char *key, char *value, rt_size_t size);
+int at_device_cache_set(struct at_device *device, const char *key, const char *value);
+#ifdef AT_DEVICE_CACHE_USING_FILE
+int at_device_cache_file_init(const char *path);
+#endif
+#endif /* AT_DEVICE_USING_CACHE */
 
 #ifdef __cplusplus
 }
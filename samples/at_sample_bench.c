@@ -0,0 +1,561 @@
+/*
+ * File      : at_sample_bench.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+/*
+ * Throughput and latency benchmark of the AT socket, it works with the bench server of
+ * tools/at_bench.py. Every connection starts with a request line to the server:
+ *
+ *   "up <bytes>\n"      the server reads the bytes and answers "done <bytes>\n"
+ *   "down <bytes>\n"    the server sends the bytes
+ *   "echo\n"            the server echoes the received data
+ *
+ * The result is printed as one line of JSON after the "BENCH " prefix.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define LOG_TAG                        "at.bench"
+#include <at_log.h>
+
+#ifdef AT_USING_SOCKET
+
+#include <at_socket.h>
+
+#define AT_BENCH_BUFF_LEN              1024
+#define AT_BENCH_RECV_TIMEOUT          30
+#define AT_BENCH_SOCKETS_MAX           16
+#define AT_BENCH_SEGMENTS_MAX          8
+#define AT_BENCH_THREAD_STACK_SIZE     2048
+#define AT_BENCH_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX / 2)
+
+/* the writes of the upload */
+struct at_bench_write
+{
+    size_t size;                                 /* bytes of one write */
+    rt_uint32_t delay;                           /* coalescing delay in ms, 0 if not coalesced */
+    int segments;                                /* segments of one vectored write, 1 for at_send() */
+};
+
+struct at_bench_worker
+{
+    struct sockaddr_in *addr;
+    size_t bytes;
+    const struct at_bench_write *write;
+    char device[RT_NAME_MAX];
+    int result;
+    rt_sem_t done;
+};
+
+static rt_uint32_t at_bench_ms(rt_tick_t start)
+{
+    rt_uint32_t ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+
+    return ms ? ms : 1;
+}
+
+/* bytes per second without the 32 bits overflow */
+static rt_uint32_t at_bench_rate(size_t bytes, rt_uint32_t ms)
+{
+    return (bytes / ms) * 1000 + (bytes % ms) * 1000 / ms;
+}
+
+static const char *at_bench_device_name(int sock)
+{
+    struct at_socket *socket = at_get_socket(sock);
+
+    if (socket && socket->device)
+    {
+        return ((struct at_device *) socket->device)->name;
+    }
+
+    return "unknown";
+}
+
+/* create the TCP socket, connect the bench server and send the request line */
+static int at_bench_connect(struct sockaddr_in *addr, const char *request)
+{
+    struct timeval timeout = { AT_BENCH_RECV_TIMEOUT, 0 };
+    int sock;
+
+    sock = at_socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        LOG_E("create socket failed.");
+        return -1;
+    }
+
+    at_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (at_connect(sock, (struct sockaddr *) addr, sizeof(struct sockaddr_in)) < 0)
+    {
+        LOG_E("connect bench server failed.");
+        at_closesocket(sock);
+        return -1;
+    }
+
+    if (request && at_send(sock, request, rt_strlen(request), 0) < 0)
+    {
+        LOG_E("send request(%s) failed.", request);
+        at_closesocket(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/* receive the bytes, the buffer content is dropped when the length is larger than the buffer */
+static int at_bench_recv_all(int sock, char *buff, size_t buff_len, size_t len)
+{
+    size_t recv_len = 0;
+    int result;
+
+    while (recv_len < len)
+    {
+        result = at_recv(sock, buff, (len - recv_len < buff_len) ? len - recv_len : buff_len, 0);
+        if (result <= 0)
+        {
+            return -1;
+        }
+        recv_len += result;
+    }
+
+    return (int) recv_len;
+}
+
+/* send one write, the vectored write splits the data into the segments */
+static int at_bench_write(int sock, const struct at_bench_write *write, const char *buff, size_t len)
+{
+    struct at_device_iovec iov[AT_BENCH_SEGMENTS_MAX];
+    size_t offset = 0;
+    int index;
+
+    if (write->segments <= 1)
+    {
+        return at_send(sock, buff, len, 0);
+    }
+
+    for (index = 0; index < write->segments; index++)
+    {
+        iov[index].base = buff + offset;
+        iov[index].len = (index == write->segments - 1) ? len - offset : len / write->segments;
+        offset += iov[index].len;
+    }
+
+    return at_device_socket_sendv(sock, iov, write->segments);
+}
+
+/* send the bytes by the writes and wait for the server receiving done line, the device name is saved */
+static int at_bench_upload(struct sockaddr_in *addr, size_t bytes, const struct at_bench_write *write,
+                           char *buff, char *device)
+{
+    char request[32];
+    size_t sent_len = 0, cur_len;
+    int sock, result = -1;
+
+    rt_snprintf(request, sizeof(request), "up %d\n", (int) bytes);
+    sock = at_bench_connect(addr, request);
+    if (sock < 0)
+    {
+        return -1;
+    }
+    rt_strncpy(device, at_bench_device_name(sock), RT_NAME_MAX);
+
+    if (write->delay && at_device_coalesce_set(sock, RT_TRUE, write->delay) != RT_EOK)
+    {
+        LOG_E("enable the socket coalescing failed.");
+        goto __exit;
+    }
+
+    rt_memset(buff, 'u', AT_BENCH_BUFF_LEN);
+    while (sent_len < bytes)
+    {
+        cur_len = (bytes - sent_len < write->size) ? bytes - sent_len : write->size;
+        if (at_bench_write(sock, write, buff, cur_len) < 0)
+        {
+            LOG_E("upload send failed at %d bytes.", (int) sent_len);
+            goto __exit;
+        }
+        sent_len += cur_len;
+    }
+
+    if (write->delay && at_device_coalesce_flush(sock) != RT_EOK)
+    {
+        LOG_E("flush the coalesced data failed.");
+        goto __exit;
+    }
+
+    /* "done <bytes>\n" */
+    if (at_recv(sock, buff, AT_BENCH_BUFF_LEN, 0) <= 0 || rt_strncmp(buff, "done", 4) != 0)
+    {
+        LOG_E("wait for the upload done failed.");
+        goto __exit;
+    }
+    result = 0;
+
+__exit:
+    at_closesocket(sock);
+
+    return result;
+}
+
+static int at_bench_up(struct sockaddr_in *addr, size_t bytes, const struct at_bench_write *write)
+{
+    char device[RT_NAME_MAX] = "unknown";
+    char *buff = RT_NULL;
+    rt_tick_t start;
+    rt_uint32_t ms;
+
+    buff = rt_malloc(AT_BENCH_BUFF_LEN);
+    if (buff == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    start = rt_tick_get();
+    if (at_bench_upload(addr, bytes, write, buff, device) < 0)
+    {
+        rt_free(buff);
+        return -RT_ERROR;
+    }
+    ms = at_bench_ms(start);
+
+    rt_kprintf("BENCH {\"test\":\"up\",\"device\":\"%s\",\"bytes\":%d,\"write_size\":%d,\"coalesce_ms\":%d,"
+               "\"segments\":%d,\"ms\":%d,\"bytes_per_sec\":%d}\n", device, (int) bytes, (int) write->size,
+               write->delay, write->segments, ms, at_bench_rate(bytes, ms));
+    rt_free(buff);
+
+    return RT_EOK;
+}
+
+static int at_bench_down(struct sockaddr_in *addr, size_t bytes)
+{
+    char request[32];
+    char *buff = RT_NULL;
+    rt_tick_t start;
+    rt_uint32_t ms;
+    int sock, result = -RT_ERROR;
+
+    buff = rt_malloc(AT_BENCH_BUFF_LEN);
+    if (buff == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    start = rt_tick_get();
+    rt_snprintf(request, sizeof(request), "down %d\n", (int) bytes);
+    sock = at_bench_connect(addr, request);
+    if (sock < 0)
+    {
+        goto __exit;
+    }
+
+    if (at_bench_recv_all(sock, buff, AT_BENCH_BUFF_LEN, bytes) < 0)
+    {
+        LOG_E("download receive failed.");
+        at_closesocket(sock);
+        goto __exit;
+    }
+    ms = at_bench_ms(start);
+
+    rt_kprintf("BENCH {\"test\":\"down\",\"device\":\"%s\",\"bytes\":%d,\"ms\":%d,\"bytes_per_sec\":%d}\n",
+               at_bench_device_name(sock), (int) bytes, ms, at_bench_rate(bytes, ms));
+    at_closesocket(sock);
+    result = RT_EOK;
+
+__exit:
+    rt_free(buff);
+
+    return result;
+}
+
+static int at_bench_rtt(struct sockaddr_in *addr, int count, size_t size)
+{
+    char *buff = RT_NULL;
+    rt_tick_t start;
+    rt_uint32_t ms, min_ms = 0xFFFFFFFF, max_ms = 0, total_ms = 0;
+    int sock, index, result = -RT_ERROR;
+
+    if (size == 0 || size > AT_BENCH_BUFF_LEN)
+    {
+        LOG_E("the message size should be 1 ~ %d.", AT_BENCH_BUFF_LEN);
+        return -RT_EINVAL;
+    }
+
+    buff = rt_malloc(AT_BENCH_BUFF_LEN);
+    if (buff == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    sock = at_bench_connect(addr, "echo\n");
+    if (sock < 0)
+    {
+        goto __exit;
+    }
+
+    rt_memset(buff, 'r', size);
+    for (index = 0; index < count; index++)
+    {
+        start = rt_tick_get();
+        if (at_send(sock, buff, size, 0) < 0 || at_bench_recv_all(sock, buff, size, size) < 0)
+        {
+            LOG_E("echo message(%d) failed.", index);
+            at_closesocket(sock);
+            goto __exit;
+        }
+        ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+
+        total_ms += ms;
+        min_ms = (ms < min_ms) ? ms : min_ms;
+        max_ms = (ms > max_ms) ? ms : max_ms;
+    }
+
+    rt_kprintf("BENCH {\"test\":\"rtt\",\"device\":\"%s\",\"count\":%d,\"size\":%d,"
+               "\"min_ms\":%d,\"avg_ms\":%d,\"max_ms\":%d}\n",
+               at_bench_device_name(sock), count, (int) size, count ? min_ms : 0, count ? total_ms / count : 0, max_ms);
+    at_closesocket(sock);
+    result = RT_EOK;
+
+__exit:
+    rt_free(buff);
+
+    return result;
+}
+
+static void at_bench_worker_entry(void *parameter)
+{
+    struct at_bench_worker *worker = (struct at_bench_worker *) parameter;
+    char *buff = rt_malloc(AT_BENCH_BUFF_LEN);
+
+    worker->result = (buff && at_bench_upload(worker->addr, worker->bytes, worker->write, buff, worker->device) == 0) ? RT_EOK : -RT_ERROR;
+
+    rt_free(buff);
+    rt_sem_release(worker->done);
+}
+
+/* upload on the sockets in parallel, the bytes of every socket */
+static int at_bench_conc(struct sockaddr_in *addr, int sockets, size_t bytes, const struct at_bench_write *write)
+{
+    struct at_bench_worker workers[AT_BENCH_SOCKETS_MAX];
+    char name[RT_NAME_MAX];
+    rt_sem_t done = RT_NULL;
+    rt_thread_t tid;
+    rt_tick_t start;
+    rt_uint32_t ms;
+    int index, started = 0, failed = 0;
+
+    if (sockets <= 0 || sockets > AT_BENCH_SOCKETS_MAX)
+    {
+        LOG_E("the socket number should be 1 ~ %d.", AT_BENCH_SOCKETS_MAX);
+        return -RT_EINVAL;
+    }
+
+    done = rt_sem_create("at_bench", 0, RT_IPC_FLAG_FIFO);
+    if (done == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    start = rt_tick_get();
+    for (index = 0; index < sockets; index++)
+    {
+        workers[index].addr = addr;
+        workers[index].bytes = bytes;
+        workers[index].write = write;
+        workers[index].result = -RT_ERROR;
+        rt_strncpy(workers[index].device, "unknown", RT_NAME_MAX);
+        workers[index].done = done;
+
+        rt_snprintf(name, sizeof(name), "bench%d", index);
+        tid = rt_thread_create(name, at_bench_worker_entry, &workers[index],
+                               AT_BENCH_THREAD_STACK_SIZE, AT_BENCH_THREAD_PRIORITY, 20);
+        if (tid == RT_NULL)
+        {
+            LOG_E("create bench thread failed.");
+            break;
+        }
+        rt_thread_startup(tid);
+        started++;
+    }
+
+    for (index = 0; index < started; index++)
+    {
+        rt_sem_take(done, RT_WAITING_FOREVER);
+    }
+    ms = at_bench_ms(start);
+
+    for (index = 0; index < started; index++)
+    {
+        failed += (workers[index].result != RT_EOK);
+    }
+    failed += sockets - started;
+
+    rt_kprintf("BENCH {\"test\":\"conc\",\"device\":\"%s\",\"sockets\":%d,\"failed\":%d,\"bytes\":%d,"
+               "\"ms\":%d,\"bytes_per_sec\":%d}\n", workers[0].device, sockets, failed, (int) (bytes * (sockets - failed)),
+               ms, at_bench_rate(bytes * (sockets - failed), ms));
+    rt_sem_delete(done);
+
+    return failed ? -RT_ERROR : RT_EOK;
+}
+
+/* connect and close the socket repeatedly */
+static int at_bench_connect_rate(struct sockaddr_in *addr, int count)
+{
+    char device[RT_NAME_MAX] = "unknown";
+    rt_tick_t start;
+    rt_uint32_t ms;
+    int index, sock, failed = 0;
+
+    start = rt_tick_get();
+    for (index = 0; index < count; index++)
+    {
+        sock = at_bench_connect(addr, RT_NULL);
+        if (sock < 0)
+        {
+            failed++;
+            continue;
+        }
+        rt_strncpy(device, at_bench_device_name(sock), RT_NAME_MAX);
+        at_closesocket(sock);
+    }
+    ms = at_bench_ms(start);
+
+    rt_kprintf("BENCH {\"test\":\"connect\",\"device\":\"%s\",\"count\":%d,\"failed\":%d,\"ms\":%d,"
+               "\"avg_ms\":%d}\n", device, count, failed, ms, (count > failed) ? ms / (count - failed) : 0);
+
+    return failed ? -RT_ERROR : RT_EOK;
+}
+
+static void at_bench_usage(void)
+{
+    rt_kprintf("at_bench <test> <host> <port> [-n number] [-s size] [-c sockets] [-w write size] [-f flush ms] [-g segments]\n");
+    rt_kprintf("  up       upload the bytes of -n (default 16384) by the writes of -w bytes (default %d),\n", AT_BENCH_BUFF_LEN);
+    rt_kprintf("           the writes are coalesced and flushed after -f ms if it's not 0 (default 0),\n");
+    rt_kprintf("           every write is sent by at_device_socket_sendv() in -g segments if it's not 1 (default 1)\n");
+    rt_kprintf("  down     download the bytes of -n (default 16384)\n");
+    rt_kprintf("  rtt      echo -n (default 20) messages of -s bytes (default 32)\n");
+    rt_kprintf("  conc     upload the bytes of -n on -c sockets (default 4) in parallel, -w and -f as up\n");
+    rt_kprintf("  connect  connect and close -n (default 10) times\n");
+}
+
+int at_bench(int argc, char **argv)
+{
+    struct hostent *host = RT_NULL;
+    struct sockaddr_in addr;
+    const char *test;
+    struct at_bench_write write = { AT_BENCH_BUFF_LEN, 0, 1 };
+    int number = -1, size = 32, sockets = 4, index;
+
+    if (argc < 4)
+    {
+        at_bench_usage();
+        return -RT_ERROR;
+    }
+
+    for (index = 4; index + 1 < argc; index += 2)
+    {
+        if (rt_strcmp(argv[index], "-n") == 0)
+        {
+            number = atoi(argv[index + 1]);
+        }
+        else if (rt_strcmp(argv[index], "-s") == 0)
+        {
+            size = atoi(argv[index + 1]);
+        }
+        else if (rt_strcmp(argv[index], "-c") == 0)
+        {
+            sockets = atoi(argv[index + 1]);
+        }
+        else if (rt_strcmp(argv[index], "-w") == 0)
+        {
+            write.size = atoi(argv[index + 1]);
+        }
+        else if (rt_strcmp(argv[index], "-f") == 0)
+        {
+            write.delay = atoi(argv[index + 1]);
+        }
+        else if (rt_strcmp(argv[index], "-g") == 0)
+        {
+            write.segments = atoi(argv[index + 1]);
+        }
+        else
+        {
+            at_bench_usage();
+            return -RT_ERROR;
+        }
+    }
+
+    if (write.size == 0 || write.size > AT_BENCH_BUFF_LEN || write.segments <= 0 || write.segments > AT_BENCH_SEGMENTS_MAX)
+    {
+        LOG_E("the write size should be 1 ~ %d, the segments should be 1 ~ %d.", AT_BENCH_BUFF_LEN, AT_BENCH_SEGMENTS_MAX);
+        return -RT_EINVAL;
+    }
+
+    host = at_gethostbyname(argv[2]);
+    if (host == RT_NULL)
+    {
+        LOG_E("resolve bench server(%s) failed.", argv[2]);
+        return -RT_ERROR;
+    }
+
+    rt_memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(atoi(argv[3]));
+    rt_memcpy(&(addr.sin_addr), host->h_addr_list[0], sizeof(addr.sin_addr));
+
+    test = argv[1];
+    if (rt_strcmp(test, "up") == 0)
+    {
+        return at_bench_up(&addr, (number < 0) ? 16384 : number, &write);
+    }
+    else if (rt_strcmp(test, "down") == 0)
+    {
+        return at_bench_down(&addr, (number < 0) ? 16384 : number);
+    }
+    else if (rt_strcmp(test, "rtt") == 0)
+    {
+        return at_bench_rtt(&addr, (number < 0) ? 20 : number, size);
+    }
+    else if (rt_strcmp(test, "conc") == 0)
+    {
+        return at_bench_conc(&addr, sockets, (number < 0) ? 16384 : number, &write);
+    }
+    else if (rt_strcmp(test, "connect") == 0)
+    {
+        return at_bench_connect_rate(&addr, (number < 0) ? 10 : number);
+    }
+
+    at_bench_usage();
+
+    return -RT_ERROR;
+}
+#ifdef FINSH_USING_MSH
+#include <finsh.h>
+MSH_CMD_EXPORT(at_bench, AT socket throughput and latency benchmark);
+#endif
+
+#endif /* AT_USING_SOCKET */
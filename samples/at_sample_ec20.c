@@ -29,6 +29,16 @@
 
 #define EC20_SAMPLE_DEIVCE_NAME        "e0"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef EC20_SAMPLE_SOCKETS_NUM
+#define EC20_SAMPLE_SOCKETS_NUM        0
+#endif
+
+/* The module DTR pin to control the sleep mode, 0 if not connected */
+#ifndef EC20_SAMPLE_WAKEUP_PIN
+#define EC20_SAMPLE_WAKEUP_PIN         0
+#endif
+
 static struct at_device_ec20 e0 =
 {
     EC20_SAMPLE_DEIVCE_NAME,
@@ -43,6 +53,14 @@ static int ec20_device_register(void)
 {
     struct at_device_ec20 *ec20 = &e0;
 
+#ifdef AT_USING_SOCKET
+    ec20->device.socket_num = EC20_SAMPLE_SOCKETS_NUM;
+#endif
+    ec20->wakeup_pin = EC20_SAMPLE_WAKEUP_PIN;
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(ec20);
+#endif
+
     return at_device_register(&(ec20->device),
                               ec20->device_name,
                               ec20->client_name,
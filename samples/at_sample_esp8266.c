@@ -29,6 +29,11 @@
 
 #define ESP8266_SAMPLE_DEIVCE_NAME     "esp0"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef ESP8266_SAMPLE_SOCKETS_NUM
+#define ESP8266_SAMPLE_SOCKETS_NUM     0
+#endif
+
 static struct at_device_esp8266 esp0 =
 {
     ESP8266_SAMPLE_DEIVCE_NAME,
@@ -43,6 +48,13 @@ static int esp8266_device_register(void)
 {
     struct at_device_esp8266 *esp8266 = &esp0;
 
+#ifdef AT_USING_SOCKET
+    esp8266->device.socket_num = ESP8266_SAMPLE_SOCKETS_NUM;
+#endif
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(esp8266);
+#endif
+
     return at_device_register(&(esp8266->device),
                               esp8266->device_name,
                               esp8266->client_name,
@@ -29,6 +29,11 @@
 
 #define M26_SAMPLE_DEIVCE_NAME        "m0"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef M26_SAMPLE_SOCKETS_NUM
+#define M26_SAMPLE_SOCKETS_NUM         0
+#endif
+
 static struct at_device_m26 m0 =
 {
     M26_SAMPLE_DEIVCE_NAME,
@@ -43,6 +48,13 @@ static int m26_device_register(void)
 {
     struct at_device_m26 *m26 = &m0;
 
+#ifdef AT_USING_SOCKET
+    m26->device.socket_num = M26_SAMPLE_SOCKETS_NUM;
+#endif
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(m26);
+#endif
+
     return at_device_register(&(m26->device),
                               m26->device_name,
                               m26->client_name,
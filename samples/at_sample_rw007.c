@@ -29,6 +29,11 @@
 
 #define RW007_SAMPLE_DEIVCE_NAME       "r0"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef RW007_SAMPLE_SOCKETS_NUM
+#define RW007_SAMPLE_SOCKETS_NUM       0
+#endif
+
 static struct at_device_rw007 r0 =
 {
     RW007_SAMPLE_DEIVCE_NAME,
@@ -43,6 +48,13 @@ static int rw007_device_register(void)
 {
     struct at_device_rw007 *rw007 = &r0;
 
+#ifdef AT_USING_SOCKET
+    rw007->device.socket_num = RW007_SAMPLE_SOCKETS_NUM;
+#endif
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(rw007);
+#endif
+
     return at_device_register(&(rw007->device),
                               rw007->device_name,
                               rw007->client_name,
@@ -29,6 +29,16 @@
 
 #define SIM76XX_SAMPLE_DEIVCE_NAME     "sim1"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef SIM76XX_SAMPLE_SOCKETS_NUM
+#define SIM76XX_SAMPLE_SOCKETS_NUM     0
+#endif
+
+/* The module DTR pin to control the sleep mode, 0 if not connected */
+#ifndef SIM76XX_SAMPLE_WAKEUP_PIN
+#define SIM76XX_SAMPLE_WAKEUP_PIN      0
+#endif
+
 static struct at_device_sim76xx sim1 =
 {
     SIM76XX_SAMPLE_DEIVCE_NAME,
@@ -43,6 +53,14 @@ static int sim76xx_device_register(void)
 {
     struct at_device_sim76xx *sim76xx = &sim1;
 
+#ifdef AT_USING_SOCKET
+    sim76xx->device.socket_num = SIM76XX_SAMPLE_SOCKETS_NUM;
+#endif
+    sim76xx->wakeup_pin = SIM76XX_SAMPLE_WAKEUP_PIN;
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(sim76xx);
+#endif
+
     return at_device_register(&(sim76xx->device),
                               sim76xx->device_name,
                               sim76xx->client_name,
@@ -29,6 +29,11 @@
 
 #define SIM800C_SAMPLE_DEIVCE_NAME     "sim0"
 
+/* The number of the sockets used on the device, 0 for the module maximum */
+#ifndef SIM800C_SAMPLE_SOCKETS_NUM
+#define SIM800C_SAMPLE_SOCKETS_NUM     0
+#endif
+
 static struct at_device_sim800c sim0 =
 {
     SIM800C_SAMPLE_DEIVCE_NAME,
@@ -43,6 +48,13 @@ static int sim800c_device_register(void)
 {
     struct at_device_sim800c *sim800c = &sim0;
 
+#ifdef AT_USING_SOCKET
+    sim800c->device.socket_num = SIM800C_SAMPLE_SOCKETS_NUM;
+#endif
+#ifdef AT_DEVICE_USING_STATIC
+    AT_DEVICE_STATIC_BIND(sim800c);
+#endif
+
     return at_device_register(&(sim800c->device),
                               sim800c->device_name,
                               sim800c->client_name,
@@ -22,6 +22,7 @@
  * 2019-05-08     chenyong     first version
  */
 
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -31,10 +32,57 @@
 #define DBG_LVL              DBG_INFO
 #include <rtdbg.h>
 
+#define AT_DEVICE_READY_MAX            32
+
+/* The magic of the sockets beyond the device sockets number, they are never allocated by the AT */
+/* socket layer which allocates the sockets in the class maximum */
+#define AT_DEVICE_SOCKET_RESERVED      0xA1FFU
+
+/* The smallest probed data length of one send command taken as the module limit */
+#define AT_DEVICE_SEND_MIN             64
+
+/* The signal strength selection is reused in the time (milliseconds) */
+#ifndef AT_DEVICE_PLACEMENT_SIGNAL_TIME
+#define AT_DEVICE_PLACEMENT_SIGNAL_TIME 10000
+#endif
+
+#ifdef AT_DEVICE_USING_INIT_POOL
+#ifndef AT_DEVICE_INIT_POOL_SIZE
+#define AT_DEVICE_INIT_POOL_SIZE       2
+#endif
+#ifndef AT_DEVICE_INIT_POOL_STACK_SIZE
+#define AT_DEVICE_INIT_POOL_STACK_SIZE 2048
+#endif
+#define AT_DEVICE_INIT_POOL_PRIORITY   (RT_THREAD_PRIORITY_MAX / 2)
+#define AT_DEVICE_INIT_QUEUE_SIZE      8
+#if AT_DEVICE_INIT_POOL_SIZE > 32
+#error "AT_DEVICE_INIT_POOL_SIZE should be less than or equal to 32, the workers are kept in a 32 bits mask"
+#endif
+#endif /* AT_DEVICE_USING_INIT_POOL */
+
 /* The global list of at device */
 static struct at_device *at_device_list = RT_NULL;
 /* The global list of at device class */
 static struct at_device_class *at_device_class_list = RT_NULL;
+/* The network ready event, one bit for each AT device in registration order */
+static struct rt_event at_device_ready_event;
+
+#ifdef AT_USING_SOCKET
+/* The placement policy and the AT device selected for the new sockets */
+static int placement_policy = AT_DEVICE_PLACEMENT_FIRST;
+static struct at_device *placement_device = RT_NULL;
+static rt_tick_t placement_signal_tick = 0;
+/* The AT devices ready to place the new sockets, it's updated before the ready event is sent */
+static rt_uint32_t placement_ready = 0;
+#endif
+
+#ifdef AT_DEVICE_USING_INIT_POOL
+/* The AT devices waiting for the initialization worker pool */
+static struct at_device *at_device_init_queue[AT_DEVICE_INIT_QUEUE_SIZE] = {0};
+static rt_uint8_t init_queue_head = 0, init_queue_num = 0;
+/* The running workers, one bit for each worker slot, the worker is named by its slot */
+static rt_uint32_t init_worker_slots = 0;
+#endif
 
 /**
  * This function will get the first initialized AT device.
@@ -59,88 +107,1083 @@ struct at_device *at_device_get_first_initialized(void)
         }
     }
 
-    rt_hw_interrupt_enable(level);
-    
-    return RT_NULL;
+    rt_hw_interrupt_enable(level);
+    
+    return RT_NULL;
+}
+
+/**
+ * This function will get AT device by device name.
+ *
+ * @param type the name type
+ * @param name the device name or the client name
+ *
+ * @return the AT device structure pointer
+ */
+struct at_device *at_device_get_by_name(int type, const char *name)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(name);
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(at_device_list->list); node; node = rt_slist_next(node))
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device)
+        {
+            if (((type == AT_DEVICE_NAMETYPE_DEVICE) || (type == AT_DEVICE_NAMETYPE_NETDEV)) && 
+                (rt_strncmp(device->name, name, rt_strlen(name)) == 0))
+            {
+                rt_hw_interrupt_enable(level);
+                return device;
+            }
+            /* the AT client is got by the device initialization which may run in the worker pool */
+            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) && device->client &&
+                (rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0))
+            {                
+                rt_hw_interrupt_enable(level);
+                return device;
+            }
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+    
+    return RT_NULL;
+}
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will get AT device by ip address.
+ * 
+ * @param ip_addr input ip address
+ * network
+ * @return != NULL: network interface device object
+ *            NULL: get failed 
+ */
+struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(at_device_list->list); node; node = rt_slist_next(node))
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
+        {
+           rt_hw_interrupt_enable(level);
+           return device;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+    
+    return RT_NULL; 
+    
+}
+#endif /* AT_USING_SOCKET */
+
+
+/* Get the AT device index in registration order */
+static int at_device_get_index(struct at_device *device)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    int index = 0;
+
+    if (at_device_list == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(at_device_list->list); node; node = rt_slist_next(node), index++)
+    {
+        if (rt_slist_entry(node, struct at_device, list) == device)
+        {
+            rt_hw_interrupt_enable(level);
+            return index;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return -RT_ERROR;
+}
+
+/**
+ * This function will set the AT device network ready status, it's called by the AT device
+ * class when the device network initialize finished or the device network is set down.
+ *
+ * @param device the pointer of AT device structure
+ * @param is_ready the network is ready
+ */
+void at_device_set_ready(struct at_device *device, rt_bool_t is_ready)
+{
+#ifdef AT_USING_SOCKET
+    rt_base_t level;
+#endif
+    rt_uint32_t recved = 0;
+    int index = at_device_get_index(device);
+
+    if (index < 0 || index >= AT_DEVICE_READY_MAX)
+    {
+        return;
+    }
+
+#ifdef AT_USING_SOCKET
+    /* select the AT device for the new sockets before the ready waiters are woken up */
+    level = rt_hw_interrupt_disable();
+    if (is_ready)
+    {
+        placement_ready |= 1UL << index;
+    }
+    else
+    {
+        placement_ready &= ~(1UL << index);
+    }
+    rt_hw_interrupt_enable(level);
+
+    at_device_placement_update();
+#endif
+
+    if (is_ready)
+    {
+        rt_event_send(&at_device_ready_event, 1UL << index);
+#ifdef AT_USING_SOCKET
+        /* the network is initialized again, the socket operations are available */
+        rt_event_recv(device->socket_event, AT_DEVICE_EVENT_LINK_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_NO, &recved);
+#endif
+    }
+    else
+    {
+        rt_event_recv(&at_device_ready_event, 1UL << index, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_NO, &recved);
+    }
+}
+
+/**
+ * This function will wait the AT device network ready.
+ *
+ * @param device the pointer of AT device structure
+ * @param timeout the waiting timeout ticks
+ *
+ * @return = 0: the AT device network is ready
+ *         < 0: wait timeout or the device is not registered
+ */
+int at_device_wait_ready(struct at_device *device, rt_int32_t timeout)
+{
+    rt_uint32_t recved = 0;
+    int index = at_device_get_index(device);
+
+    RT_ASSERT(device);
+
+    if (index < 0 || index >= AT_DEVICE_READY_MAX)
+    {
+        LOG_E("AT device(%s) is not registered.", device->name);
+        return -RT_ERROR;
+    }
+
+    if (rt_event_recv(&at_device_ready_event, 1UL << index, RT_EVENT_FLAG_OR, timeout, &recved) != RT_EOK)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will wait the first AT device which network is ready.
+ *
+ * @param timeout the waiting timeout ticks
+ *
+ * @return != NULL: the first ready AT device object
+ *            NULL: wait timeout
+ */
+struct at_device *at_device_wait_first_ready(rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    rt_uint32_t recved = 0;
+    int index = 0;
+
+    if (rt_event_recv(&at_device_ready_event, (rt_uint32_t) ~0UL, RT_EVENT_FLAG_OR, timeout, &recved) != RT_EOK)
+    {
+        return RT_NULL;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(at_device_list->list); node; node = rt_slist_next(node), index++)
+    {
+        if (recved & (1UL << index))
+        {
+            rt_hw_interrupt_enable(level);
+            return rt_slist_entry(node, struct at_device, list);
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_NULL;
+}
+
+#ifdef AT_USING_SOCKET
+/* Check the AT device can be used to place the new sockets, the network is ready and the link is up,
+ * the initialization status can't be used as it's set after the network is initialized */
+static rt_bool_t at_device_placement_usable(struct at_device *device)
+{
+    int index = at_device_get_index(device);
+
+    if (index < 0 || index >= AT_DEVICE_READY_MAX || (placement_ready & (1UL << index)) == 0)
+    {
+        return RT_FALSE;
+    }
+
+    return (device->netdev && netdev_is_up(device->netdev) && netdev_is_link_up(device->netdev)) ? RT_TRUE : RT_FALSE;
+}
+
+/* Get the number of the sockets in use, the AT socket layer clears the socket when it's freed */
+static int at_device_placement_load(struct at_device *device)
+{
+    int idx = 0, count = 0;
+
+    for (idx = 0; idx < (int) device->socket_num; idx++)
+    {
+        if (device->sockets[idx].magic != 0)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* Get the signal strength (dBm), the lowest value if the device not supports it */
+static int at_device_placement_signal(struct at_device *device)
+{
+    int rssi = AT_DEVICE_SIGNAL_UNKNOWN;
+
+    /* the AT command can't be executed in the URC function of the device (e.g. link status changed) */
+    if (device->client && device->client->parser == rt_thread_self())
+    {
+        return AT_DEVICE_SIGNAL_UNKNOWN;
+    }
+
+    if (at_device_control(device, AT_DEVICE_CTRL_GET_SIGNAL, &rssi) != RT_EOK)
+    {
+        return AT_DEVICE_SIGNAL_UNKNOWN;
+    }
+
+    return rssi;
+}
+
+/**
+ * This function will set the placement policy of the new sockets.
+ *
+ * @param policy the placement policy, AT_DEVICE_PLACEMENT_FIRST, AT_DEVICE_PLACEMENT_LEAST_LOADED
+ *               or AT_DEVICE_PLACEMENT_BEST_SIGNAL
+ */
+void at_device_set_placement(int policy)
+{
+    placement_policy = policy;
+    placement_signal_tick = rt_tick_get() - rt_tick_from_millisecond(AT_DEVICE_PLACEMENT_SIGNAL_TIME);
+
+    at_device_placement_update();
+}
+
+/**
+ * This function will select the AT device for the new sockets by the placement policy, and set
+ * it as the default network interface device, so the AT socket layer creates the new sockets
+ * on it. The default network interface device which is not an AT device is not changed. It's
+ * called when the device network or link status changes and after each socket connect.
+ *
+ * @return != NULL: the selected AT device object
+ *            NULL: no initialized AT device
+ */
+struct at_device *at_device_placement_update(void)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL, *best = RT_NULL;
+    int value = 0, best_value = 0, best_load = 0;
+    rt_bool_t reuse_signal = RT_FALSE;
+
+    if (at_device_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    /* the signal strength is queried by AT commands, reuse the selection for a while */
+    if (placement_policy == AT_DEVICE_PLACEMENT_BEST_SIGNAL && placement_device &&
+            at_device_placement_usable(placement_device) &&
+            (rt_tick_get() - placement_signal_tick) < rt_tick_from_millisecond(AT_DEVICE_PLACEMENT_SIGNAL_TIME))
+    {
+        reuse_signal = RT_TRUE;
+        best = placement_device;
+    }
+
+    /* the AT devices are only appended, the list can be walked without lock */
+    for (node = &(at_device_list->list); node && reuse_signal == RT_FALSE; node = rt_slist_next(node))
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (at_device_placement_usable(device) == RT_FALSE)
+        {
+            continue;
+        }
+
+        if (placement_policy == AT_DEVICE_PLACEMENT_FIRST)
+        {
+            best = device;
+            break;
+        }
+        else if (placement_policy == AT_DEVICE_PLACEMENT_LEAST_LOADED)
+        {
+            value = at_device_placement_load(device);
+            if (best == RT_NULL || value < best_value)
+            {
+                best = device;
+                best_value = value;
+            }
+        }
+        else
+        {
+            /* the least loaded device is selected when the signal strength is the same */
+            value = at_device_placement_signal(device);
+            if (best == RT_NULL || value > best_value ||
+                    (value == best_value && at_device_placement_load(device) < best_load))
+            {
+                best = device;
+                best_value = value;
+                best_load = at_device_placement_load(device);
+            }
+            placement_signal_tick = rt_tick_get();
+        }
+    }
+
+    if (best == RT_NULL)
+    {
+        best = at_device_get_first_initialized();
+    }
+
+    if (best != placement_device)
+    {
+        LOG_D("the new sockets are placed on AT device(%s).", best ? best->name : "none");
+    }
+    placement_device = best;
+
+    /* don't change the default network interface device which is not an AT device */
+    if (best && best->netdev && netdev_default != best->netdev &&
+            (netdev_default == RT_NULL || at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev_default->name)))
+    {
+        netdev_set_default(best->netdev);
+    }
+
+    return best;
+}
+
+/**
+ * This function will get the AT device of the class to resolve the domain name. The AT socket
+ * layer calls the domain resolve function of the default network interface device class, so it's
+ * the AT device of the default network interface device, or the first initialized AT device of
+ * the class when the default one is not.
+ *
+ * @param class_id AT device class ID
+ *
+ * @return != NULL: the AT device object
+ *            NULL: no initialized AT device of the class
+ */
+struct at_device *at_device_get_resolver(uint16_t class_id)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    if (netdev_default)
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev_default->name);
+        if (device && device->is_init && device->class->class_id == class_id)
+        {
+            return device;
+        }
+    }
+
+    if (at_device_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(at_device_list->list); node; node = rt_slist_next(node))
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device->is_init && device->class->class_id == class_id)
+        {
+            rt_hw_interrupt_enable(level);
+            return device;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_NULL;
+}
+
+/**
+ * This function will probe the maximum data length of one send command by the AT command, the
+ * largest number in the response line of the keyword is taken, so the range form of the test
+ * command (e.g. "+CIPSEND: (0-9),(1-1500)") and the query form (e.g. "+CIPSEND: 0,1460") both
+ * work. The probed length is used by at_device_send_max().
+ *
+ * @param device the AT device object
+ * @param cmd the AT command line to query the send length
+ * @param keyword the keyword of the response line
+ *
+ * @return >0: the maximum send length
+ *         <0: send AT commands error or no send length in the response
+ */
+int at_device_probe_send_max(struct at_device *device, const char *cmd, const char *keyword)
+{
+    int value = 0, max = 0;
+    const char *line = RT_NULL;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(cmd && keyword);
+
+    resp = at_device_resp_take(device, 128, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) response structure.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    if (at_device_exec_cmd(device, resp, "%s", cmd) == RT_EOK &&
+            (line = at_resp_get_line_by_kw(resp, keyword)) != RT_NULL)
+    {
+        for (line += rt_strlen(keyword); *line; line++)
+        {
+            value = (*line >= '0' && *line <= '9') ? value * 10 + (*line - '0') : 0;
+            max = (value > max) ? value : max;
+        }
+    }
+
+    at_device_resp_release(device, resp);
+
+    /* the length of the unconnected link may be 0, it's not a usable limit */
+    if (max < AT_DEVICE_SEND_MIN)
+    {
+        LOG_D("AT device(%s) probe send length by %s failed, use the default.", device->name, cmd);
+        return -RT_ERROR;
+    }
+
+    device->send_max_size = max;
+    LOG_D("AT device(%s) maximum send length is %d.", device->name, max);
+
+    return max;
+}
+
+/**
+ * This function will get the data length of one send command for the socket type. The TCP data
+ * is sent in chunks of the probed length, or the class default length if it's not probed. The
+ * UDP datagram is never split, so it must fit in one send command and the UDP payload limit.
+ *
+ * @param device the AT device object
+ * @param type the socket type
+ * @param size the size of the data to send
+ * @param class_max the default maximum send length of the AT device class
+ *
+ * @return >0: the maximum data length of one send command
+ *          0: the UDP datagram is larger than the limit
+ */
+rt_size_t at_device_send_max(struct at_device *device, enum at_socket_type type, rt_size_t size, rt_size_t class_max)
+{
+    rt_size_t send_max = device->send_max_size ? device->send_max_size : class_max;
+
+    if (type == AT_SOCKET_UDP)
+    {
+        send_max = (send_max < AT_DEVICE_UDP_SEND_MAX) ? send_max : AT_DEVICE_UDP_SEND_MAX;
+        if (size > send_max)
+        {
+            LOG_E("AT device(%s) UDP datagram size(%d) is larger than the limit(%d).", device->name, size, send_max);
+            return 0;
+        }
+    }
+
+    return send_max;
+}
+
+/**
+ * This function will get the total length of the data segments.
+ *
+ * @param iov the data segments
+ * @param iovcnt the data segments number
+ *
+ * @return the total data length
+ */
+rt_size_t at_device_iov_len(const struct at_device_iovec *iov, int iovcnt)
+{
+    rt_size_t len = 0;
+    int idx;
+
+    for (idx = 0; idx < iovcnt; idx++)
+    {
+        len += iov[idx].len;
+    }
+
+    return len;
+}
+
+/**
+ * This function will copy the data of the data segments to one buffer.
+ *
+ * @param buff the destination buffer
+ * @param iov the data segments
+ * @param iovcnt the data segments number
+ * @param offset the data offset in the data segments
+ * @param len the data length to copy
+ *
+ * @return the copied data length
+ */
+rt_size_t at_device_iov_copy(char *buff, const struct at_device_iovec *iov, int iovcnt, rt_size_t offset, rt_size_t len)
+{
+    rt_size_t copied = 0, cur_len;
+    int idx;
+
+    for (idx = 0; idx < iovcnt && copied < len; idx++)
+    {
+        if (offset >= iov[idx].len)
+        {
+            offset -= iov[idx].len;
+            continue;
+        }
+
+        cur_len = (iov[idx].len - offset < len - copied) ? iov[idx].len - offset : len - copied;
+        rt_memcpy(buff + copied, (const char *) iov[idx].base + offset, cur_len);
+        copied += cur_len;
+        offset = 0;
+    }
+
+    return copied;
+}
+
+/**
+ * This function will send the data of the data segments by the AT client of the device, it's
+ * used by the class send operations after the send command is accepted, the segments are
+ * written to the AT client one by one.
+ *
+ * @param device the pointer of AT device structure
+ * @param iov the data segments
+ * @param iovcnt the data segments number
+ * @param offset the data offset in the data segments
+ * @param len the data length to send
+ *
+ * @return > 0: the sent data length
+ *           0: send failed
+ */
+rt_size_t at_device_iov_send(struct at_device *device, const struct at_device_iovec *iov, int iovcnt,
+                             rt_size_t offset, rt_size_t len)
+{
+    rt_size_t sent = 0, cur_len;
+    int idx;
+
+    for (idx = 0; idx < iovcnt && sent < len; idx++)
+    {
+        if (offset >= iov[idx].len)
+        {
+            offset -= iov[idx].len;
+            continue;
+        }
+
+        cur_len = (iov[idx].len - offset < len - sent) ? iov[idx].len - offset : len - sent;
+        if (at_client_obj_send(device->client, (const char *) iov[idx].base + offset, cur_len) == 0)
+        {
+            return 0;
+        }
+        sent += cur_len;
+        offset = 0;
+    }
+
+    return sent;
+}
+
+/**
+ * This function will send the data segments on the connected socket in order, e.g. the protocol
+ * header and the payload, the segments are streamed into the device send commands without
+ * being copied into one buffer.
+ *
+ * @param at_socket the AT socket number
+ * @param iov the data segments
+ * @param iovcnt the data segments number
+ *
+ * @return >=0: the size of send success
+ *         -10: the socket is not a connected AT socket, or no data segments
+ *         < 0: send failed
+ */
+int at_device_socket_sendv(int at_socket, const struct at_device_iovec *iov, int iovcnt)
+{
+    struct at_socket *socket = at_get_socket(at_socket);
+    struct at_device *device = RT_NULL;
+    rt_size_t len = 0;
+    char *buff = RT_NULL;
+    int result = 0;
+
+    if (socket == RT_NULL || socket->state != AT_SOCKET_CONNECT || iov == RT_NULL || iovcnt <= 0)
+    {
+        return -RT_EINVAL;
+    }
+    device = (struct at_device *) socket->device;
+
+    if (device->class->socket_sendv)
+    {
+        return device->class->socket_sendv(socket, iov, iovcnt, socket->type);
+    }
+
+    /* the device class without the vectored send operation sends the joined data */
+    len = at_device_iov_len(iov, iovcnt);
+    buff = (char *) rt_malloc(len);
+    if (buff == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) send data(%d).", device->name, len);
+        return -RT_ENOMEM;
+    }
+    at_device_iov_copy(buff, iov, iovcnt, 0, len);
+
+    result = device->class->socket_ops->at_send(socket, buff, len, socket->type);
+    rt_free(buff);
+
+    return result;
+}
+#endif /* AT_USING_SOCKET */
+
+/* claim a free response object in the index range, the index is returned or -1 if all are in use */
+static int at_device_resp_claim(struct at_device *device, int from, int to)
+{
+    int idx;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (idx = from; idx < to; idx++)
+    {
+        if ((device->resps_busy & (1UL << idx)) == 0)
+        {
+            device->resps_busy |= 1UL << idx;
+            rt_hw_interrupt_enable(level);
+            return idx;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return -1;
+}
+
+static struct at_device_resp *at_device_resp_get(struct at_device *device, at_response_t resp)
+{
+    struct at_device_resp *device_resp = (struct at_device_resp *) resp;
+
+    if (device_resp >= device->resps && device_resp < device->resps + AT_DEVICE_RESP_NUM)
+    {
+        return device_resp;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * This function will take one of the preallocated AT response objects of the AT device, the
+ * socket operations and the network interface queries use them without the heap allocation.
+ * The first AT_DEVICE_RESP_LOCK_NUM objects are only taken by the holder of the AT client lock
+ * (at_device_lock()), so the sending and receiving under the lock always find a free object
+ * while the other operations are waiting for their URCs. The response object is created on
+ * the heap when the buffer size is larger than AT_DEVICE_RESP_BUF_SIZE or all the usable
+ * preallocated objects are in use. The static memory build never uses the heap, it waits up to
+ * the response timeout for a free shared object instead.
+ *
+ * @param device the pointer of AT device structure
+ * @param buf_size the maximum response buffer size
+ * @param line_num the number of setting response lines, see at_create_resp
+ * @param timeout the maximum response time
+ *
+ * @return != RT_NULL: AT response object
+ *          = RT_NULL: no memory
+ */
+at_response_t at_device_resp_take(struct at_device *device, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    int idx = -1;
+    rt_bool_t is_owner;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device);
+
+    is_owner = (device->lock_owner && device->lock_owner == rt_thread_self());
+
+#ifdef AT_DEVICE_USING_STATIC
+    if (buf_size > AT_DEVICE_RESP_BUF_SIZE)
+    {
+        LOG_E("AT device(%s) response buffer(%d) is larger than AT_DEVICE_RESP_BUF_SIZE.", device->name, buf_size);
+        return RT_NULL;
+    }
+
+    if (is_owner)
+    {
+        idx = at_device_resp_claim(device, 0, AT_DEVICE_RESP_LOCK_NUM);
+    }
+
+    /* no heap is used in the static memory build, wait for a free shared response object */
+    if (idx < 0 && rt_sem_take(&(device->resp_sem), is_owner ? 0 : timeout) == RT_EOK)
+    {
+        idx = at_device_resp_claim(device, AT_DEVICE_RESP_LOCK_NUM, AT_DEVICE_RESP_NUM);
+    }
+
+    if (idx < 0)
+    {
+        LOG_E("AT device(%s) wait for the free response object timeout.", device->name);
+        return RT_NULL;
+    }
+#else
+    if (buf_size <= AT_DEVICE_RESP_BUF_SIZE)
+    {
+        idx = at_device_resp_claim(device, is_owner ? 0 : AT_DEVICE_RESP_LOCK_NUM, AT_DEVICE_RESP_NUM);
+    }
+
+    if (idx < 0)
+    {
+        /* the counter is updated without lock as the other statistics counters */
+        device->stats.resp_allocs++;
+        LOG_D("AT device(%s) response object(%d) created on the heap.", device->name, buf_size);
+        return at_create_resp(buf_size, line_num, timeout);
+    }
+#endif /* AT_DEVICE_USING_STATIC */
+
+    resp = &(device->resps[idx].resp);
+    resp->buf = device->resps[idx].buf;
+    resp->buf_size = buf_size;
+    resp->line_num = line_num;
+    resp->line_counts = 0;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+/**
+ * This function will change the buffer size, the response lines and the timeout of the AT
+ * response object taken by at_device_resp_take(), it's used instead of at_resp_set_info().
+ *
+ * @param device the pointer of AT device structure
+ * @param resp AT response object
+ * @param buf_size the maximum response buffer size
+ * @param line_num the number of setting response lines
+ * @param timeout the maximum response time
+ *
+ * @return != RT_NULL: AT response object, it may be a different object when the buffer grows
+ *          = RT_NULL: no memory, the original response object is released
+ */
+at_response_t at_device_resp_set_info(struct at_device *device, at_response_t resp,
+                                      rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(resp);
+
+    if (at_device_resp_get(device, resp) == RT_NULL)
+    {
+        return at_resp_set_info(resp, buf_size, line_num, timeout);
+    }
+
+    /* the response buffer grows beyond the preallocated buffer */
+    if (buf_size > AT_DEVICE_RESP_BUF_SIZE)
+    {
+        at_device_resp_release(device, resp);
+#ifdef AT_DEVICE_USING_STATIC
+        LOG_E("AT device(%s) response buffer(%d) is larger than AT_DEVICE_RESP_BUF_SIZE.", device->name, buf_size);
+        return RT_NULL;
+#else
+        return at_create_resp(buf_size, line_num, timeout);
+#endif
+    }
+
+    resp->buf_size = buf_size;
+    resp->line_num = line_num;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+/**
+ * This function will release the AT response object taken by at_device_resp_take().
+ *
+ * @param device the pointer of AT device structure
+ * @param resp AT response object
+ */
+void at_device_resp_release(struct at_device *device, at_response_t resp)
+{
+    int idx;
+    rt_base_t level;
+    struct at_device_resp *device_resp = RT_NULL;
+
+    RT_ASSERT(device);
+
+    if (resp == RT_NULL)
+    {
+        return;
+    }
+
+    device_resp = at_device_resp_get(device, resp);
+    if (device_resp == RT_NULL)
+    {
+        at_delete_resp(resp);
+        return;
+    }
+
+    idx = device_resp - device->resps;
+
+    level = rt_hw_interrupt_disable();
+    device->resps_busy &= ~(1UL << idx);
+    rt_hw_interrupt_enable(level);
+
+#ifdef AT_DEVICE_USING_STATIC
+    if (idx >= AT_DEVICE_RESP_LOCK_NUM)
+    {
+        rt_sem_release(&(device->resp_sem));
+    }
+#endif
+}
+
+/**
+ * This function will allocate the network interface device object of the AT device, it's the
+ * object in the AT device structure in the static memory build.
+ *
+ * @param device the pointer of AT device structure
+ *
+ * @return != RT_NULL: network interface device object, it's cleared
+ *          = RT_NULL: no memory
+ */
+struct netdev *at_device_netdev_alloc(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+#ifdef AT_DEVICE_USING_STATIC
+    rt_memset(&(device->netdev_obj), 0x00, sizeof(struct netdev));
+    return &(device->netdev_obj);
+#else
+    return (struct netdev *) rt_calloc(1, sizeof(struct netdev));
+#endif
+}
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will allocate the received data buffer of the AT device socket, the buffer is
+ * passed to the AT socket layer which frees it by rt_free() after the data is read. The buffer
+ * comes from the received data heap of the device in the static memory build, the data is
+ * dropped when the heap is full and the application doesn't read the sockets.
+ *
+ * @param device the pointer of AT device structure
+ * @param size the buffer size
+ *
+ * @return != RT_NULL: received data buffer, it's cleared
+ *          = RT_NULL: no memory
+ */
+void *at_device_recv_alloc(struct at_device *device, rt_size_t size)
+{
+#ifdef AT_DEVICE_USING_STATIC
+    void *buf = RT_NULL;
+#endif
+
+    RT_ASSERT(device);
+
+#ifdef AT_DEVICE_USING_STATIC
+    buf = rt_memheap_alloc(&(device->recv_heap), size);
+    if (buf)
+    {
+        rt_memset(buf, 0x00, size);
+    }
+
+    return buf;
+#else
+    return rt_calloc(1, size);
+#endif
 }
+#endif /* AT_USING_SOCKET */
 
 /**
- * This function will get AT device by device name.
+ * This function will execute the AT command by the AT client of the AT device, the issued
+ * command is counted in the AT device statistics counters.
  *
- * @param type the name type
- * @param name the device name or the client name
+ * @param device the pointer of AT device structure
+ * @param resp AT response object, using RT_NULL when you don't care response
+ * @param cmd_expr AT commands expression
  *
- * @return the AT device structure pointer
+ * @return = 0: execute successfully
+ *         < 0: execute failed, see at_obj_exec_cmd
  */
-struct at_device *at_device_get_by_name(int type, const char *name)
+int at_device_exec_cmd(struct at_device *device, at_response_t resp, const char *cmd_expr, ...)
 {
-    rt_base_t level;
-    rt_slist_t *node = RT_NULL;
-    struct at_device *device = RT_NULL;
+    char cmd[AT_CMD_MAX_LEN] = {0};
+    va_list args;
+    int result = RT_EOK;
+#ifdef AT_DEVICE_USING_PROFILE
+    rt_tick_t start_tick = rt_tick_get();
+#endif
 
-    RT_ASSERT(name);
+    RT_ASSERT(device);
+    RT_ASSERT(cmd_expr);
 
-    level = rt_hw_interrupt_disable();
+    va_start(args, cmd_expr);
+    rt_vsnprintf(cmd, sizeof(cmd), cmd_expr, args);
+    va_end(args);
 
-    for (node = &(at_device_list->list); node; node = rt_slist_next(node))
+    at_device_stats_update(device, -1, AT_DEVICE_STATS_CMD, 1);
+#ifdef AT_DEVICE_USING_TRACE
+    at_device_trace(device, AT_DEVICE_STATS_CMD, -1, rt_strlen(cmd), 0, cmd);
+#endif
+
+    result = at_obj_exec_cmd(device->client, resp, "%s", cmd);
+
+#ifdef AT_DEVICE_USING_TRACE
+    at_device_trace(device, AT_DEVICE_TRACE_RESP, -1, resp ? resp->line_counts : 0, result,
+                    (resp && resp->line_counts > 0) ? at_resp_get_line(resp, resp->line_counts) : RT_NULL);
+#endif
+
+#ifdef AT_DEVICE_USING_PROFILE
+    at_device_profile_cmd(device, cmd, start_tick);
+#endif
+
+    return result;
+}
+
+static void at_device_stats_time(rt_uint32_t *count, rt_uint32_t *total, rt_uint32_t *max, rt_tick_t start_tick)
+{
+    rt_uint32_t value = (rt_tick_get() - start_tick) * 1000 / RT_TICK_PER_SECOND;
+
+    (*count)++;
+    *total += value;
+    if (value > *max)
     {
-        device = rt_slist_entry(node, struct at_device, list);
-        if (device)
-        {
-            if (((type == AT_DEVICE_NAMETYPE_DEVICE) || (type == AT_DEVICE_NAMETYPE_NETDEV)) && 
-                (rt_strncmp(device->name, name, rt_strlen(name)) == 0))
-            {
-                rt_hw_interrupt_enable(level);
-                return device;
-            }
-            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) && 
-                (rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0))
-            {                
-                rt_hw_interrupt_enable(level);
-                return device;
-            }
-        }
+        *max = value;
     }
-
-    rt_hw_interrupt_enable(level);
-    
-    return RT_NULL;
 }
 
-#ifdef AT_USING_SOCKET
 /**
- * This function will get AT device by ip address.
- * 
- * @param ip_addr input ip address
- * network
- * @return != NULL: network interface device object
- *            NULL: get failed 
+ * This function will update the AT device statistics counters, the counters are updated
+ * without lock and they are only used for the performance analysis.
+ *
+ * @param device the pointer of AT device structure
+ * @param socket the device socket number, -1 for the device counters only
+ * @param type the counter type, AT_DEVICE_STATS_XXX
+ * @param value the bytes number, or the operation start tick of the latency counters
  */
-struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
+void at_device_stats_update(struct at_device *device, int socket, int type, rt_uint32_t value)
 {
-    rt_base_t level;
-    rt_slist_t *node = RT_NULL;
-    struct at_device *device = RT_NULL;
+    struct at_device_stats *stats = RT_NULL;
+    struct at_device_socket_stats *socket_stats = RT_NULL;
 
-    level = rt_hw_interrupt_disable();
+    if (device == RT_NULL)
+    {
+        return;
+    }
+    stats = &(device->stats);
 
-    for (node = &(at_device_list->list); node; node = rt_slist_next(node))
+#ifdef AT_USING_SOCKET
+    if (socket >= 0 && socket < (int) device->socket_num && device->socket_stats)
     {
-        device = rt_slist_entry(node, struct at_device, list);
-        if (device && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
+        socket_stats = &(device->socket_stats[socket]);
+    }
+#endif
+
+    switch (type)
+    {
+    case AT_DEVICE_STATS_CMD:
+        stats->cmds += value;
+        break;
+    case AT_DEVICE_STATS_URC:
+        stats->urcs += value;
+        break;
+    case AT_DEVICE_STATS_SEND:
+        stats->socket.send_bytes += value;
+        stats->socket.send_chunks++;
+        if (socket_stats)
         {
-           rt_hw_interrupt_enable(level);
-           return device;
+            socket_stats->send_bytes += value;
+            socket_stats->send_chunks++;
+        }
+        break;
+    case AT_DEVICE_STATS_SEND_FAIL:
+        stats->socket.send_fails++;
+        if (socket_stats)
+        {
+            socket_stats->send_fails++;
+        }
+        break;
+    case AT_DEVICE_STATS_RECV:
+        stats->socket.recv_bytes += value;
+        if (socket_stats)
+        {
+            socket_stats->recv_bytes += value;
+        }
+        break;
+    case AT_DEVICE_STATS_RECV_DROP:
+        stats->socket.recv_drops++;
+        if (socket_stats)
+        {
+            socket_stats->recv_drops++;
         }
+        break;
+    case AT_DEVICE_STATS_CONNECT:
+        /* the socket counters and the coalescing are restarted by the new connection */
+        if (socket_stats)
+        {
+            rt_memset(socket_stats, 0x00, sizeof(struct at_device_socket_stats));
+        }
+#ifdef AT_USING_SOCKET
+        at_device_coalesce_reset(device, socket);
+        at_device_udp_reset(device, socket);
+#endif
+        at_device_stats_time(&(stats->connects), &(stats->connect_time), &(stats->connect_time_max), value);
+        break;
+    case AT_DEVICE_STATS_RESOLVE:
+        at_device_stats_time(&(stats->resolves), &(stats->resolve_time), &(stats->resolve_time_max), value);
+        break;
+    default:
+        break;
     }
 
-    rt_hw_interrupt_enable(level);
-    
-    return RT_NULL; 
-    
+#ifdef AT_DEVICE_USING_TRACE
+    if (type == AT_DEVICE_STATS_CONNECT || type == AT_DEVICE_STATS_RESOLVE)
+    {
+        /* the latency events record the latency in milliseconds */
+        value = (rt_tick_get() - value) * 1000 / RT_TICK_PER_SECOND;
+    }
+    if (type != AT_DEVICE_STATS_CMD && type != AT_DEVICE_STATS_URC)
+    {
+        at_device_trace(device, (rt_uint8_t) type, socket, value, 0, RT_NULL);
+    }
+#endif
 }
-#endif /* AT_USING_SOCKET */
 
+/**
+ * This function will count the dispatched socket URC and record its head line in the trace.
+ *
+ * @param device the pointer of AT device structure
+ * @param data the URC data
+ */
+void at_device_stats_urc(struct at_device *device, const char *data)
+{
+    at_device_stats_update(device, -1, AT_DEVICE_STATS_URC, 1);
+#ifdef AT_DEVICE_USING_TRACE
+    if (device)
+    {
+        at_device_trace(device, AT_DEVICE_STATS_URC, -1, rt_strlen(data), 0, data);
+    }
+#endif
+}
 
 /**
  * This function will perform a variety of control functions on AT devices.
@@ -154,9 +1197,58 @@ struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
  */
 int at_device_control(struct at_device *device, int cmd, void *arg)
 {
+    int result = RT_EOK;
+
+    /* the statistics counters are supported by all AT devices */
+    if (cmd == AT_DEVICE_CTRL_GET_STATS)
+    {
+        RT_ASSERT(arg);
+
+        rt_memcpy(arg, &(device->stats), sizeof(struct at_device_stats));
+        return RT_EOK;
+    }
+
+#ifdef AT_USING_SOCKET
+    /* the socket small writes coalescing is supported by all AT devices */
+    if (cmd == AT_DEVICE_CTRL_SOCKET_COALESCE || cmd == AT_DEVICE_CTRL_SOCKET_FLUSH)
+    {
+        struct at_device_socket_coalesce *coalesce = (struct at_device_socket_coalesce *) arg;
+        struct at_socket *socket = RT_NULL;
+        int at_socket = 0;
+
+        RT_ASSERT(arg);
+
+        at_socket = (cmd == AT_DEVICE_CTRL_SOCKET_FLUSH) ? *((int *) arg) : coalesce->socket;
+        socket = at_get_socket(at_socket);
+        if (socket == RT_NULL || socket->device != device)
+        {
+            return -RT_EINVAL;
+        }
+
+        if (cmd == AT_DEVICE_CTRL_SOCKET_FLUSH)
+        {
+            return at_device_coalesce_flush(at_socket);
+        }
+        return at_device_coalesce_set(at_socket, coalesce->enable, coalesce->delay);
+    }
+#endif /* AT_USING_SOCKET */
+
     if (device->class->device_ops->control)
     {
-        return device->class->device_ops->control(device, cmd, arg);
+        result = device->class->device_ops->control(device, cmd, arg);
+
+        /* record the sleep status and the sleep time (milliseconds) argument, the socket data
+         * is queued while the device is sleeping */
+        if (result == RT_EOK && cmd == AT_DEVICE_CTRL_SLEEP)
+        {
+            at_device_sleep_set(device, RT_TRUE, arg ? *((rt_uint32_t *) arg) : 0);
+        }
+        else if (result == RT_EOK && cmd == AT_DEVICE_CTRL_WAKEUP)
+        {
+            at_device_sleep_set(device, RT_FALSE, 0);
+        }
+
+        return result;
     }
     else
     {
@@ -179,6 +1271,16 @@ int at_device_class_register(struct at_device_class *class, uint16_t class_id)
 
     RT_ASSERT(class);
 
+#ifdef AT_USING_SOCKET
+    /* every device socket has its own bit in the socket event */
+    if (class->socket_num > AT_DEVICE_EVENT_SOCKETS_MAX)
+    {
+        LOG_E("AT device class(%d) sockets number(%d) is more than %d.", class_id,
+              class->socket_num, AT_DEVICE_EVENT_SOCKETS_MAX);
+        return -RT_ERROR;
+    }
+#endif
+
     /* Fill AT device class */
     class->class_id = class_id;
 
@@ -233,6 +1335,87 @@ static struct at_device_class *at_device_class_get(uint16_t class_id)
     return RT_NULL;
 }
 
+#ifdef AT_DEVICE_USING_INIT_POOL
+static void at_device_init_worker_entry(void *parameter)
+{
+    rt_base_t level;
+    int slot = (int) (rt_ubase_t) parameter;
+    struct at_device *device = RT_NULL;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+
+        /* exit the worker when no AT device waiting for initialization */
+        if (init_queue_num == 0)
+        {
+            init_worker_slots &= ~(1UL << slot);
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        device = at_device_init_queue[init_queue_head];
+        init_queue_head = (init_queue_head + 1) % AT_DEVICE_INIT_QUEUE_SIZE;
+        init_queue_num--;
+
+        rt_hw_interrupt_enable(level);
+
+        /* initialize AT device, the device network is initialized synchronously in the worker */
+        device->is_init = (device->class->device_ops->init(device) < 0) ? RT_FALSE : RT_TRUE;
+    }
+}
+
+/* submit the AT device to the initialization worker pool, the devices are initialized concurrently */
+static int at_device_init_submit(struct at_device *device)
+{
+    rt_base_t level;
+    rt_thread_t tid = RT_NULL;
+    int slot = -1;
+    char name[RT_NAME_MAX] = {0};
+
+    level = rt_hw_interrupt_disable();
+
+    if (init_queue_num >= AT_DEVICE_INIT_QUEUE_SIZE)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EFULL;
+    }
+
+    at_device_init_queue[(init_queue_head + init_queue_num) % AT_DEVICE_INIT_QUEUE_SIZE] = device;
+    init_queue_num++;
+
+    /* claim a free worker slot while the pool is not full */
+    for (slot = 0; slot < AT_DEVICE_INIT_POOL_SIZE; slot++)
+    {
+        if ((init_worker_slots & (1UL << slot)) == 0)
+        {
+            init_worker_slots |= (1UL << slot);
+            break;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    if (slot < AT_DEVICE_INIT_POOL_SIZE)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "at_init%d", slot);
+        tid = rt_thread_create(name, at_device_init_worker_entry, (void *) (rt_ubase_t) slot,
+                               AT_DEVICE_INIT_POOL_STACK_SIZE, AT_DEVICE_INIT_POOL_PRIORITY, 20);
+        if (tid)
+        {
+            rt_thread_startup(tid);
+        }
+        else
+        {
+            LOG_W("create AT device initialization worker failed, initialize device synchronously.");
+            at_device_init_worker_entry((void *) (rt_ubase_t) slot);
+        }
+    }
+
+    return RT_EOK;
+}
+#endif /* AT_DEVICE_USING_INIT_POOL */
+
 /**
  * This function registers an AT device with specified device name and AT client name.
  *
@@ -251,8 +1434,14 @@ int at_device_register(struct at_device *device, const char *device_name,
     rt_base_t level;
     int result = 0;
     static int device_counts = 0;
+#ifdef AT_DEVICE_USING_STATIC
+    static int resp_counts = 0;
+#endif
     char name[RT_NAME_MAX] = {0};
     struct at_device_class *class = RT_NULL;
+#ifdef AT_USING_SOCKET
+    rt_uint32_t idx = 0;
+#endif
 
     RT_ASSERT(device);
     RT_ASSERT(device_name);
@@ -268,6 +1457,23 @@ int at_device_register(struct at_device *device, const char *device_name,
 
     /* Fill AT device object*/
 #ifdef AT_USING_SOCKET
+    /* the device uses the sockets up to the class maximum (the module limit) */
+    if (device->socket_num == 0 || device->socket_num > class->socket_num)
+    {
+        device->socket_num = class->socket_num;
+    }
+
+    /* the AT socket layer allocates the sockets in the class maximum, the sockets beyond the */
+    /* device sockets number are reserved */
+#ifdef AT_DEVICE_USING_STATIC
+    if (device->sockets == RT_NULL || device->socket_stats == RT_NULL || device->recv_pool == RT_NULL)
+    {
+        LOG_E("AT device(%s) static memory is not bound, see AT_DEVICE_STATIC_BIND.", device_name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    rt_memset(device->sockets, 0x00, class->socket_num * sizeof(struct at_socket));
+#else
     device->sockets = (struct at_socket *) rt_calloc(class->socket_num, sizeof(struct at_socket));
     if (device->sockets == RT_NULL)
     {
@@ -275,6 +1481,37 @@ int at_device_register(struct at_device *device, const char *device_name,
         result = -RT_ENOMEM;
         goto __exit;
     }
+#endif
+
+    for (idx = device->socket_num; idx < class->socket_num; idx++)
+    {
+        device->sockets[idx].magic = AT_DEVICE_SOCKET_RESERVED;
+    }
+
+#ifdef AT_DEVICE_USING_STATIC
+    rt_memset(device->socket_stats, 0x00, device->socket_num * sizeof(struct at_device_socket_stats));
+
+    /* initialize AT device socket event and received data heap */
+    rt_snprintf(name, RT_NAME_MAX, "at_se%d", device_counts);
+    rt_event_init(&(device->socket_event_obj), name, RT_IPC_FLAG_FIFO);
+    device->socket_event = &(device->socket_event_obj);
+
+    rt_snprintf(name, RT_NAME_MAX, "at_rh%d", device_counts++);
+    if (rt_memheap_init(&(device->recv_heap), name, device->recv_pool, device->recv_pool_size) != RT_EOK)
+    {
+        LOG_E("AT device(%s) received data heap initialize failed.", device_name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+#else
+    device->socket_stats = (struct at_device_socket_stats *) rt_calloc(device->socket_num,
+            sizeof(struct at_device_socket_stats));
+    if (device->socket_stats == RT_NULL)
+    {
+        LOG_E("no memory for AT Socket number(%d) statistics create.", device->socket_num);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
 
     /* create AT device socket event */
     rt_snprintf(name, RT_NAME_MAX, "at_se%d", device_counts++);
@@ -285,11 +1522,19 @@ int at_device_register(struct at_device *device, const char *device_name,
         result = -RT_ENOMEM;
         goto __exit;
     }
+#endif /* AT_DEVICE_USING_STATIC */
 #endif /* AT_USING_SOCKET */
 
     rt_memcpy(device->name, device_name, rt_strlen(device_name));
     device->class = class;
     device->user_data = user_data;
+    device->resps_busy = 0;
+    device->lock_owner = RT_NULL;
+    device->lock_depth = 0;
+#ifdef AT_DEVICE_USING_STATIC
+    rt_snprintf(name, RT_NAME_MAX, "at_rs%d", resp_counts++);
+    rt_sem_init(&(device->resp_sem), name, AT_DEVICE_RESP_NUM - AT_DEVICE_RESP_LOCK_NUM, RT_IPC_FLAG_FIFO);
+#endif
 
     /* Initialize current AT device single list */
     rt_slist_init(&(device->list));
@@ -308,7 +1553,15 @@ int at_device_register(struct at_device *device, const char *device_name,
     }
 
     rt_hw_interrupt_enable(level);
-  
+
+#ifdef AT_DEVICE_USING_INIT_POOL
+    /* Initialize AT device in the initialization worker pool, the worker sets initialization status */
+    if (at_device_init_submit(device) == RT_EOK)
+    {
+        return RT_EOK;
+    }
+#endif
+
     /* Initialize AT device */
     result = class->device_ops->init(device);
     if (result < 0)
@@ -328,3 +1581,132 @@ __exit:
 
     return RT_EOK;
 }
+
+static int at_device_ready_event_init(void)
+{
+    return rt_event_init(&at_device_ready_event, "at_ready", RT_IPC_FLAG_FIFO);
+}
+INIT_PREV_EXPORT(at_device_ready_event_init);
+
+#ifdef FINSH_USING_MSH
+#include <finsh.h>
+
+static void at_device_stats_show(struct at_device *device)
+{
+    struct at_device_stats *stats = &(device->stats);
+#ifdef AT_USING_SOCKET
+    struct at_device_socket_stats *socket_stats = RT_NULL;
+    int i;
+#endif
+
+    rt_kprintf("device %s: cmds %d, urcs %d, heap responses %d\n", device->name, stats->cmds, stats->urcs,
+               stats->resp_allocs);
+    rt_kprintf("  send %d bytes, %d chunks, %d fails; recv %d bytes, %d drops\n",
+               stats->socket.send_bytes, stats->socket.send_chunks, stats->socket.send_fails,
+               stats->socket.recv_bytes, stats->socket.recv_drops);
+#if defined(AT_DEVICE_USING_STATIC) && defined(AT_USING_SOCKET)
+    rt_kprintf("  recv heap %d bytes, %d available, max used %d\n", device->recv_heap.pool_size,
+               device->recv_heap.available_size, device->recv_heap.max_used_size);
+#endif
+    rt_kprintf("  connect %d, avg %d ms, max %d ms; resolve %d, avg %d ms, max %d ms\n",
+               stats->connects, stats->connects ? stats->connect_time / stats->connects : 0,
+               stats->connect_time_max, stats->resolves,
+               stats->resolves ? stats->resolve_time / stats->resolves : 0, stats->resolve_time_max);
+
+#ifdef AT_USING_SOCKET
+    for (i = 0; device->socket_stats && i < (int) device->socket_num; i++)
+    {
+        socket_stats = &(device->socket_stats[i]);
+        if (device->sockets[i].magic == 0 && socket_stats->send_chunks == 0 && socket_stats->recv_bytes == 0)
+        {
+            continue;
+        }
+
+        rt_kprintf("  socket %d: send %d bytes, %d chunks, %d fails; recv %d bytes, %d drops\n", i,
+                   socket_stats->send_bytes, socket_stats->send_chunks, socket_stats->send_fails,
+                   socket_stats->recv_bytes, socket_stats->recv_drops);
+    }
+#endif /* AT_USING_SOCKET */
+}
+
+static int at_device_stats(int argc, char **argv)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    if (argc == 3)
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, argv[2]);
+        if (device == RT_NULL)
+        {
+            rt_kprintf("AT device(%s) not found.\n", argv[2]);
+            return -RT_ERROR;
+        }
+
+        at_device_stats_show(device);
+        return RT_EOK;
+    }
+
+    for (node = at_device_list ? &(at_device_list->list) : RT_NULL; node; node = rt_slist_next(node))
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        at_device_stats_show(device);
+    }
+
+    return RT_EOK;
+}
+
+static int at_device(int argc, char **argv)
+{
+    if (argc >= 2 && rt_strcmp(argv[1], "stats") == 0)
+    {
+        return at_device_stats(argc, argv);
+    }
+#ifdef AT_DEVICE_USING_PROFILE
+    else if (argc == 3 && rt_strcmp(argv[1], "profile") == 0 && rt_strcmp(argv[2], "reset") == 0)
+    {
+        at_device_profile_reset();
+        return RT_EOK;
+    }
+    else if (argc >= 2 && rt_strcmp(argv[1], "profile") == 0)
+    {
+        struct at_device *device = RT_NULL;
+
+        if (argc == 3 && (device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, argv[2])) == RT_NULL)
+        {
+            rt_kprintf("AT device(%s) not found.\n", argv[2]);
+            return -RT_ERROR;
+        }
+
+        at_device_profile_dump(device);
+        return RT_EOK;
+    }
+#endif /* AT_DEVICE_USING_PROFILE */
+#ifdef AT_DEVICE_USING_TRACE
+    else if (argc == 3 && rt_strcmp(argv[1], "trace") == 0 && rt_strcmp(argv[2], "reset") == 0)
+    {
+        at_device_trace_reset();
+        return RT_EOK;
+    }
+    else if (argc == 2 && rt_strcmp(argv[1], "trace") == 0)
+    {
+        at_device_trace_dump();
+        return RT_EOK;
+    }
+#endif /* AT_DEVICE_USING_TRACE */
+
+    rt_kprintf("Usage:\n");
+    rt_kprintf("at_device stats [device name]   - show the AT device statistics counters\n");
+#ifdef AT_DEVICE_USING_PROFILE
+    rt_kprintf("at_device profile [device name] - dump the AT command latency and lock time\n");
+    rt_kprintf("at_device profile reset         - reset the AT device profiling data\n");
+#endif
+#ifdef AT_DEVICE_USING_TRACE
+    rt_kprintf("at_device trace                 - dump the AT device trace ring buffer\n");
+    rt_kprintf("at_device trace reset           - clear the AT device trace ring buffer\n");
+#endif
+
+    return RT_EOK;
+}
+MSH_CMD_EXPORT(at_device, AT device management commands);
+#endif /* FINSH_USING_MSH */
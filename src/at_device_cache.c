@@ -0,0 +1,172 @@
+/*
+ * File      : at_device_cache.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_DEVICE_USING_CACHE
+
+/* The key of the module identity, all cached values are invalid when it changes */
+#define AT_DEVICE_CACHE_IDENTITY_KEY   "identity"
+
+/* The registered persistent cache backend */
+static const struct at_device_cache_ops *at_device_cache_ops = RT_NULL;
+
+/**
+ * This function registers the persistent cache backend for all AT devices.
+ *
+ * @param ops the cache backend operations
+ *
+ * @return 0: register successfully
+ */
+int at_device_cache_register(const struct at_device_cache_ops *ops)
+{
+    RT_ASSERT(ops);
+    RT_ASSERT(ops->read && ops->write && ops->erase);
+
+    at_device_cache_ops = ops;
+
+    return RT_EOK;
+}
+
+/* the identity with an empty field (e.g. the module information isn't parsed) can't identify the module */
+static rt_bool_t at_device_cache_identity_valid(const char *identity)
+{
+    const char *field = identity;
+
+    while (1)
+    {
+        if (*field == '\0' || *field == ',')
+        {
+            return RT_FALSE;
+        }
+
+        field = strchr(field, ',');
+        if (field == RT_NULL)
+        {
+            return RT_TRUE;
+        }
+        field++;
+    }
+}
+
+/**
+ * This function will check the cached module identity of the AT device, the cached values
+ * are erased and the new identity is saved when the identity (module, SIM card, firmware)
+ * changes. The cached values are also erased when the identity has an empty field, and the
+ * identity isn't saved.
+ *
+ * @param device the pointer of AT device structure
+ * @param identity current module identity string, the comma separated fields
+ *
+ * @return = 0: the cached values are valid
+ *         < 0: no cache backend or the cached values are invalid
+ */
+int at_device_cache_check(struct at_device *device, const char *identity)
+{
+    char cached[AT_DEVICE_CACHE_IDENTITY_LEN] = {0};
+
+    RT_ASSERT(device);
+    RT_ASSERT(identity);
+
+    if (at_device_cache_ops == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    if (at_device_cache_identity_valid(identity) == RT_FALSE)
+    {
+        LOG_W("AT device(%s) identity(%s) is invalid, the cache isn't used.", device->name, identity);
+        at_device_cache_ops->erase(device->name);
+        return -RT_ERROR;
+    }
+
+    if (at_device_cache_ops->read(device->name, AT_DEVICE_CACHE_IDENTITY_KEY, cached, sizeof(cached)) == RT_EOK &&
+            rt_strcmp(cached, identity) == 0)
+    {
+        return RT_EOK;
+    }
+
+    LOG_D("AT device(%s) identity changed, erase the cached values.", device->name);
+
+    at_device_cache_ops->erase(device->name);
+    at_device_cache_ops->write(device->name, AT_DEVICE_CACHE_IDENTITY_KEY, identity);
+
+    return -RT_ERROR;
+}
+
+/**
+ * This function will get the cached value of the AT device, it should be called
+ * after the module identity is checked by at_device_cache_check().
+ *
+ * @param device the pointer of AT device structure
+ * @param key the cached value key
+ * @param value the buffer to store the cached value
+ * @param size the buffer size
+ *
+ * @return = 0: get the cached value successfully
+ *         < 0: no cache backend or the value is not cached
+ */
+int at_device_cache_get(struct at_device *device, const char *key, char *value, rt_size_t size)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(key && value);
+
+    if (at_device_cache_ops == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    return at_device_cache_ops->read(device->name, key, value, size);
+}
+
+/**
+ * This function will save the value to the cache of the AT device.
+ *
+ * @param device the pointer of AT device structure
+ * @param key the cached value key
+ * @param value the value string
+ *
+ * @return = 0: save the value successfully
+ *         < 0: no cache backend or save failed
+ */
+int at_device_cache_set(struct at_device *device, const char *key, const char *value)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(key && value);
+
+    if (at_device_cache_ops == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    return at_device_cache_ops->write(device->name, key, value);
+}
+
+#endif /* AT_DEVICE_USING_CACHE */
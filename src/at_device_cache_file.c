@@ -0,0 +1,240 @@
+/*
+ * File      : at_device_cache_file.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#if defined(AT_DEVICE_USING_CACHE) && defined(AT_DEVICE_CACHE_USING_FILE)
+
+#ifndef RT_USING_DFS
+#error "The AT device file cache backend depends on the DFS component, please enable RT_USING_DFS!"
+#endif
+
+#include <dfs_posix.h>
+
+#ifndef AT_DEVICE_CACHE_FILE_SIZE
+#define AT_DEVICE_CACHE_FILE_SIZE      512
+#endif
+
+#define AT_DEVICE_CACHE_PATH_LEN       64
+
+/* The cache files directory, one "<device name>.cache" file for each AT device */
+static char cache_path[AT_DEVICE_CACHE_PATH_LEN] = {0};
+
+static void cache_file_name(const char *name, char *file_name, rt_size_t size)
+{
+    rt_snprintf(file_name, size, "%s/%s.cache", cache_path, name);
+}
+
+/* load the whole cache file, the content is "key=value" lines */
+static int cache_file_load(const char *name, char *buf, rt_size_t size)
+{
+    int fd, len;
+    char file_name[AT_DEVICE_CACHE_PATH_LEN + RT_NAME_MAX + 8] = {0};
+
+    cache_file_name(name, file_name, sizeof(file_name));
+
+    fd = open(file_name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        buf[0] = '\0';
+        return 0;
+    }
+
+    len = read(fd, buf, size - 1);
+    close(fd);
+
+    len = (len < 0) ? 0 : len;
+    buf[len] = '\0';
+
+    return len;
+}
+
+/* find the line of the key, return the line start position or RT_NULL */
+static char *cache_file_find(char *buf, const char *key)
+{
+    rt_size_t key_len = rt_strlen(key);
+    char *line = buf;
+
+    while (line && *line)
+    {
+        if (rt_strncmp(line, key, key_len) == 0 && line[key_len] == '=')
+        {
+            return line;
+        }
+
+        line = strchr(line, '\n');
+        if (line)
+        {
+            line++;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static int cache_file_read(const char *name, const char *key, char *value, rt_size_t size)
+{
+    int result = -RT_ERROR;
+    char *buf = RT_NULL, *line = RT_NULL, *end = RT_NULL;
+    rt_size_t len = 0;
+
+    buf = (char *) rt_calloc(1, AT_DEVICE_CACHE_FILE_SIZE);
+    if (buf == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) cache file buffer.", name);
+        return -RT_ENOMEM;
+    }
+
+    cache_file_load(name, buf, AT_DEVICE_CACHE_FILE_SIZE);
+
+    line = cache_file_find(buf, key);
+    if (line == RT_NULL)
+    {
+        goto __exit;
+    }
+
+    line += rt_strlen(key) + 1;
+    end = strchr(line, '\n');
+    len = end ? (rt_size_t) (end - line) : rt_strlen(line);
+    if (len == 0 || len >= size)
+    {
+        goto __exit;
+    }
+
+    rt_memcpy(value, line, len);
+    value[len] = '\0';
+    result = RT_EOK;
+
+__exit:
+    rt_free(buf);
+
+    return result;
+}
+
+static int cache_file_write(const char *name, const char *key, const char *value)
+{
+    int fd, result = RT_EOK;
+    char *buf = RT_NULL, *line = RT_NULL, *end = RT_NULL;
+    char file_name[AT_DEVICE_CACHE_PATH_LEN + RT_NAME_MAX + 8] = {0};
+    rt_size_t len = 0;
+
+    buf = (char *) rt_calloc(1, AT_DEVICE_CACHE_FILE_SIZE);
+    if (buf == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) cache file buffer.", name);
+        return -RT_ENOMEM;
+    }
+
+    len = cache_file_load(name, buf, AT_DEVICE_CACHE_FILE_SIZE);
+
+    /* remove the old line of the key */
+    line = cache_file_find(buf, key);
+    if (line)
+    {
+        end = strchr(line, '\n');
+        end = end ? end + 1 : buf + len;
+        memmove(line, end, buf + len - end + 1);
+        len -= end - line;
+    }
+
+    /* append the new line of the key */
+    if (len + rt_strlen(key) + rt_strlen(value) + 2 >= AT_DEVICE_CACHE_FILE_SIZE)
+    {
+        LOG_E("AT device(%s) cache file is full.", name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    len += rt_snprintf(buf + len, AT_DEVICE_CACHE_FILE_SIZE - len, "%s=%s\n", key, value);
+
+    cache_file_name(name, file_name, sizeof(file_name));
+
+    fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        LOG_E("open AT device(%s) cache file(%s) failed.", name, file_name);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (write(fd, buf, len) != (int) len)
+    {
+        result = -RT_ERROR;
+    }
+    close(fd);
+
+__exit:
+    rt_free(buf);
+
+    return result;
+}
+
+static int cache_file_erase(const char *name)
+{
+    char file_name[AT_DEVICE_CACHE_PATH_LEN + RT_NAME_MAX + 8] = {0};
+
+    cache_file_name(name, file_name, sizeof(file_name));
+    unlink(file_name);
+
+    return RT_EOK;
+}
+
+static const struct at_device_cache_ops cache_file_ops =
+{
+    cache_file_read,
+    cache_file_write,
+    cache_file_erase,
+};
+
+/**
+ * This function will register the file cache backend, it should be called
+ * after the file system is mounted.
+ *
+ * @param path the directory to store the cache files
+ *
+ * @return = 0: register successfully
+ *         < 0: register failed
+ */
+int at_device_cache_file_init(const char *path)
+{
+    RT_ASSERT(path);
+
+    if (rt_strlen(path) >= sizeof(cache_path))
+    {
+        LOG_E("AT device cache path(%s) is too long.", path);
+        return -RT_ERROR;
+    }
+
+    rt_strncpy(cache_path, path, sizeof(cache_path) - 1);
+
+    return at_device_cache_register(&cache_file_ops);
+}
+
+#endif /* AT_DEVICE_USING_CACHE && AT_DEVICE_CACHE_USING_FILE */
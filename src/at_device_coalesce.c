@@ -0,0 +1,554 @@
+/*
+ * File      : at_device_coalesce.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_COALESCE)
+
+/* The coalescing buffer size of each socket, the buffer is flushed when it's full */
+#ifndef AT_DEVICE_COALESCE_SIZE
+#define AT_DEVICE_COALESCE_SIZE        1024
+#endif
+/* The default time in milliseconds to collect the small writes before sending them */
+#ifndef AT_DEVICE_COALESCE_DELAY
+#define AT_DEVICE_COALESCE_DELAY       20
+#endif
+
+#ifndef AT_DEVICE_COALESCE_STACK_SIZE
+#define AT_DEVICE_COALESCE_STACK_SIZE  1024
+#endif
+#define AT_DEVICE_COALESCE_PRIORITY    (RT_THREAD_PRIORITY_MAX / 2)
+
+/* The coalescing buffer of one device socket */
+struct at_device_coalesce_buf
+{
+    struct at_socket *socket;
+    int socket_fd;                               /* The AT socket coalescing is enabled on, -1 if disabled */
+    rt_tick_t delay;
+    rt_tick_t flush_tick;
+    rt_bool_t is_flushing;                       /* The buffered data is being sent */
+    int error;                                   /* The error of the timed flush, returned by the next send */
+    rt_size_t len;
+    char *buff;
+};
+
+/* The socket coalescing status of one AT device */
+struct at_device_coalesce
+{
+    struct at_device *device;
+    rt_mutex_t lock;                             /* Keep the buffered and the direct data in order */
+    struct at_device_coalesce_buf *bufs;         /* The buffers of all device sockets */
+    rt_slist_t list;
+};
+
+/* The socket coalescing status list, the nodes are never removed */
+static rt_slist_t at_device_coalesce_list = RT_SLIST_OBJECT_INIT(at_device_coalesce_list);
+static rt_sem_t at_device_coalesce_sem = RT_NULL;
+
+/* find the socket coalescing status of the device, it's called with the interrupt disabled */
+static struct at_device_coalesce *at_device_coalesce_find(struct at_device *device)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_coalesce *coalesce = RT_NULL;
+
+    rt_slist_for_each(node, &at_device_coalesce_list)
+    {
+        coalesce = rt_slist_entry(node, struct at_device_coalesce, list);
+        if (coalesce->device == device)
+        {
+            return coalesce;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static struct at_device_coalesce *at_device_coalesce_get(struct at_device *device, rt_bool_t create)
+{
+    rt_base_t level;
+    struct at_device_coalesce *coalesce = RT_NULL, *found = RT_NULL;
+    int idx;
+
+    level = rt_hw_interrupt_disable();
+    found = at_device_coalesce_find(device);
+    rt_hw_interrupt_enable(level);
+
+    if (found || create == RT_FALSE)
+    {
+        return found;
+    }
+
+    coalesce = (struct at_device_coalesce *) rt_calloc(1, sizeof(struct at_device_coalesce) +
+            device->socket_num * sizeof(struct at_device_coalesce_buf));
+    if (coalesce == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) socket coalescing status.", device->name);
+        return RT_NULL;
+    }
+
+    coalesce->lock = rt_mutex_create("at_coals", RT_IPC_FLAG_FIFO);
+    if (coalesce->lock == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) socket coalescing lock.", device->name);
+        rt_free(coalesce);
+        return RT_NULL;
+    }
+
+    coalesce->device = device;
+    coalesce->bufs = (struct at_device_coalesce_buf *) (coalesce + 1);
+    for (idx = 0; idx < (int) device->socket_num; idx++)
+    {
+        coalesce->bufs[idx].socket_fd = -1;
+    }
+    rt_slist_init(&(coalesce->list));
+
+    /* the status may be created by another thread in the meantime, only the first one is added */
+    level = rt_hw_interrupt_disable();
+    found = at_device_coalesce_find(device);
+    if (found == RT_NULL)
+    {
+        rt_slist_append(&at_device_coalesce_list, &(coalesce->list));
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (found)
+    {
+        rt_mutex_delete(coalesce->lock);
+        rt_free(coalesce);
+        return found;
+    }
+
+    return coalesce;
+}
+
+/* get the coalescing buffer of the socket, RT_NULL if the coalescing is not enabled on it */
+static struct at_device_coalesce_buf *at_device_coalesce_buf_get(struct at_device_coalesce *coalesce,
+                                                                 struct at_socket *socket)
+{
+    struct at_device *device = (struct at_device *) socket->device;
+    int idx = (int) (socket - device->sockets);
+
+    if (coalesce == RT_NULL || idx < 0 || idx >= (int) device->socket_num)
+    {
+        return RT_NULL;
+    }
+
+    return (coalesce->bufs[idx].socket_fd == socket->socket) ? &(coalesce->bufs[idx]) : RT_NULL;
+}
+
+/* send the data by the device class, the coalescing lock is held */
+static int at_device_coalesce_send(struct at_device_coalesce_buf *buf, const struct at_device_iovec *iov, int iovcnt)
+{
+    struct at_device *device = (struct at_device *) buf->socket->device;
+    int result;
+
+    /* the class send operation calls back at_device_coalesce_queue(), which passes the data */
+    buf->is_flushing = RT_TRUE;
+    result = device->class->socket_sendv(buf->socket, iov, iovcnt, AT_SOCKET_TCP);
+    buf->is_flushing = RT_FALSE;
+
+    return result;
+}
+
+/* send the buffered data, the coalescing lock is held */
+static int at_device_coalesce_buf_flush(struct at_device_coalesce_buf *buf)
+{
+    struct at_device_iovec iov;
+    int result = RT_EOK;
+
+    if (buf->len > 0)
+    {
+        iov.base = buf->buff;
+        iov.len = buf->len;
+        result = at_device_coalesce_send(buf, &iov, 1);
+        buf->len = 0;
+    }
+
+    return (result < 0) ? result : RT_EOK;
+}
+
+static void at_device_coalesce_entry(void *parameter)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_coalesce *coalesce = RT_NULL;
+    struct at_device_coalesce_buf *buf = RT_NULL;
+    rt_int32_t wait_tick, left_tick;
+    int idx, result;
+
+    while (1)
+    {
+        wait_tick = RT_WAITING_FOREVER;
+
+        rt_slist_for_each(node, &at_device_coalesce_list)
+        {
+            coalesce = rt_slist_entry(node, struct at_device_coalesce, list);
+
+            rt_mutex_take(coalesce->lock, RT_WAITING_FOREVER);
+
+            for (idx = 0; idx < (int) coalesce->device->socket_num; idx++)
+            {
+                buf = &(coalesce->bufs[idx]);
+                if (buf->socket_fd < 0 || buf->len == 0)
+                {
+                    continue;
+                }
+
+                left_tick = (rt_int32_t) (buf->flush_tick - rt_tick_get());
+                if (left_tick <= 0)
+                {
+                    result = at_device_coalesce_buf_flush(buf);
+                    if (result != RT_EOK)
+                    {
+                        LOG_E("AT device(%s) socket(%d) send coalesced data failed(%d).",
+                              coalesce->device->name, buf->socket_fd, result);
+                        buf->error = result;
+                    }
+                }
+                else if (wait_tick == RT_WAITING_FOREVER || left_tick < wait_tick)
+                {
+                    wait_tick = left_tick;
+                }
+            }
+
+            rt_mutex_release(coalesce->lock);
+        }
+
+        rt_sem_take(at_device_coalesce_sem, wait_tick);
+    }
+}
+
+static int at_device_coalesce_startup(void)
+{
+    rt_thread_t tid;
+
+    if (at_device_coalesce_sem)
+    {
+        return RT_EOK;
+    }
+
+    at_device_coalesce_sem = rt_sem_create("at_coals", 0, RT_IPC_FLAG_FIFO);
+    if (at_device_coalesce_sem == RT_NULL)
+    {
+        LOG_E("no memory for AT device socket coalescing semaphore create.");
+        return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("at_coals", at_device_coalesce_entry, RT_NULL,
+                           AT_DEVICE_COALESCE_STACK_SIZE, AT_DEVICE_COALESCE_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        LOG_E("AT device socket coalescing thread create failed.");
+        rt_sem_delete(at_device_coalesce_sem);
+        at_device_coalesce_sem = RT_NULL;
+        return -RT_ERROR;
+    }
+
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+#endif /* AT_USING_SOCKET && AT_DEVICE_USING_COALESCE */
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will enable or disable the small writes coalescing of the TCP socket. The
+ * written data is collected in the socket buffer and sent by one send command when the
+ * buffer reaches the maximum send length, the delay time is up, or the socket is flushed.
+ * It's enabled on the connected socket, and disabled when the socket is closed or connected
+ * again.
+ *
+ * @param at_socket the AT socket number
+ * @param enable enable the coalescing
+ * @param delay the time in milliseconds to collect the writes, 0 for AT_DEVICE_COALESCE_DELAY
+ *
+ * @return  0: set the coalescing successfully
+ *        -10: the socket is not a connected AT device TCP socket
+ *         -5: no memory
+ *         -6: the coalescing is not supported, AT_DEVICE_USING_COALESCE is not enabled
+ *         < 0: send the buffered data failed when disabling the coalescing
+ */
+int at_device_coalesce_set(int at_socket, rt_bool_t enable, rt_uint32_t delay)
+{
+#ifdef AT_DEVICE_USING_COALESCE
+    struct at_socket *socket = at_get_socket(at_socket);
+    struct at_device *device = socket ? (struct at_device *) socket->device : RT_NULL;
+    struct at_device_coalesce *coalesce = RT_NULL;
+    struct at_device_coalesce_buf *buf = RT_NULL;
+    int result = RT_EOK;
+
+    if (socket == RT_NULL || device == RT_NULL || socket->type != AT_SOCKET_TCP)
+    {
+        return -RT_EINVAL;
+    }
+
+    if (enable && socket->state != AT_SOCKET_CONNECT)
+    {
+        LOG_E("AT socket(%d) should be connected before the coalescing is enabled.", at_socket);
+        return -RT_EINVAL;
+    }
+
+    if (enable && at_device_coalesce_startup() != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    coalesce = at_device_coalesce_get(device, enable);
+    if (coalesce == RT_NULL)
+    {
+        return enable ? -RT_ENOMEM : RT_EOK;
+    }
+
+    rt_mutex_take(coalesce->lock, RT_WAITING_FOREVER);
+
+    buf = at_device_coalesce_buf_get(coalesce, socket);
+    if (enable)
+    {
+        if (buf == RT_NULL)
+        {
+            buf = &(coalesce->bufs[socket - device->sockets]);
+            buf->buff = (char *) rt_malloc(AT_DEVICE_COALESCE_SIZE);
+            if (buf->buff == RT_NULL)
+            {
+                LOG_E("no memory for AT device(%s) socket(%d) coalescing buffer.", device->name, at_socket);
+                result = -RT_ENOMEM;
+                goto __exit;
+            }
+            buf->socket = socket;
+            buf->socket_fd = at_socket;
+            buf->len = 0;
+            buf->error = RT_EOK;
+        }
+        buf->delay = rt_tick_from_millisecond(delay ? delay : AT_DEVICE_COALESCE_DELAY);
+    }
+    else if (buf)
+    {
+        result = at_device_coalesce_buf_flush(buf);
+        buf->socket_fd = -1;
+        rt_free(buf->buff);
+        buf->buff = RT_NULL;
+    }
+
+__exit:
+    rt_mutex_release(coalesce->lock);
+
+    return result;
+#else
+    return -RT_ENOSYS;
+#endif /* AT_DEVICE_USING_COALESCE */
+}
+
+/**
+ * This function will send the coalesced data of the socket immediately.
+ *
+ * @param at_socket the AT socket number
+ *
+ * @return  0: no coalesced data or send the coalesced data successfully
+ *         < 0: send the coalesced data failed
+ */
+int at_device_coalesce_flush(int at_socket)
+{
+#ifdef AT_DEVICE_USING_COALESCE
+    struct at_socket *socket = at_get_socket(at_socket);
+    struct at_device *device = socket ? (struct at_device *) socket->device : RT_NULL;
+    struct at_device_coalesce *coalesce = RT_NULL;
+    struct at_device_coalesce_buf *buf = RT_NULL;
+    int result = RT_EOK;
+
+    if (socket == RT_NULL || device == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+
+    coalesce = at_device_coalesce_get(device, RT_FALSE);
+    if (coalesce == RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    rt_mutex_take(coalesce->lock, RT_WAITING_FOREVER);
+    buf = at_device_coalesce_buf_get(coalesce, socket);
+    if (buf)
+    {
+        result = at_device_coalesce_buf_flush(buf);
+    }
+    rt_mutex_release(coalesce->lock);
+
+    return result;
+#else
+    return RT_EOK;
+#endif /* AT_DEVICE_USING_COALESCE */
+}
+
+/**
+ * This function will coalesce the small writes of the TCP socket when the coalescing is enabled
+ * on it. It's called at the beginning of the device class socket send operation, after the
+ * maximum send length is got.
+ *
+ * @param socket current socket object
+ * @param iov send data segments
+ * @param iovcnt send data segments number
+ * @param type socket type
+ * @param send_max_size the maximum data length of one send command
+ *
+ * @return   0: the coalescing is not enabled, send the data directly
+ *         > 0: the data is buffered or sent with the buffered data, the data size
+ *         < 0: send the buffered data failed
+ */
+int at_device_coalesce_queue(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                             enum at_socket_type type, rt_size_t send_max_size)
+{
+#ifdef AT_DEVICE_USING_COALESCE
+    struct at_device *device = (struct at_device *) socket->device;
+    rt_size_t bfsz = at_device_iov_len(iov, iovcnt);
+    struct at_device_coalesce *coalesce = RT_NULL;
+    struct at_device_coalesce_buf *buf = RT_NULL;
+    rt_size_t limit = AT_DEVICE_COALESCE_SIZE;
+    int result = 0;
+
+    if (type != AT_SOCKET_TCP)
+    {
+        return 0;
+    }
+
+    coalesce = at_device_coalesce_get(device, RT_FALSE);
+    if (coalesce == RT_NULL)
+    {
+        return 0;
+    }
+
+    rt_mutex_take(coalesce->lock, RT_WAITING_FOREVER);
+
+    /* the sleep queue already collects the data while the device is sleeping, and its
+     * data is not coalesced again when the device wakes up */
+    buf = at_device_coalesce_buf_get(coalesce, socket);
+    if (buf == RT_NULL || buf->is_flushing || at_device_is_sleep(device) || at_device_sleep_is_flushing(device))
+    {
+        goto __exit;
+    }
+
+    /* report the timed flush error to the writer */
+    if (buf->error != RT_EOK)
+    {
+        result = buf->error;
+        buf->error = RT_EOK;
+        goto __exit;
+    }
+
+    if (send_max_size < limit)
+    {
+        limit = send_max_size;
+    }
+
+    if (buf->len + bfsz > limit)
+    {
+        result = at_device_coalesce_buf_flush(buf);
+        if (result != RT_EOK)
+        {
+            goto __exit;
+        }
+    }
+
+    /* the large write is sent directly after the buffered data */
+    if (bfsz >= limit)
+    {
+        result = at_device_coalesce_send(buf, iov, iovcnt);
+        goto __exit;
+    }
+
+    at_device_iov_copy(buf->buff + buf->len, iov, iovcnt, 0, bfsz);
+    buf->len += bfsz;
+    result = (int) bfsz;
+
+    if (buf->len == limit)
+    {
+        result = at_device_coalesce_buf_flush(buf);
+        result = (result == RT_EOK) ? (int) bfsz : result;
+    }
+    else if (buf->len == bfsz)
+    {
+        /* the first buffered data starts the delay time */
+        buf->flush_tick = rt_tick_get() + buf->delay;
+        rt_sem_release(at_device_coalesce_sem);
+    }
+
+__exit:
+    rt_mutex_release(coalesce->lock);
+
+    return result;
+#else
+    return 0;
+#endif /* AT_DEVICE_USING_COALESCE */
+}
+
+/**
+ * This function will send the coalesced data before the socket is closed and disable the
+ * coalescing of the socket. It's called at the beginning of the device class socket close
+ * operation.
+ *
+ * @param socket current socket object
+ */
+void at_device_coalesce_close(struct at_socket *socket)
+{
+#ifdef AT_DEVICE_USING_COALESCE
+    at_device_coalesce_set(socket->socket, RT_FALSE, 0);
+#endif
+}
+
+/**
+ * This function will drop the coalesced data and disable the coalescing of the device socket,
+ * it's called when the device socket is connected.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the device socket number
+ */
+void at_device_coalesce_reset(struct at_device *device, int device_socket)
+{
+#ifdef AT_DEVICE_USING_COALESCE
+    struct at_device_coalesce *coalesce = at_device_coalesce_get(device, RT_FALSE);
+    struct at_device_coalesce_buf *buf = RT_NULL;
+
+    if (coalesce == RT_NULL || device_socket < 0 || device_socket >= (int) device->socket_num)
+    {
+        return;
+    }
+
+    rt_mutex_take(coalesce->lock, RT_WAITING_FOREVER);
+    buf = &(coalesce->bufs[device_socket]);
+    if (buf->socket_fd >= 0)
+    {
+        buf->socket_fd = -1;
+        buf->len = 0;
+        rt_free(buf->buff);
+        buf->buff = RT_NULL;
+    }
+    rt_mutex_release(coalesce->lock);
+#endif
+}
+#endif /* AT_USING_SOCKET */
@@ -0,0 +1,653 @@
+/*
+ * File      : at_device_link.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+/* The link status polling interval in milliseconds, doubled up to the maximum while the link is stable */
+#ifndef AT_DEVICE_LINK_POLL_MIN
+#define AT_DEVICE_LINK_POLL_MIN        5000
+#endif
+#ifndef AT_DEVICE_LINK_POLL_MAX
+#define AT_DEVICE_LINK_POLL_MAX        120000
+#endif
+
+/* The data context reactivation retry delay in milliseconds, doubled up to the maximum with random jitter */
+#ifndef AT_DEVICE_LINK_REACT_MIN
+#define AT_DEVICE_LINK_REACT_MIN       1000
+#endif
+#ifndef AT_DEVICE_LINK_REACT_MAX
+#define AT_DEVICE_LINK_REACT_MAX       60000
+#endif
+
+#ifndef AT_DEVICE_LINK_STACK_SIZE
+#define AT_DEVICE_LINK_STACK_SIZE      2048
+#endif
+#define AT_DEVICE_LINK_PRIORITY        (RT_THREAD_PRIORITY_MAX - 2)
+#define AT_DEVICE_LINK_RESP_SIZE       64
+
+/* The link status polling command timeout in milliseconds, all devices are polled by one thread */
+#ifndef AT_DEVICE_LINK_CMD_TIMEOUT
+#define AT_DEVICE_LINK_CMD_TIMEOUT     3000
+#endif
+/* The time in milliseconds to wait for the AT client used by other commands, the polling is skipped then */
+#ifndef AT_DEVICE_LINK_LOCK_TIMEOUT
+#define AT_DEVICE_LINK_LOCK_TIMEOUT    500
+#endif
+#if AT_DEVICE_LINK_CMD_TIMEOUT + AT_DEVICE_LINK_LOCK_TIMEOUT > AT_DEVICE_LINK_POLL_MIN
+#error "The link status polling must be shorter than AT_DEVICE_LINK_POLL_MIN"
+#endif
+
+/* The link monitor of one AT device */
+struct at_device_link
+{
+    struct at_device *device;
+    const struct at_device_link_ops *ops;
+    rt_tick_t interval;                          /* Current polling interval ticks */
+    rt_tick_t next_tick;                         /* Next polling tick */
+    rt_tick_t active_tick;                       /* Last socket traffic tick */
+    rt_bool_t reactivating;                      /* The data context is deactivated and being reactivated */
+    rt_bool_t react_pending;                     /* The reactivation is scheduled or running in the worker */
+    rt_uint8_t retry;                            /* The reactivation retry times */
+    rt_slist_t list;
+};
+
+/* The link monitors list, the monitors are never removed */
+static rt_slist_t at_device_link_list = RT_SLIST_OBJECT_INIT(at_device_link_list);
+/* Wake up the link monitor thread when the polling schedule changes */
+static rt_sem_t at_device_link_sem = RT_NULL;
+/* Wake up the reactivation worker thread when a reactivation is scheduled */
+static rt_sem_t at_device_link_react_sem = RT_NULL;
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_link at_device_link_pool[AT_DEVICE_STATIC_DEVICE_NUM];
+static struct rt_semaphore at_device_link_sem_obj;
+static struct rt_thread at_device_link_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t at_device_link_stack[AT_DEVICE_LINK_STACK_SIZE];
+static struct rt_semaphore at_device_link_react_sem_obj;
+static struct rt_thread at_device_link_react_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t at_device_link_react_stack[AT_DEVICE_LINK_STACK_SIZE];
+static struct at_response at_device_link_resp;
+static char at_device_link_resp_buf[AT_DEVICE_LINK_RESP_SIZE];
+#endif
+
+#define LINK_TICK_BEFORE(a, b)         ((rt_int32_t) ((a) - (b)) < 0)
+
+static struct at_device_link *at_device_link_get(struct at_device *device)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device_link *link = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+
+    rt_slist_for_each(node, &at_device_link_list)
+    {
+        link = rt_slist_entry(node, struct at_device_link, list);
+        if (link->device == device)
+        {
+            rt_hw_interrupt_enable(level);
+            return link;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_NULL;
+}
+
+/* set the link status, fail the pending socket operations and re-point the default AT netdev for the new sockets */
+static void at_device_link_set(struct at_device *device, rt_bool_t is_up)
+{
+    if (is_up != netdev_is_link_up(device->netdev))
+    {
+        LOG_D("AT device(%s) link status changed to %s.", device->name, is_up ? "up" : "down");
+        netdev_low_level_set_link_status(device->netdev, is_up);
+    }
+
+#ifdef AT_USING_SOCKET
+    if (is_up)
+    {
+        rt_uint32_t recved = 0;
+
+        rt_event_recv(device->socket_event, AT_DEVICE_EVENT_LINK_DOWN, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_NO, &recved);
+    }
+    else
+    {
+        LOG_W("AT device(%s) link is down, fail the pending socket operations.", device->name);
+        rt_event_send(device->socket_event, AT_DEVICE_EVENT_LINK_DOWN);
+    }
+
+    at_device_placement_update();
+#endif
+}
+
+static void at_device_link_update(struct at_device_link *link, rt_bool_t is_up)
+{
+    if (is_up != netdev_is_link_up(link->device->netdev))
+    {
+        at_device_link_set(link->device, is_up);
+        link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    }
+    else if (is_up)
+    {
+        /* the link is stable, slow down the polling */
+        link->interval = (link->interval * 2 > rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MAX)) ?
+                rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MAX) : link->interval * 2;
+    }
+    else
+    {
+        link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    }
+}
+
+/* the reactivation retry delay ticks, the random jitter avoids all devices retry at the same time */
+static rt_tick_t at_device_link_backoff(rt_uint8_t retry)
+{
+    rt_uint32_t delay = AT_DEVICE_LINK_REACT_MIN;
+
+    while (retry-- > 0 && delay < AT_DEVICE_LINK_REACT_MAX)
+    {
+        delay *= 2;
+    }
+    delay = (delay > AT_DEVICE_LINK_REACT_MAX) ? AT_DEVICE_LINK_REACT_MAX : delay;
+
+    return rt_tick_from_millisecond(delay / 2 + rand() % (delay / 2 + 1));
+}
+
+/* reactivate the data context in the worker thread, the activation command may take minutes */
+static void at_device_link_reactivate_step(struct at_device_link *link)
+{
+    struct at_device *device = link->device;
+
+    if (link->ops->reactivate(device) != RT_EOK)
+    {
+        if (link->retry < 0xFF)
+        {
+            link->retry++;
+        }
+        link->next_tick = rt_tick_get() + at_device_link_backoff(link->retry);
+
+        LOG_W("AT device(%s) data context reactivate failed, retry(%d) after %d ms.", device->name,
+              link->retry, (link->next_tick - rt_tick_get()) * 1000 / RT_TICK_PER_SECOND);
+        return;
+    }
+
+    LOG_I("AT device(%s) data context is reactivated after %d retries.", device->name, link->retry);
+
+    link->reactivating = RT_FALSE;
+    link->retry = 0;
+    link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    link->next_tick = rt_tick_get() + link->interval;
+
+    /* the sockets are available again, and the device ready event is sent to the waiting threads */
+    at_device_link_set(device, RT_TRUE);
+    at_device_set_ready(device, RT_TRUE);
+}
+
+static void at_device_link_poll(struct at_device_link *link, at_response_t resp)
+{
+    struct at_device *device = link->device;
+    rt_tick_t now = rt_tick_get();
+
+    /* the socket traffic proves the link is alive, skip this polling */
+    if (netdev_is_link_up(device->netdev) && LINK_TICK_BEFORE(now, link->active_tick + link->interval))
+    {
+        link->next_tick = link->active_tick + link->interval;
+        return;
+    }
+
+    /* the client may be held by a long command (e.g. socket connect), don't wait for it */
+    if (rt_mutex_take(device->client->lock, rt_tick_from_millisecond(AT_DEVICE_LINK_LOCK_TIMEOUT)) != RT_EOK)
+    {
+        LOG_D("AT device(%s) is busy, skip the link status polling.", device->name);
+        link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    }
+    else if (at_device_exec_cmd(device, resp, "%s", link->ops->cmd) < 0)
+    {
+        /* the module is busy or not responding, keep the link status and check it again soon */
+        rt_mutex_release(device->client->lock);
+        link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    }
+    else
+    {
+        rt_mutex_release(device->client->lock);
+        at_device_link_update(link, link->ops->parse(resp));
+    }
+
+    link->next_tick = rt_tick_get() + link->interval;
+}
+
+static void at_device_link_entry(void *parameter)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_link *link = RT_NULL;
+    at_response_t resp = RT_NULL;
+    rt_tick_t wait_tick;
+
+#ifdef AT_DEVICE_USING_STATIC
+    resp = &at_device_link_resp;
+    resp->buf = at_device_link_resp_buf;
+    resp->buf_size = AT_DEVICE_LINK_RESP_SIZE;
+    resp->line_num = 0;
+    resp->timeout = rt_tick_from_millisecond(AT_DEVICE_LINK_CMD_TIMEOUT);
+#else
+    resp = at_create_resp(AT_DEVICE_LINK_RESP_SIZE, 0, rt_tick_from_millisecond(AT_DEVICE_LINK_CMD_TIMEOUT));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for AT device link monitor response object.");
+        return;
+    }
+#endif
+
+    while (1)
+    {
+        wait_tick = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MAX);
+
+        /* the monitors are only appended, the list can be walked without lock */
+        rt_slist_for_each(node, &at_device_link_list)
+        {
+            link = rt_slist_entry(node, struct at_device_link, list);
+
+            /* the network interface device is set down by user or the device is sleeping */
+            if (link->device->netdev == RT_NULL || netdev_is_up(link->device->netdev) == RT_FALSE ||
+                    at_device_is_sleep(link->device))
+            {
+                continue;
+            }
+
+            /* the worker wakes up the monitor when the reactivation is finished */
+            if (link->react_pending)
+            {
+                continue;
+            }
+
+            if (LINK_TICK_BEFORE(rt_tick_get(), link->next_tick) == RT_FALSE)
+            {
+                if (link->reactivating)
+                {
+                    link->react_pending = RT_TRUE;
+                    rt_sem_release(at_device_link_react_sem);
+                    continue;
+                }
+
+                at_device_link_poll(link, resp);
+            }
+
+            if (LINK_TICK_BEFORE(link->next_tick - rt_tick_get(), wait_tick))
+            {
+                wait_tick = link->next_tick - rt_tick_get();
+            }
+        }
+
+        rt_sem_take(at_device_link_sem, (rt_int32_t) wait_tick);
+    }
+}
+
+static void at_device_link_react_entry(void *parameter)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_link *link = RT_NULL;
+
+    while (1)
+    {
+        rt_sem_take(at_device_link_react_sem, RT_WAITING_FOREVER);
+
+        rt_slist_for_each(node, &at_device_link_list)
+        {
+            link = rt_slist_entry(node, struct at_device_link, list);
+            if (link->react_pending == RT_FALSE)
+            {
+                continue;
+            }
+
+            /* the device is re-initialized after the reactivation is scheduled */
+            if (link->reactivating)
+            {
+                at_device_link_reactivate_step(link);
+            }
+
+            link->react_pending = RT_FALSE;
+            rt_sem_release(at_device_link_sem);
+        }
+    }
+}
+
+#ifdef AT_DEVICE_USING_STATIC
+static int at_device_link_startup(void)
+{
+    if (at_device_link_sem)
+    {
+        return RT_EOK;
+    }
+
+    rt_sem_init(&at_device_link_sem_obj, "at_link", 0, RT_IPC_FLAG_FIFO);
+    at_device_link_sem = &at_device_link_sem_obj;
+    rt_sem_init(&at_device_link_react_sem_obj, "at_react", 0, RT_IPC_FLAG_FIFO);
+    at_device_link_react_sem = &at_device_link_react_sem_obj;
+
+    rt_thread_init(&at_device_link_react_thread, "at_react", at_device_link_react_entry, RT_NULL,
+                   at_device_link_react_stack, sizeof(at_device_link_react_stack), AT_DEVICE_LINK_PRIORITY, 20);
+    rt_thread_startup(&at_device_link_react_thread);
+
+    rt_thread_init(&at_device_link_thread, "at_link", at_device_link_entry, RT_NULL,
+                   at_device_link_stack, sizeof(at_device_link_stack), AT_DEVICE_LINK_PRIORITY, 20);
+    rt_thread_startup(&at_device_link_thread);
+
+    return RT_EOK;
+}
+
+/* claim the link monitor of the device from the static pool */
+static struct at_device_link *at_device_link_alloc(struct at_device *device)
+{
+    rt_base_t level;
+    struct at_device_link *link = RT_NULL;
+    int idx;
+
+    level = rt_hw_interrupt_disable();
+    for (idx = 0; idx < AT_DEVICE_STATIC_DEVICE_NUM; idx++)
+    {
+        if (at_device_link_pool[idx].device == RT_NULL)
+        {
+            link = &at_device_link_pool[idx];
+            link->device = device;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (link == RT_NULL)
+    {
+        LOG_E("no free AT device(%s) link monitor, see AT_DEVICE_STATIC_DEVICE_NUM.", device->name);
+    }
+
+    return link;
+}
+#else
+static int at_device_link_startup(void)
+{
+    rt_thread_t tid;
+
+    if (at_device_link_sem)
+    {
+        return RT_EOK;
+    }
+
+    /* the worker is started first and kept if the monitor thread create failed */
+    if (at_device_link_react_sem == RT_NULL)
+    {
+        at_device_link_react_sem = rt_sem_create("at_react", 0, RT_IPC_FLAG_FIFO);
+        if (at_device_link_react_sem == RT_NULL)
+        {
+            LOG_E("no memory for AT device link reactivation semaphore create.");
+            return -RT_ENOMEM;
+        }
+
+        tid = rt_thread_create("at_react", at_device_link_react_entry, RT_NULL,
+                               AT_DEVICE_LINK_STACK_SIZE, AT_DEVICE_LINK_PRIORITY, 20);
+        if (tid == RT_NULL)
+        {
+            LOG_E("AT device link reactivation thread create failed.");
+            rt_sem_delete(at_device_link_react_sem);
+            at_device_link_react_sem = RT_NULL;
+            return -RT_ERROR;
+        }
+
+        rt_thread_startup(tid);
+    }
+
+    at_device_link_sem = rt_sem_create("at_link", 0, RT_IPC_FLAG_FIFO);
+    if (at_device_link_sem == RT_NULL)
+    {
+        LOG_E("no memory for AT device link monitor semaphore create.");
+        return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("at_link", at_device_link_entry, RT_NULL,
+                           AT_DEVICE_LINK_STACK_SIZE, AT_DEVICE_LINK_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        LOG_E("AT device link monitor thread create failed.");
+        rt_sem_delete(at_device_link_sem);
+        at_device_link_sem = RT_NULL;
+        return -RT_ERROR;
+    }
+
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+static struct at_device_link *at_device_link_alloc(struct at_device *device)
+{
+    struct at_device_link *link = RT_NULL;
+
+    link = (struct at_device_link *) rt_calloc(1, sizeof(struct at_device_link));
+    if (link == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) link monitor.", device->name);
+        return RT_NULL;
+    }
+
+    link->device = device;
+
+    return link;
+}
+#endif /* AT_DEVICE_USING_STATIC */
+
+/**
+ * This function will add the AT device to the shared link monitor service, the link status
+ * is polled by the command in the operations with an adaptive interval. It can be called again
+ * when the device is re-initialized, the device is only added once.
+ *
+ * All devices are polled by one thread, so the polling must be short: the command waits at most
+ * AT_DEVICE_LINK_LOCK_TIMEOUT for the AT client and AT_DEVICE_LINK_CMD_TIMEOUT for the response,
+ * and the parser only parses the response. The reactivation runs in a separate worker thread.
+ *
+ * @param device the pointer of AT device structure
+ * @param ops the link status polling command and response parser
+ *
+ * @return = 0: add the device successfully
+ *         < 0: add the device failed
+ */
+int at_device_link_monitor(struct at_device *device, const struct at_device_link_ops *ops)
+{
+    rt_base_t level;
+    struct at_device_link *link = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(ops && ops->cmd && ops->parse);
+
+    if (at_device_link_startup() != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    link = at_device_link_get(device);
+    if (link == RT_NULL)
+    {
+        link = at_device_link_alloc(device);
+        if (link == RT_NULL)
+        {
+            return -RT_ENOMEM;
+        }
+
+        rt_slist_init(&(link->list));
+
+        level = rt_hw_interrupt_disable();
+        rt_slist_append(&at_device_link_list, &(link->list));
+        rt_hw_interrupt_enable(level);
+    }
+
+    link->ops = ops;
+    link->reactivating = RT_FALSE;
+    link->retry = 0;
+    link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    link->next_tick = rt_tick_get() + link->interval;
+    link->active_tick = rt_tick_get() - link->interval;
+
+    rt_sem_release(at_device_link_sem);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will notify the link status changed by URC (e.g. PDP context deactivated, WiFi
+ * disconnected), the link status is set immediately and confirmed by the next polling soon.
+ * The pending socket operations on the device fail immediately when the link is down.
+ *
+ * @param device the pointer of AT device structure
+ * @param is_up the link is up
+ */
+void at_device_link_notify(struct at_device *device, rt_bool_t is_up)
+{
+    struct at_device_link *link = at_device_link_get(device);
+
+    if (device->netdev == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_link_set(device, is_up);
+
+    /* the device link status is not polled, or the data context is being reactivated */
+    if (link == RT_NULL || link->reactivating)
+    {
+        return;
+    }
+
+    link->interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_MIN);
+    link->next_tick = rt_tick_get() + link->interval;
+    link->active_tick = rt_tick_get() - link->interval;
+
+    rt_sem_release(at_device_link_sem);
+}
+
+/**
+ * This function will reactivate the data context (e.g. PDP context) when it's deactivated by
+ * the network, only the context activation operation is executed instead of the whole device
+ * initialization, and it's retried with jittered exponential backoff. The link monitor schedules
+ * the reactivation to a separate worker thread, so the long activation command doesn't stop
+ * polling the other devices.
+ * It can be called in the URC function, the link status is set down immediately.
+ *
+ * @param device the pointer of AT device structure
+ */
+void at_device_link_reactivate(struct at_device *device)
+{
+    struct at_device_link *link = at_device_link_get(device);
+
+    /* the device not supports the data context reactivation */
+    if (link == RT_NULL || link->ops->reactivate == RT_NULL)
+    {
+        at_device_link_notify(device, RT_FALSE);
+        return;
+    }
+
+    if (device->netdev)
+    {
+        at_device_link_set(device, RT_FALSE);
+    }
+
+    if (link->reactivating == RT_FALSE)
+    {
+        link->reactivating = RT_TRUE;
+        link->retry = 0;
+        link->next_tick = rt_tick_get() + at_device_link_backoff(0);
+    }
+
+    rt_sem_release(at_device_link_sem);
+}
+
+/**
+ * This function will record the socket traffic of the AT device, the link status polling
+ * is skipped while the socket traffic proves the link is alive.
+ *
+ * @param device the pointer of AT device structure
+ */
+void at_device_link_activity(struct at_device *device)
+{
+    struct at_device_link *link = at_device_link_get(device);
+
+    if (link)
+    {
+        link->active_tick = rt_tick_get();
+    }
+}
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will receive the AT device socket event, it returns immediately with error when
+ * the device link is down, so the pending socket operations don't wait until timeout.
+ *
+ * @param device the pointer of AT device structure
+ * @param set the event set
+ * @param option the receive option
+ * @param timeout the waiting timeout ticks
+ * @param recved the received event
+ *
+ * @return  RT_EOK: receive the event successfully
+ *         -RT_ETIMEOUT: receive timeout
+ *         -RT_ERROR: the device link is down
+ */
+rt_err_t at_device_socket_event_recv(struct at_device *device, rt_uint32_t set, rt_uint8_t option,
+                                     rt_int32_t timeout, rt_uint32_t *recved)
+{
+    rt_err_t result = RT_EOK;
+
+    /* the link down event can't be waited with all events */
+    if ((option & RT_EVENT_FLAG_AND) == 0)
+    {
+        set |= AT_DEVICE_EVENT_LINK_DOWN;
+    }
+
+    result = rt_event_recv(device->socket_event, set, option, timeout, recved);
+    if (result != RT_EOK)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    if (*recved & AT_DEVICE_EVENT_LINK_DOWN)
+    {
+        /* keep the link down event for the other socket operations until the link is up */
+        if (option & RT_EVENT_FLAG_CLEAR)
+        {
+            rt_event_send(device->socket_event, AT_DEVICE_EVENT_LINK_DOWN);
+        }
+
+        LOG_E("AT device(%s) link is down, the socket operation failed.", device->name);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+#endif /* AT_USING_SOCKET */
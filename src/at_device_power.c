@@ -0,0 +1,148 @@
+/*
+ * File      : at_device_power.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+/* The polling interval in milliseconds when the pin not supports interrupt */
+#define AT_DEVICE_PIN_POLL_TIME        10
+
+static void at_device_pin_irq(void *args)
+{
+    rt_sem_release((rt_sem_t) args);
+}
+
+/**
+ * This function will wait the pin changes to the level, it waits on the pin change interrupt and
+ * falls back to polling when the pin not supports interrupt.
+ *
+ * @param pin the pin number
+ * @param level the waiting pin level, PIN_HIGH or PIN_LOW
+ * @param timeout the waiting timeout in milliseconds
+ *
+ * @return >= 0: the waiting time in milliseconds
+ *          < 0: wait timeout
+ */
+int at_device_pin_wait(rt_base_t pin, rt_base_t level, rt_uint32_t timeout)
+{
+    struct rt_semaphore sem;
+    rt_tick_t start_tick = rt_tick_get();
+    rt_tick_t timeout_tick = rt_tick_from_millisecond(timeout);
+    rt_tick_t used_tick = 0;
+    rt_bool_t attached = RT_FALSE, use_irq = RT_FALSE;
+
+    if (rt_pin_read(pin) == level)
+    {
+        return 0;
+    }
+
+    rt_sem_init(&sem, "at_pin", 0, RT_IPC_FLAG_FIFO);
+
+    if (rt_pin_attach_irq(pin, (level == PIN_HIGH) ? PIN_IRQ_MODE_RISING : PIN_IRQ_MODE_FALLING,
+                          at_device_pin_irq, (void *) &sem) == RT_EOK)
+    {
+        attached = RT_TRUE;
+        use_irq = (rt_pin_irq_enable(pin, PIN_IRQ_ENABLE) == RT_EOK) ? RT_TRUE : RT_FALSE;
+    }
+
+    /* check the pin level again, it may change before the interrupt is enabled */
+    while (rt_pin_read(pin) != level)
+    {
+        used_tick = rt_tick_get() - start_tick;
+        if (used_tick >= timeout_tick)
+        {
+            break;
+        }
+
+        if (use_irq)
+        {
+            rt_sem_take(&sem, timeout_tick - used_tick);
+        }
+        else
+        {
+            rt_thread_mdelay(AT_DEVICE_PIN_POLL_TIME);
+        }
+    }
+
+    if (use_irq)
+    {
+        rt_pin_irq_enable(pin, PIN_IRQ_DISABLE);
+    }
+    if (attached)
+    {
+        rt_pin_detach_irq(pin);
+    }
+    rt_sem_detach(&sem);
+
+    if (rt_pin_read(pin) != level)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    return (int) ((rt_tick_get() - start_tick) * 1000 / RT_TICK_PER_SECOND);
+}
+
+/**
+ * This function will power on or power off the AT device, it pulls up the power pin until the
+ * power status pin changes and pulls it down again. The power transition latency is reported.
+ *
+ * @param device the pointer of AT device structure
+ * @param power_pin the power key pin number
+ * @param status_pin the power status pin number
+ * @param is_on power on or power off the device
+ * @param timeout the power status waiting timeout in milliseconds
+ *
+ * @return >= 0: the power transition latency in milliseconds
+ *          < 0: the power status pin not changes before timeout
+ */
+int at_device_power_switch(struct at_device *device, rt_base_t power_pin, rt_base_t status_pin,
+                           rt_bool_t is_on, rt_uint32_t timeout)
+{
+    int latency = 0;
+    rt_base_t level = is_on ? PIN_HIGH : PIN_LOW;
+
+    RT_ASSERT(device);
+
+    if (rt_pin_read(status_pin) == level)
+    {
+        return 0;
+    }
+
+    rt_pin_write(power_pin, PIN_HIGH);
+    latency = at_device_pin_wait(status_pin, level, timeout);
+    rt_pin_write(power_pin, PIN_LOW);
+
+    if (latency < 0)
+    {
+        LOG_E("AT device(%s) power %s timeout(%d ms).", device->name, is_on ? "on" : "off", timeout);
+        return -RT_ETIMEOUT;
+    }
+
+    LOG_I("AT device(%s) power %s latency %d ms.", device->name, is_on ? "on" : "off", latency);
+
+    return latency;
+}
@@ -0,0 +1,288 @@
+/*
+ * File      : at_device_profile.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_DEVICE_USING_PROFILE
+
+/* The maximum number of the profiled AT devices */
+#ifndef AT_DEVICE_PROFILE_DEVICE_NUM
+#define AT_DEVICE_PROFILE_DEVICE_NUM   4
+#endif
+/* The maximum number of the profiled AT command types of all devices */
+#ifndef AT_DEVICE_PROFILE_CMD_NUM
+#define AT_DEVICE_PROFILE_CMD_NUM      32
+#endif
+/* The latency histogram buckets, the bucket n counts the latency in [2^(n-1), 2^n) milliseconds */
+#define AT_DEVICE_PROFILE_BUCKETS      16
+#define AT_DEVICE_PROFILE_NAME_LEN     16
+
+#define PROFILE_TICK_TO_MS(tick)       ((rt_uint32_t) (tick) * 1000 / RT_TICK_PER_SECOND)
+
+/* The client lock wait and hold time of one AT device */
+struct at_device_profile_lock
+{
+    struct at_device *device;
+    rt_uint32_t count;                           /* Lock taken times */
+    rt_uint32_t wait_total;                      /* Total lock wait time */
+    rt_uint32_t wait_max;                        /* Maximum lock wait time */
+    rt_uint32_t hold_total;                      /* Total lock hold time */
+    rt_uint32_t hold_max;                        /* Maximum lock hold time */
+    rt_tick_t take_tick;                         /* The lock taken tick of the current holder */
+};
+
+/* The latency histogram of one AT command type */
+struct at_device_profile_cmd
+{
+    struct at_device *device;
+    char name[AT_DEVICE_PROFILE_NAME_LEN];       /* AT command name, e.g. "AT+QIACT" */
+    rt_uint32_t count;
+    rt_uint32_t max;                             /* Maximum latency */
+    rt_uint16_t hist[AT_DEVICE_PROFILE_BUCKETS]; /* Saturated latency histogram */
+};
+
+static struct at_device_profile_lock profile_locks[AT_DEVICE_PROFILE_DEVICE_NUM];
+static struct at_device_profile_cmd profile_cmds[AT_DEVICE_PROFILE_CMD_NUM];
+
+static struct at_device_profile_lock *profile_lock_get(struct at_device *device)
+{
+    rt_base_t level;
+    int i;
+
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < AT_DEVICE_PROFILE_DEVICE_NUM; i++)
+    {
+        if (profile_locks[i].device == device || profile_locks[i].device == RT_NULL)
+        {
+            profile_locks[i].device = device;
+            rt_hw_interrupt_enable(level);
+            return &profile_locks[i];
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_NULL;
+}
+
+static int profile_bucket(rt_uint32_t ms)
+{
+    int bucket = 0;
+
+    while (ms > 0 && bucket < AT_DEVICE_PROFILE_BUCKETS - 1)
+    {
+        ms >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/**
+ * This function will record the AT command latency in the histogram of the command type,
+ * the command type is the command line before the '=' or '?' character.
+ *
+ * @param device the pointer of AT device structure
+ * @param cmd the AT command line
+ * @param start_tick the command start tick
+ */
+void at_device_profile_cmd(struct at_device *device, const char *cmd, rt_tick_t start_tick)
+{
+    rt_base_t level;
+    char name[AT_DEVICE_PROFILE_NAME_LEN] = {0};
+    rt_uint32_t ms = PROFILE_TICK_TO_MS(rt_tick_get() - start_tick);
+    struct at_device_profile_cmd *profile = RT_NULL;
+    rt_size_t len = 0;
+    int i, bucket;
+
+    for (len = 0; len < sizeof(name) - 1 && cmd[len] && cmd[len] != '=' && cmd[len] != '?'; len++)
+    {
+        name[len] = cmd[len];
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < AT_DEVICE_PROFILE_CMD_NUM; i++)
+    {
+        if (profile_cmds[i].device == RT_NULL)
+        {
+            profile_cmds[i].device = device;
+            rt_strncpy(profile_cmds[i].name, name, sizeof(name));
+        }
+
+        if (profile_cmds[i].device == device && rt_strcmp(profile_cmds[i].name, name) == 0)
+        {
+            profile = &profile_cmds[i];
+            break;
+        }
+    }
+
+    /* the command type is not recorded when the table is full */
+    if (profile)
+    {
+        bucket = profile_bucket(ms);
+        profile->count++;
+        profile->max = (ms > profile->max) ? ms : profile->max;
+        if (profile->hist[bucket] < 0xFFFF)
+        {
+            profile->hist[bucket]++;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will reset all AT devices profiling data.
+ */
+void at_device_profile_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(profile_cmds, 0x00, sizeof(profile_cmds));
+    rt_memset(profile_locks, 0x00, sizeof(profile_locks));
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will print the AT device profiling data, the latency histogram buckets are
+ * printed as "<upper bound ms>:<count>" for the non-empty buckets.
+ *
+ * @param device the pointer of AT device structure, RT_NULL for all devices
+ */
+void at_device_profile_dump(struct at_device *device)
+{
+    struct at_device_profile_lock *lock = RT_NULL;
+    struct at_device_profile_cmd *cmd = RT_NULL;
+    int i, j;
+
+    for (i = 0; i < AT_DEVICE_PROFILE_DEVICE_NUM; i++)
+    {
+        lock = &profile_locks[i];
+        if (lock->device == RT_NULL || (device && lock->device != device))
+        {
+            continue;
+        }
+
+        rt_kprintf("device %s lock: taken %d, wait avg %d ms, max %d ms, hold avg %d ms, max %d ms\n",
+                   lock->device->name, lock->count,
+                   lock->count ? lock->wait_total / lock->count : 0, lock->wait_max,
+                   lock->count ? lock->hold_total / lock->count : 0, lock->hold_max);
+    }
+
+    for (i = 0; i < AT_DEVICE_PROFILE_CMD_NUM; i++)
+    {
+        cmd = &profile_cmds[i];
+        if (cmd->device == RT_NULL || (device && cmd->device != device))
+        {
+            continue;
+        }
+
+        rt_kprintf("device %s %-16s count %d, max %d ms, hist(ms)", cmd->device->name, cmd->name,
+                   cmd->count, cmd->max);
+        for (j = 0; j < AT_DEVICE_PROFILE_BUCKETS; j++)
+        {
+            if (cmd->hist[j])
+            {
+                rt_kprintf(" <%d:%d", 1 << j, cmd->hist[j]);
+            }
+        }
+        rt_kprintf("\n");
+    }
+}
+#endif /* AT_DEVICE_USING_PROFILE */
+
+/**
+ * This function will take the AT client lock of the AT device, it's used by the socket
+ * operations which send the command and the data in one exclusive sequence. The lock
+ * wait time and hold time are profiled when AT_DEVICE_USING_PROFILE is enabled.
+ *
+ * @param device the pointer of AT device structure
+ */
+void at_device_lock(struct at_device *device)
+{
+#ifdef AT_DEVICE_USING_PROFILE
+    struct at_device_profile_lock *lock = profile_lock_get(device);
+    rt_tick_t start_tick = rt_tick_get();
+    rt_uint32_t ms = 0;
+#endif
+
+    rt_mutex_take(device->client->lock, RT_WAITING_FOREVER);
+
+    /* the lock owner is only changed by the lock holder, the nested take is not profiled */
+    if (device->lock_depth++ != 0)
+    {
+        return;
+    }
+    device->lock_owner = rt_thread_self();
+
+#ifdef AT_DEVICE_USING_PROFILE
+    if (lock)
+    {
+        /* the lock holder is the only writer */
+        lock->take_tick = rt_tick_get();
+        ms = PROFILE_TICK_TO_MS(lock->take_tick - start_tick);
+        lock->count++;
+        lock->wait_total += ms;
+        lock->wait_max = (ms > lock->wait_max) ? ms : lock->wait_max;
+    }
+#endif
+}
+
+/**
+ * This function will release the AT client lock of the AT device.
+ *
+ * @param device the pointer of AT device structure
+ */
+void at_device_unlock(struct at_device *device)
+{
+#ifdef AT_DEVICE_USING_PROFILE
+    struct at_device_profile_lock *lock = profile_lock_get(device);
+    rt_uint32_t ms = 0;
+#endif
+
+    /* the hold time is profiled when the outermost lock is released */
+    if (--device->lock_depth == 0)
+    {
+#ifdef AT_DEVICE_USING_PROFILE
+        if (lock)
+        {
+            ms = PROFILE_TICK_TO_MS(rt_tick_get() - lock->take_tick);
+            lock->hold_total += ms;
+            lock->hold_max = (ms > lock->hold_max) ? ms : lock->hold_max;
+        }
+#endif
+        device->lock_owner = RT_NULL;
+    }
+
+    rt_mutex_release(device->client->lock);
+}
@@ -0,0 +1,581 @@
+/*
+ * File      : at_device_sleep.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+/* The time in milliseconds to collect the sending data before waking up the device */
+#ifndef AT_DEVICE_SLEEP_BATCH_TIME
+#define AT_DEVICE_SLEEP_BATCH_TIME     200
+#endif
+/* The maximum size of the queued sending data for each AT device */
+#ifndef AT_DEVICE_SLEEP_QUEUE_SIZE
+#define AT_DEVICE_SLEEP_QUEUE_SIZE     1024
+#endif
+/* The time in milliseconds to wait the device network ready after it wakes up */
+#ifndef AT_DEVICE_SLEEP_WAKE_TIMEOUT
+#define AT_DEVICE_SLEEP_WAKE_TIMEOUT   30000
+#endif
+/* The time in milliseconds to wake up the device again to send the queued data after the wakeup failed */
+#ifndef AT_DEVICE_SLEEP_RETRY_TIME
+#define AT_DEVICE_SLEEP_RETRY_TIME     5000
+#endif
+
+#ifndef AT_DEVICE_SLEEP_STACK_SIZE
+#define AT_DEVICE_SLEEP_STACK_SIZE     1024
+#endif
+#define AT_DEVICE_SLEEP_PRIORITY       (RT_THREAD_PRIORITY_MAX / 2)
+#ifdef AT_DEVICE_USING_STATIC
+/* The queued data heap size of each AT device, the data of the full heap is sent directly */
+#ifndef AT_DEVICE_SLEEP_QUEUE_POOL_SIZE
+#define AT_DEVICE_SLEEP_QUEUE_POOL_SIZE (AT_DEVICE_SLEEP_QUEUE_SIZE + 512)
+#endif
+#endif
+
+#ifdef AT_USING_SOCKET
+/* The sending data queued while the device is sleeping */
+struct at_device_sleep_pkt
+{
+    struct at_socket *socket;
+    int socket_fd;                               /* Check the socket is not closed and reused */
+    enum at_socket_type type;
+    rt_size_t bfsz;
+    char *buff;
+    rt_slist_t list;
+};
+#endif /* AT_USING_SOCKET */
+
+/* The sleep status of one AT device */
+struct at_device_sleep
+{
+    struct at_device *device;
+    rt_bool_t is_sleep;
+    rt_uint32_t sleep_time;                      /* The sleep time argument to sleep again */
+#ifdef AT_USING_SOCKET
+    rt_slist_t queue;                            /* The queued sending data list */
+    rt_size_t queue_size;
+    rt_bool_t flush_pending;
+    rt_tick_t flush_tick;
+    rt_bool_t is_flushing;                       /* The queued data is being sent */
+    rt_bool_t sleep_again;                       /* Woken up to send the data directly, sleep again */
+    rt_bool_t wakeup_failed;                     /* The queued data is kept to send again */
+#ifdef AT_DEVICE_USING_STATIC
+    struct rt_memheap queue_heap;                /* The queued data heap */
+    rt_uint8_t queue_pool[AT_DEVICE_SLEEP_QUEUE_POOL_SIZE];
+#endif
+#endif
+    rt_slist_t list;
+};
+
+/* The sleep status list, the nodes are never removed */
+static rt_slist_t at_device_sleep_list = RT_SLIST_OBJECT_INIT(at_device_sleep_list);
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_sleep at_device_sleep_pool[AT_DEVICE_STATIC_DEVICE_NUM];
+#endif
+
+#ifdef AT_DEVICE_USING_STATIC
+/* claim the sleep status of the device from the static pool */
+static struct at_device_sleep *at_device_sleep_alloc(struct at_device *device)
+{
+    rt_base_t level;
+    struct at_device_sleep *sleep = RT_NULL;
+    int idx;
+
+    level = rt_hw_interrupt_disable();
+    for (idx = 0; idx < AT_DEVICE_STATIC_DEVICE_NUM; idx++)
+    {
+        if (at_device_sleep_pool[idx].device == RT_NULL)
+        {
+            sleep = &at_device_sleep_pool[idx];
+            sleep->device = device;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (sleep == RT_NULL)
+    {
+        LOG_E("no free AT device(%s) sleep status, see AT_DEVICE_STATIC_DEVICE_NUM.", device->name);
+        return RT_NULL;
+    }
+
+#ifdef AT_USING_SOCKET
+    if (rt_memheap_init(&(sleep->queue_heap), "at_slpq", sleep->queue_pool, sizeof(sleep->queue_pool)) != RT_EOK)
+    {
+        LOG_E("AT device(%s) sleep queue heap initialize failed.", device->name);
+        sleep->device = RT_NULL;
+        return RT_NULL;
+    }
+#endif
+
+    return sleep;
+}
+#else
+static struct at_device_sleep *at_device_sleep_alloc(struct at_device *device)
+{
+    struct at_device_sleep *sleep = RT_NULL;
+
+    sleep = (struct at_device_sleep *) rt_calloc(1, sizeof(struct at_device_sleep));
+    if (sleep == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) sleep status.", device->name);
+        return RT_NULL;
+    }
+
+    sleep->device = device;
+
+    return sleep;
+}
+#endif /* AT_DEVICE_USING_STATIC */
+
+static struct at_device_sleep *at_device_sleep_get(struct at_device *device, rt_bool_t create)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device_sleep *sleep = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+
+    rt_slist_for_each(node, &at_device_sleep_list)
+    {
+        sleep = rt_slist_entry(node, struct at_device_sleep, list);
+        if (sleep->device == device)
+        {
+            rt_hw_interrupt_enable(level);
+            return sleep;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    if (create == RT_FALSE)
+    {
+        return RT_NULL;
+    }
+
+    sleep = at_device_sleep_alloc(device);
+    if (sleep == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    rt_slist_init(&(sleep->list));
+#ifdef AT_USING_SOCKET
+    rt_slist_init(&(sleep->queue));
+#endif
+
+    level = rt_hw_interrupt_disable();
+    rt_slist_append(&at_device_sleep_list, &(sleep->list));
+    rt_hw_interrupt_enable(level);
+
+    return sleep;
+}
+
+/**
+ * This function will set the AT device sleep status, it's called when the AT device
+ * sleep or wakeup control command is executed successfully.
+ *
+ * @param device the pointer of AT device structure
+ * @param is_sleep the device is sleeping
+ * @param sleep_time the sleep time argument of the sleep control command
+ */
+void at_device_sleep_set(struct at_device *device, rt_bool_t is_sleep, rt_uint32_t sleep_time)
+{
+    struct at_device_sleep *sleep = at_device_sleep_get(device, is_sleep);
+
+    if (sleep == RT_NULL)
+    {
+        return;
+    }
+
+    sleep->is_sleep = is_sleep;
+#ifdef AT_USING_SOCKET
+    sleep->sleep_again = RT_FALSE;
+#endif
+    if (is_sleep)
+    {
+        sleep->sleep_time = sleep_time;
+    }
+}
+
+/**
+ * This function will get the AT device sleep status.
+ *
+ * @param device the pointer of AT device structure
+ *
+ * @return RT_TRUE: the device is sleeping
+ */
+rt_bool_t at_device_is_sleep(struct at_device *device)
+{
+    struct at_device_sleep *sleep = at_device_sleep_get(device, RT_FALSE);
+
+    return (sleep && sleep->is_sleep) ? RT_TRUE : RT_FALSE;
+}
+
+#ifdef AT_USING_SOCKET
+static rt_sem_t at_device_sleep_sem = RT_NULL;
+#ifdef AT_DEVICE_USING_STATIC
+static struct rt_semaphore at_device_sleep_sem_obj;
+static struct rt_thread at_device_sleep_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t at_device_sleep_stack[AT_DEVICE_SLEEP_STACK_SIZE];
+#endif
+
+/**
+ * This function will get whether the queued data of the AT device is being sent after it
+ * wakes up, the data has been collected and it's not coalesced again.
+ *
+ * @param device the pointer of AT device structure
+ *
+ * @return RT_TRUE: the queued data is being sent
+ */
+rt_bool_t at_device_sleep_is_flushing(struct at_device *device)
+{
+    struct at_device_sleep *sleep = at_device_sleep_get(device, RT_FALSE);
+
+    return (sleep && sleep->is_flushing) ? RT_TRUE : RT_FALSE;
+}
+
+static struct at_device_sleep_pkt *at_device_sleep_pkt_alloc(struct at_device_sleep *sleep, rt_size_t bfsz)
+{
+#ifdef AT_DEVICE_USING_STATIC
+    return (struct at_device_sleep_pkt *) rt_memheap_alloc(&(sleep->queue_heap),
+            sizeof(struct at_device_sleep_pkt) + bfsz);
+#else
+    return (struct at_device_sleep_pkt *) rt_malloc(sizeof(struct at_device_sleep_pkt) + bfsz);
+#endif
+}
+
+static void at_device_sleep_pkt_free(struct at_device_sleep_pkt *pkt)
+{
+#ifdef AT_DEVICE_USING_STATIC
+    rt_memheap_free(pkt);
+#else
+    rt_free(pkt);
+#endif
+}
+
+/* wake up the device if it's sleeping and send all queued data in one burst, the device keeps awake,
+ * the queued data is kept and sent again after AT_DEVICE_SLEEP_RETRY_TIME when the wakeup failed */
+static int at_device_sleep_send_queue(struct at_device_sleep *sleep)
+{
+    rt_base_t level;
+    rt_slist_t queue, *node = RT_NULL;
+    struct at_device_sleep_pkt *pkt = RT_NULL;
+    struct at_device *device = sleep->device;
+    rt_size_t queue_size;
+    int result = RT_EOK;
+
+    /* take all the queued data, the data sent after waking up is sent directly */
+    level = rt_hw_interrupt_disable();
+    queue = sleep->queue;
+    queue_size = sleep->queue_size;
+    rt_slist_init(&(sleep->queue));
+    sleep->queue_size = 0;
+    sleep->flush_pending = RT_FALSE;
+    rt_hw_interrupt_enable(level);
+
+    if (sleep->is_sleep || sleep->wakeup_failed)
+    {
+        LOG_D("AT device(%s) wakes up to send the queued data.", device->name);
+
+        result = at_device_control(device, AT_DEVICE_CTRL_WAKEUP, RT_NULL);
+        if (result == RT_EOK)
+        {
+            result = at_device_wait_ready(device, rt_tick_from_millisecond(AT_DEVICE_SLEEP_WAKE_TIMEOUT));
+        }
+
+        if (result != RT_EOK)
+        {
+            LOG_E("AT device(%s) wakeup failed(%d), send the queued data again after %d ms.",
+                  device->name, result, AT_DEVICE_SLEEP_RETRY_TIME);
+
+            /* put the taken data back in front of the data queued meanwhile */
+            level = rt_hw_interrupt_disable();
+            while ((node = rt_slist_first(&(sleep->queue))) != RT_NULL)
+            {
+                rt_slist_remove(&(sleep->queue), node);
+                rt_slist_append(&queue, node);
+            }
+            sleep->queue = queue;
+            sleep->queue_size += queue_size;
+            sleep->wakeup_failed = RT_TRUE;
+            sleep->flush_pending = RT_TRUE;
+            sleep->flush_tick = rt_tick_get() + rt_tick_from_millisecond(AT_DEVICE_SLEEP_RETRY_TIME);
+            rt_hw_interrupt_enable(level);
+
+            rt_sem_release(at_device_sleep_sem);
+            return result;
+        }
+
+        sleep->wakeup_failed = RT_FALSE;
+    }
+
+    sleep->is_flushing = RT_TRUE;
+
+    while ((node = rt_slist_first(&queue)) != RT_NULL)
+    {
+        rt_slist_remove(&queue, node);
+        pkt = rt_slist_entry(node, struct at_device_sleep_pkt, list);
+
+        /* the socket is closed or reused after the data is queued */
+        if (pkt->socket->socket == pkt->socket_fd)
+        {
+            if (device->class->socket_ops->at_send(pkt->socket, pkt->buff, pkt->bfsz, pkt->type) < 0)
+            {
+                LOG_E("AT device(%s) socket(%d) send queued data failed.", device->name, pkt->socket_fd);
+            }
+        }
+
+        at_device_sleep_pkt_free(pkt);
+    }
+
+    sleep->is_flushing = RT_FALSE;
+
+    return result;
+}
+
+/* send all queued data after the batch time and make the device sleep again, the device woken up
+ * by user in the batch time is kept awake */
+static void at_device_sleep_flush(struct at_device_sleep *sleep)
+{
+    rt_uint32_t sleep_time = sleep->sleep_time;
+    rt_bool_t sleep_again = (sleep->is_sleep || sleep->sleep_again);
+
+    sleep->sleep_again = RT_FALSE;
+
+    if (at_device_sleep_send_queue(sleep) != RT_EOK)
+    {
+        /* sleep again after the kept data is sent */
+        sleep->sleep_again = sleep_again;
+    }
+    else if (sleep_again)
+    {
+        at_device_control(sleep->device, AT_DEVICE_CTRL_SLEEP, &sleep_time);
+    }
+}
+
+static void at_device_sleep_entry(void *parameter)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_sleep *sleep = RT_NULL;
+    rt_int32_t wait_tick;
+
+    while (1)
+    {
+        wait_tick = RT_WAITING_FOREVER;
+
+        rt_slist_for_each(node, &at_device_sleep_list)
+        {
+            sleep = rt_slist_entry(node, struct at_device_sleep, list);
+            if (sleep->flush_pending == RT_FALSE)
+            {
+                continue;
+            }
+
+            if ((rt_int32_t) (sleep->flush_tick - rt_tick_get()) <= 0)
+            {
+                at_device_sleep_flush(sleep);
+            }
+            else if (wait_tick == RT_WAITING_FOREVER || (rt_int32_t) (sleep->flush_tick - rt_tick_get()) < wait_tick)
+            {
+                wait_tick = (rt_int32_t) (sleep->flush_tick - rt_tick_get());
+            }
+        }
+
+        rt_sem_take(at_device_sleep_sem, wait_tick);
+    }
+}
+
+#ifdef AT_DEVICE_USING_STATIC
+static int at_device_sleep_startup(void)
+{
+    if (at_device_sleep_sem)
+    {
+        return RT_EOK;
+    }
+
+    rt_sem_init(&at_device_sleep_sem_obj, "at_sleep", 0, RT_IPC_FLAG_FIFO);
+    at_device_sleep_sem = &at_device_sleep_sem_obj;
+
+    rt_thread_init(&at_device_sleep_thread, "at_sleep", at_device_sleep_entry, RT_NULL,
+                   at_device_sleep_stack, sizeof(at_device_sleep_stack), AT_DEVICE_SLEEP_PRIORITY, 20);
+    rt_thread_startup(&at_device_sleep_thread);
+
+    return RT_EOK;
+}
+#else
+static int at_device_sleep_startup(void)
+{
+    rt_thread_t tid;
+
+    if (at_device_sleep_sem)
+    {
+        return RT_EOK;
+    }
+
+    at_device_sleep_sem = rt_sem_create("at_sleep", 0, RT_IPC_FLAG_FIFO);
+    if (at_device_sleep_sem == RT_NULL)
+    {
+        LOG_E("no memory for AT device sleep queue semaphore create.");
+        return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("at_sleep", at_device_sleep_entry, RT_NULL,
+                           AT_DEVICE_SLEEP_STACK_SIZE, AT_DEVICE_SLEEP_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        LOG_E("AT device sleep queue thread create failed.");
+        rt_sem_delete(at_device_sleep_sem);
+        at_device_sleep_sem = RT_NULL;
+        return -RT_ERROR;
+    }
+
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+#endif /* AT_DEVICE_USING_STATIC */
+
+/**
+ * This function will queue the socket sending data when the AT device is sleeping, the device
+ * wakes up once after collecting data for AT_DEVICE_SLEEP_BATCH_TIME milliseconds, sends all
+ * queued data in one burst and sleeps again. The data not fitting in the queue wakes up the
+ * device at once, it's sent directly after the queued data and the device sleeps again after
+ * the batch time. When the device fails to wake up, the queued data is kept and sent again
+ * later, the new data is not accepted until then. It's called at the beginning of the device
+ * class socket send operation.
+ *
+ * @param socket current socket object
+ * @param iov send data segments
+ * @param iovcnt send data segments number
+ * @param type socket type
+ *
+ * @return   0: the device is not sleeping or it has woken up, send the data directly
+ *         > 0: the data is queued, the queued data size
+ *         < 0: queue the data failed
+ */
+int at_device_sleep_queue(struct at_socket *socket, const struct at_device_iovec *iov, int iovcnt,
+                          enum at_socket_type type)
+{
+    rt_base_t level;
+    rt_size_t bfsz = at_device_iov_len(iov, iovcnt);
+    struct at_device *device = (struct at_device *) socket->device;
+    struct at_device_sleep *sleep = at_device_sleep_get(device, RT_FALSE);
+    struct at_device_sleep_pkt *pkt = RT_NULL;
+
+    if (sleep == RT_NULL || (sleep->is_sleep == RT_FALSE && sleep->wakeup_failed == RT_FALSE))
+    {
+        return 0;
+    }
+
+    /* the new data is not accepted until the kept data is sent in order */
+    if (sleep->wakeup_failed)
+    {
+        LOG_E("AT device(%s) wakeup failed, the data(%d) can't be sent.", device->name, bfsz);
+        return -RT_ERROR;
+    }
+
+    /* the queued data is sent to the last destination, the datagram with its own one is sent directly */
+    if (at_device_udp_is_unconnected(device, (int) socket->user_data))
+    {
+        return 0;
+    }
+
+    if (at_device_sleep_startup() != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    if (sleep->queue_size + bfsz <= AT_DEVICE_SLEEP_QUEUE_SIZE)
+    {
+        pkt = at_device_sleep_pkt_alloc(sleep, bfsz);
+#ifndef AT_DEVICE_USING_STATIC
+        if (pkt == RT_NULL)
+        {
+            LOG_E("no memory for AT device(%s) sleep queue data(%d).", device->name, bfsz);
+            return -RT_ENOMEM;
+        }
+#endif
+    }
+
+    /* the data doesn't fit in the queue (or in the queued data heap of the static memory build), */
+    /* the queued data is sent first in order */
+    if (pkt == RT_NULL)
+    {
+        LOG_D("AT device(%s) wakes up to send the data(%d) directly.", device->name, bfsz);
+
+        if (at_device_sleep_send_queue(sleep) != RT_EOK)
+        {
+            return -RT_ERROR;
+        }
+
+        level = rt_hw_interrupt_disable();
+        sleep->sleep_again = RT_TRUE;
+        if (sleep->flush_pending == RT_FALSE)
+        {
+            sleep->flush_pending = RT_TRUE;
+            sleep->flush_tick = rt_tick_get() + rt_tick_from_millisecond(AT_DEVICE_SLEEP_BATCH_TIME);
+        }
+        rt_hw_interrupt_enable(level);
+
+        rt_sem_release(at_device_sleep_sem);
+        return 0;
+    }
+
+    pkt->socket = socket;
+    pkt->socket_fd = socket->socket;
+    pkt->type = type;
+    pkt->bfsz = bfsz;
+    pkt->buff = (char *) (pkt + 1);
+    at_device_iov_copy(pkt->buff, iov, iovcnt, 0, bfsz);
+    rt_slist_init(&(pkt->list));
+
+    level = rt_hw_interrupt_disable();
+
+    rt_slist_append(&(sleep->queue), &(pkt->list));
+    sleep->queue_size += bfsz;
+
+    /* the first queued data triggers the wakeup after the batch time */
+    if (sleep->flush_pending == RT_FALSE)
+    {
+        sleep->flush_pending = RT_TRUE;
+        sleep->flush_tick = rt_tick_get() + rt_tick_from_millisecond(AT_DEVICE_SLEEP_BATCH_TIME);
+        rt_hw_interrupt_enable(level);
+
+        rt_sem_release(at_device_sleep_sem);
+    }
+    else
+    {
+        rt_hw_interrupt_enable(level);
+    }
+
+    return (int) bfsz;
+}
+#endif /* AT_USING_SOCKET */
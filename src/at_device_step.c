@@ -0,0 +1,193 @@
+/*
+ * File      : at_device_step.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+/* The maximum length of the coalesced command line */
+#ifndef AT_DEVICE_STEP_LINE_MAX
+#define AT_DEVICE_STEP_LINE_MAX        64
+#endif
+
+#define AT_DEVICE_STEP_KEYWORD_MAX     32
+
+/* check the response has one of the keywords separated by '|' */
+static rt_bool_t step_keyword_match(at_response_t resp, const char *keyword)
+{
+    char kw[AT_DEVICE_STEP_KEYWORD_MAX] = {0};
+    const char *start = keyword, *end = RT_NULL;
+    rt_size_t len = 0;
+
+    while (start && *start)
+    {
+        end = strchr(start, '|');
+        len = end ? (rt_size_t) (end - start) : rt_strlen(start);
+        if (len >= sizeof(kw))
+        {
+            len = sizeof(kw) - 1;
+        }
+
+        rt_memcpy(kw, start, len);
+        kw[len] = '\0';
+
+        if (at_resp_get_line_by_kw(resp, kw))
+        {
+            return RT_TRUE;
+        }
+
+        start = end ? end + 1 : RT_NULL;
+    }
+
+    return RT_FALSE;
+}
+
+/* the step only checks "OK" result can be coalesced with the adjacent steps */
+static rt_bool_t step_coalescable(const struct at_device_step *step)
+{
+    return (step->flags & AT_DEVICE_STEP_COALESCE) && step->keyword == RT_NULL &&
+            rt_strlen(step->cmd) > 2 && rt_strncmp(step->cmd, "AT", 2) == 0;
+}
+
+static int step_exec(struct at_device *device, at_response_t resp, const struct at_device_step *step)
+{
+    int result = -RT_ERROR;
+    rt_uint32_t delay = step->delay;
+    rt_uint8_t i = 0;
+
+    for (i = 0; i <= step->retry; i++)
+    {
+        if (i > 0)
+        {
+            rt_thread_mdelay(delay);
+
+            /* exponential backoff for the retry delay */
+            if (step->delay_max > delay)
+            {
+                delay = (delay * 2 > step->delay_max) ? step->delay_max : delay * 2;
+            }
+        }
+
+        resp = at_device_resp_set_info(device, resp, resp->buf_size, 0, rt_tick_from_millisecond(step->timeout));
+        if (at_device_exec_cmd(device, resp, "%s", step->cmd) < 0)
+        {
+            result = -RT_ERROR;
+            continue;
+        }
+
+        if (step->keyword == RT_NULL ||
+                step_keyword_match(resp, step->keyword) != ((step->flags & AT_DEVICE_STEP_EXCLUDE) != 0))
+        {
+            return RT_EOK;
+        }
+
+        result = -RT_ERROR;
+    }
+
+    if (step->flags & AT_DEVICE_STEP_OPTIONAL)
+    {
+        LOG_D("AT device(%s) optional step(%s) failed.", device->name, step->cmd);
+        return RT_EOK;
+    }
+
+    LOG_E("AT device(%s) step(%s) failed.", device->name, step->cmd);
+
+    return result;
+}
+
+/**
+ * This function will execute the AT device initialize sequence steps in order, the adjacent
+ * steps with AT_DEVICE_STEP_COALESCE flag are sent in one command line (e.g. "ATE0;+CMEE=2"),
+ * and they are executed one by one when the coalesced command line failed.
+ *
+ * @param device the pointer of AT device structure
+ * @param resp the response object used to execute the steps
+ * @param steps the initialize sequence steps table
+ * @param step_num the number of steps
+ *
+ * @return = 0: all steps are executed successfully
+ *         < 0: execute step failed
+ */
+int at_device_exec_steps(struct at_device *device, at_response_t resp,
+                         const struct at_device_step *steps, rt_size_t step_num)
+{
+    char line[AT_DEVICE_STEP_LINE_MAX] = {0};
+    rt_size_t i = 0, j = 0, len = 0, cmd_len = 0;
+    rt_uint32_t timeout = 0;
+    int result = RT_EOK;
+
+    RT_ASSERT(device);
+    RT_ASSERT(resp);
+    RT_ASSERT(steps);
+
+    while (i < step_num)
+    {
+        /* coalesce the adjacent steps into one command line */
+        len = 0;
+        timeout = 0;
+        for (j = i; j < step_num && step_coalescable(&steps[j]); j++)
+        {
+            /* only the first command has the "AT" prefix */
+            cmd_len = rt_strlen(steps[j].cmd) - 2;
+            if (len + cmd_len + 3 > sizeof(line))
+            {
+                break;
+            }
+
+            len += rt_snprintf(line + len, sizeof(line) - len, (j == i) ? "AT%s" : ";%s", steps[j].cmd + 2);
+            timeout += steps[j].timeout;
+        }
+
+        if (j - i > 1)
+        {
+            resp = at_device_resp_set_info(device, resp, resp->buf_size, 0, rt_tick_from_millisecond(timeout));
+            if (at_device_exec_cmd(device, resp, "%s", line) == RT_EOK)
+            {
+                i = j;
+                continue;
+            }
+
+            LOG_D("AT device(%s) coalesced command(%s) failed, execute it step by step.", device->name, line);
+        }
+        else
+        {
+            j = i + 1;
+        }
+
+        for (; i < j; i++)
+        {
+            result = step_exec(device, resp, &steps[i]);
+            if (result != RT_EOK)
+            {
+                return result;
+            }
+        }
+    }
+
+    return RT_EOK;
+}
@@ -0,0 +1,183 @@
+/*
+ * File      : at_device_trace.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_DEVICE_USING_TRACE
+
+/* The number of the trace events in the ring buffer, it must be power of 2 */
+#ifndef AT_DEVICE_TRACE_NUM
+#define AT_DEVICE_TRACE_NUM            256
+#endif
+#if (AT_DEVICE_TRACE_NUM & (AT_DEVICE_TRACE_NUM - 1)) != 0
+#error "AT_DEVICE_TRACE_NUM must be power of 2!"
+#endif
+
+/* The maximum number of the traced AT devices */
+#define AT_DEVICE_TRACE_DEVICE_NUM     8
+
+/* The trace event record, the tools/at_trace_decode.py decodes it in little endian */
+struct at_device_trace_event
+{
+    rt_uint32_t tick;                            /* Timestamp in OS ticks */
+    rt_uint8_t type;                             /* Event type, AT_DEVICE_TRACE_XXX */
+    rt_uint8_t device;                           /* Device slot in the trace devices table */
+    rt_int8_t socket;                            /* Device socket, -1 if it's not a socket event */
+    rt_uint8_t reserved;
+    rt_uint16_t len;                             /* Payload length, response lines or latency */
+    rt_int16_t result;                           /* Operation result */
+    char tag[AT_DEVICE_TRACE_TAG_LEN];           /* Command or URC head, not NUL terminated */
+};
+
+static struct at_device_trace_event trace_ring[AT_DEVICE_TRACE_NUM];
+/* The total written events, the ring position is the low bits */
+static rt_uint32_t trace_head = 0;
+static struct at_device *trace_devices[AT_DEVICE_TRACE_DEVICE_NUM];
+
+static rt_uint8_t trace_device_slot(struct at_device *device)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < AT_DEVICE_TRACE_DEVICE_NUM; i++)
+    {
+        if (trace_devices[i] == device)
+        {
+            return i;
+        }
+
+        if (trace_devices[i] == RT_NULL)
+        {
+            trace_devices[i] = device;
+            return i;
+        }
+    }
+
+    return 0xFF;
+}
+
+/**
+ * This function will record one event in the AT device trace ring buffer. The ring is written
+ * without lock and memory allocation, the slot is reserved with the interrupt disabled for a few
+ * instructions, and the oldest events are overwritten.
+ *
+ * @param device the pointer of AT device structure
+ * @param type the event type, AT_DEVICE_TRACE_XXX
+ * @param socket the device socket, -1 if it's not a socket event
+ * @param len the payload length, response lines or latency in milliseconds
+ * @param result the operation result
+ * @param tag the command or URC line, it's cut at '=', '?' or the line end, RT_NULL if no name
+ */
+void at_device_trace(struct at_device *device, rt_uint8_t type, int socket, rt_uint32_t len,
+                     int result, const char *tag)
+{
+    rt_base_t level;
+    struct at_device_trace_event *event = RT_NULL;
+    rt_size_t i = 0;
+
+    level = rt_hw_interrupt_disable();
+
+    event = &trace_ring[trace_head & (AT_DEVICE_TRACE_NUM - 1)];
+    trace_head++;
+
+    event->tick = rt_tick_get();
+    event->type = type;
+    event->device = trace_device_slot(device);
+    event->socket = (rt_int8_t) socket;
+    event->reserved = 0;
+    event->len = (len > 0xFFFF) ? 0xFFFF : (rt_uint16_t) len;
+    event->result = (rt_int16_t) result;
+
+    for (i = 0; tag && i < AT_DEVICE_TRACE_TAG_LEN && tag[i] && tag[i] != '=' && tag[i] != '?' &&
+            tag[i] != '\r' && tag[i] != '\n'; i++)
+    {
+        event->tag[i] = tag[i];
+    }
+    for (; i < AT_DEVICE_TRACE_TAG_LEN; i++)
+    {
+        event->tag[i] = '\0';
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will clear the AT device trace ring buffer.
+ */
+void at_device_trace_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    trace_head = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will dump the AT device trace ring buffer from the oldest event as hex lines,
+ * one event for each line. The console log is decoded to a timeline by tools/at_trace_decode.py.
+ */
+void at_device_trace_dump(void)
+{
+    rt_base_t level;
+    struct at_device_trace_event event;
+    const rt_uint8_t *data = (const rt_uint8_t *) &event;
+    rt_uint32_t head, start, i;
+    rt_size_t j;
+
+    head = trace_head;
+    start = (head > AT_DEVICE_TRACE_NUM) ? head - AT_DEVICE_TRACE_NUM : 0;
+
+    rt_kprintf("AT_TRACE_BEGIN tick_hz=%d size=%d count=%d\n", RT_TICK_PER_SECOND,
+               (int) sizeof(struct at_device_trace_event), (int) (head - start));
+
+    for (i = 0; i < AT_DEVICE_TRACE_DEVICE_NUM && trace_devices[i]; i++)
+    {
+        rt_kprintf("AT_TRACE_DEVICE %d %s\n", i, trace_devices[i]->name);
+    }
+
+    for (i = start; i < head; i++)
+    {
+        /* copy the event, it may be overwritten while printing */
+        level = rt_hw_interrupt_disable();
+        rt_memcpy(&event, &trace_ring[i & (AT_DEVICE_TRACE_NUM - 1)], sizeof(event));
+        rt_hw_interrupt_enable(level);
+
+        rt_kprintf("AT_TRACE ");
+        for (j = 0; j < sizeof(event); j++)
+        {
+            rt_kprintf("%02x", data[j]);
+        }
+        rt_kprintf("\n");
+    }
+
+    rt_kprintf("AT_TRACE_END\n");
+}
+
+#endif /* AT_DEVICE_USING_TRACE */
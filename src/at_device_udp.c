@@ -0,0 +1,607 @@
+/*
+ * File      : at_device_udp.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     agent        first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.dev"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_USING_SOCKET
+
+/* The default local port of the unconnected UDP socket, the AT socket number is added to it */
+#ifndef AT_DEVICE_UDP_LOCAL_PORT
+#define AT_DEVICE_UDP_LOCAL_PORT       50000
+#endif
+
+/* The unconnected UDP status of one device socket */
+struct at_device_udp_sock
+{
+    int socket_fd;                               /* The AT socket opened unconnected, -1 if not */
+    rt_bool_t is_opening;                        /* The socket is being opened, it's not reset by the connection */
+    char ip[16];                                 /* The destination of the sending datagram */
+    int port;                                    /* The destination port, 0 if the destination is not set */
+};
+
+/* The unconnected UDP status of one AT device */
+struct at_device_udp
+{
+    struct at_device *device;
+    rt_mutex_t send_lock;                        /* Keep the destination with its datagram */
+    rt_mutex_t recv_lock;                        /* Keep the header with its datagram */
+    struct at_device_udp_sock *socks;            /* The status of all device sockets */
+#ifdef AT_DEVICE_USING_STATIC
+    struct rt_mutex send_lock_obj;
+    struct rt_mutex recv_lock_obj;
+    struct at_device_udp_sock socks_obj[AT_DEVICE_STATIC_SOCKET_NUM];
+#endif
+    rt_slist_t list;
+};
+
+/* The unconnected UDP status list, the nodes are never removed */
+static rt_slist_t at_device_udp_list = RT_SLIST_OBJECT_INIT(at_device_udp_list);
+#ifdef AT_DEVICE_USING_STATIC
+static struct at_device_udp at_device_udp_pool[AT_DEVICE_STATIC_DEVICE_NUM];
+#endif
+
+#ifdef AT_DEVICE_USING_STATIC
+/* claim the unconnected UDP status of the device from the static pool */
+static struct at_device_udp *at_device_udp_alloc(struct at_device *device)
+{
+    rt_base_t level;
+    struct at_device_udp *udp = RT_NULL;
+    int idx;
+
+    if (device->socket_num > AT_DEVICE_STATIC_SOCKET_NUM)
+    {
+        LOG_E("AT device(%s) sockets number(%d) is larger than AT_DEVICE_STATIC_SOCKET_NUM.",
+              device->name, device->socket_num);
+        return RT_NULL;
+    }
+
+    level = rt_hw_interrupt_disable();
+    for (idx = 0; idx < AT_DEVICE_STATIC_DEVICE_NUM; idx++)
+    {
+        if (at_device_udp_pool[idx].device == RT_NULL)
+        {
+            udp = &at_device_udp_pool[idx];
+            udp->device = device;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (udp == RT_NULL)
+    {
+        LOG_E("no free AT device(%s) UDP status, see AT_DEVICE_STATIC_DEVICE_NUM.", device->name);
+        return RT_NULL;
+    }
+
+    rt_mutex_init(&(udp->send_lock_obj), "at_udps", RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&(udp->recv_lock_obj), "at_udpr", RT_IPC_FLAG_FIFO);
+    udp->send_lock = &(udp->send_lock_obj);
+    udp->recv_lock = &(udp->recv_lock_obj);
+    udp->socks = udp->socks_obj;
+
+    return udp;
+}
+
+static void at_device_udp_free(struct at_device_udp *udp)
+{
+    rt_mutex_detach(&(udp->send_lock_obj));
+    rt_mutex_detach(&(udp->recv_lock_obj));
+    udp->device = RT_NULL;
+}
+#else
+static struct at_device_udp *at_device_udp_alloc(struct at_device *device)
+{
+    struct at_device_udp *udp = RT_NULL;
+
+    udp = (struct at_device_udp *) rt_calloc(1, sizeof(struct at_device_udp) +
+            device->socket_num * sizeof(struct at_device_udp_sock));
+    if (udp == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) UDP status.", device->name);
+        return RT_NULL;
+    }
+
+    udp->send_lock = rt_mutex_create("at_udps", RT_IPC_FLAG_FIFO);
+    udp->recv_lock = rt_mutex_create("at_udpr", RT_IPC_FLAG_FIFO);
+    if (udp->send_lock == RT_NULL || udp->recv_lock == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) UDP lock.", device->name);
+        if (udp->send_lock)
+        {
+            rt_mutex_delete(udp->send_lock);
+        }
+        if (udp->recv_lock)
+        {
+            rt_mutex_delete(udp->recv_lock);
+        }
+        rt_free(udp);
+        return RT_NULL;
+    }
+
+    udp->device = device;
+    udp->socks = (struct at_device_udp_sock *) (udp + 1);
+
+    return udp;
+}
+
+static void at_device_udp_free(struct at_device_udp *udp)
+{
+    rt_mutex_delete(udp->send_lock);
+    rt_mutex_delete(udp->recv_lock);
+    rt_free(udp);
+}
+#endif /* AT_DEVICE_USING_STATIC */
+
+/* find the unconnected UDP status of the device, it's called with the interrupt disabled */
+static struct at_device_udp *at_device_udp_find(struct at_device *device)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_udp *udp = RT_NULL;
+
+    rt_slist_for_each(node, &at_device_udp_list)
+    {
+        udp = rt_slist_entry(node, struct at_device_udp, list);
+        if (udp->device == device)
+        {
+            return udp;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static struct at_device_udp *at_device_udp_get(struct at_device *device, rt_bool_t create)
+{
+    rt_base_t level;
+    struct at_device_udp *udp = RT_NULL, *found = RT_NULL;
+    int idx;
+
+    level = rt_hw_interrupt_disable();
+    found = at_device_udp_find(device);
+    rt_hw_interrupt_enable(level);
+
+    if (found || create == RT_FALSE)
+    {
+        return found;
+    }
+
+    udp = at_device_udp_alloc(device);
+    if (udp == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    for (idx = 0; idx < (int) device->socket_num; idx++)
+    {
+        udp->socks[idx].socket_fd = -1;
+    }
+    rt_slist_init(&(udp->list));
+
+    /* the status may be created by another thread in the meantime, only the first one is added */
+    level = rt_hw_interrupt_disable();
+    found = at_device_udp_find(device);
+    if (found == RT_NULL)
+    {
+        rt_slist_append(&at_device_udp_list, &(udp->list));
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (found)
+    {
+        at_device_udp_free(udp);
+        return found;
+    }
+
+    return udp;
+}
+
+/* get the unconnected UDP status of the AT socket, RT_NULL if it's not opened by at_device_udp_open() */
+static struct at_device_udp_sock *at_device_udp_sock_get(struct at_device_udp *udp, struct at_socket *socket)
+{
+    struct at_device *device = (struct at_device *) socket->device;
+    int idx = (int) (socket - device->sockets);
+
+    if (udp == RT_NULL || idx < 0 || idx >= (int) device->socket_num)
+    {
+        return RT_NULL;
+    }
+
+    return (udp->socks[idx].socket_fd == socket->socket) ? &(udp->socks[idx]) : RT_NULL;
+}
+
+/* get the AT socket of the unconnected UDP socket operations */
+static struct at_socket *at_device_udp_socket_get(int at_socket)
+{
+    struct at_socket *socket = at_get_socket(at_socket);
+
+    if (socket == RT_NULL || socket->device == RT_NULL || socket->type != AT_SOCKET_UDP)
+    {
+        LOG_E("AT socket(%d) is not a UDP socket.", at_socket);
+        return RT_NULL;
+    }
+
+    return socket;
+}
+
+/**
+ * This function will open the UDP socket unconnected, the datagrams are sent to the destination
+ * given by at_device_udp_sendto() and received from any peers by at_device_udp_recvfrom().
+ * It's used instead of connecting the socket, the data sent by at_send() goes to the last
+ * destination.
+ *
+ * @param at_socket AT socket number, the socket is created and not connected
+ * @param local_port local port of the socket, 0 for AT_DEVICE_UDP_LOCAL_PORT plus the socket number
+ *
+ * @return 0: open success
+ *        -2: wait socket event timeout
+ *        -5: no memory
+ *        -6: the device class doesn't support the unconnected UDP socket
+ *        < 0: other open failed
+ */
+int at_device_udp_open(int at_socket, int local_port)
+{
+    struct at_socket *socket = at_device_udp_socket_get(at_socket);
+    struct at_device *device = RT_NULL;
+    struct at_device_udp *udp = RT_NULL;
+    struct at_device_udp_sock *sock = RT_NULL;
+    int result = RT_EOK;
+
+    if (socket == RT_NULL || socket->state != AT_SOCKET_OPEN || local_port < 0 || local_port > 65535)
+    {
+        return -RT_EINVAL;
+    }
+
+    device = (struct at_device *) socket->device;
+    if (device->class->socket_udp_open == RT_NULL)
+    {
+        LOG_E("AT device(%s) not supported the unconnected UDP socket.", device->name);
+        return -RT_ENOSYS;
+    }
+
+    udp = at_device_udp_get(device, RT_TRUE);
+    if (udp == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    if (local_port == 0)
+    {
+        local_port = AT_DEVICE_UDP_LOCAL_PORT + at_socket;
+    }
+
+    rt_mutex_take(udp->send_lock, RT_WAITING_FOREVER);
+
+    /* the datagrams received once the socket is opened carry the source header */
+    sock = &(udp->socks[socket - device->sockets]);
+    sock->socket_fd = socket->socket;
+    sock->is_opening = RT_TRUE;
+    sock->port = 0;
+
+    result = device->class->socket_udp_open(socket, local_port);
+
+    sock->is_opening = RT_FALSE;
+    if (result < 0)
+    {
+        sock->socket_fd = -1;
+    }
+    else
+    {
+        socket->state = AT_SOCKET_CONNECT;
+    }
+
+    rt_mutex_release(udp->send_lock);
+
+    LOG_D("AT device(%s) socket(%d) open unconnected UDP on local port(%d) result(%d).",
+          device->name, at_socket, local_port, result);
+
+    return result;
+}
+
+/**
+ * This function will send one datagram of the unconnected UDP socket to the destination.
+ *
+ * @param at_socket AT socket number opened by at_device_udp_open()
+ * @param data send data
+ * @param size send data size, the datagram is not split
+ * @param to destination address, struct sockaddr_in
+ * @param tolen destination address length
+ *
+ * @return >=0: the size of send success
+ *          < 0: send failed
+ */
+int at_device_udp_sendto(int at_socket, const void *data, rt_size_t size,
+                         const struct sockaddr *to, socklen_t tolen)
+{
+    struct at_socket *socket = at_device_udp_socket_get(at_socket);
+    const struct sockaddr_in *addr = (const struct sockaddr_in *) to;
+    struct at_device *device = RT_NULL;
+    struct at_device_udp *udp = RT_NULL;
+    struct at_device_udp_sock *sock = RT_NULL;
+    struct at_device_iovec iov;
+    const rt_uint8_t *ipaddr = RT_NULL;
+    int result = 0;
+
+    if (socket == RT_NULL || data == RT_NULL || size == 0 || to == RT_NULL || tolen < sizeof(struct sockaddr_in))
+    {
+        return -RT_EINVAL;
+    }
+
+    device = (struct at_device *) socket->device;
+    udp = at_device_udp_get(device, RT_FALSE);
+    sock = at_device_udp_sock_get(udp, socket);
+    if (sock == RT_NULL)
+    {
+        LOG_E("AT socket(%d) is not opened unconnected.", at_socket);
+        return -RT_EINVAL;
+    }
+
+    iov.base = data;
+    iov.len = size;
+
+    rt_mutex_take(udp->send_lock, RT_WAITING_FOREVER);
+
+    /* the device class send operation gets the destination by at_device_udp_get_dest() */
+    ipaddr = (const rt_uint8_t *) &(addr->sin_addr.s_addr);
+    rt_snprintf(sock->ip, sizeof(sock->ip), "%d.%d.%d.%d", ipaddr[0], ipaddr[1], ipaddr[2], ipaddr[3]);
+    sock->port = ntohs(addr->sin_port);
+
+    result = device->class->socket_sendv(socket, &iov, 1, AT_SOCKET_UDP);
+
+    rt_mutex_release(udp->send_lock);
+
+    return result;
+}
+
+/* set the source address of the received datagram */
+static void at_device_udp_from_set(const struct at_device_udp_head *head, struct sockaddr *from, socklen_t *fromlen)
+{
+    struct sockaddr_in addr;
+    rt_uint8_t *ipaddr = (rt_uint8_t *) &(addr.sin_addr.s_addr);
+    int ip[4] = {0};
+
+    if (from == RT_NULL || fromlen == RT_NULL)
+    {
+        return;
+    }
+
+    rt_memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(head->port);
+    /* the source address is 0.0.0.0 if the module doesn't report it */
+    if (sscanf(head->ip, "%d.%d.%d.%d", &ip[0], &ip[1], &ip[2], &ip[3]) == 4)
+    {
+        ipaddr[0] = (rt_uint8_t) ip[0];
+        ipaddr[1] = (rt_uint8_t) ip[1];
+        ipaddr[2] = (rt_uint8_t) ip[2];
+        ipaddr[3] = (rt_uint8_t) ip[3];
+    }
+
+    rt_memcpy(from, &addr, (*fromlen < sizeof(addr)) ? *fromlen : sizeof(addr));
+    *fromlen = sizeof(addr);
+}
+
+/**
+ * This function will receive one datagram of the unconnected UDP socket, it's blocked by the
+ * socket receive timeout. The rest of the datagram longer than the buffer is discarded.
+ *
+ * @param at_socket AT socket number opened by at_device_udp_open()
+ * @param mem receive buffer
+ * @param len receive buffer size
+ * @param from source address of the datagram, struct sockaddr_in, it can be RT_NULL
+ * @param fromlen source address length
+ *
+ * @return >0: the received datagram size
+ *          0: the socket is closed
+ *        < 0: receive failed or timeout
+ */
+int at_device_udp_recvfrom(int at_socket, void *mem, rt_size_t len,
+                           struct sockaddr *from, socklen_t *fromlen)
+{
+    struct at_socket *socket = at_device_udp_socket_get(at_socket);
+    struct at_device_udp *udp = RT_NULL;
+    struct at_device_udp_head head;
+    char temp[16];
+    rt_size_t recv_len = 0, read_len = 0;
+    int result = 0;
+
+    if (socket == RT_NULL || mem == RT_NULL || len == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    udp = at_device_udp_get((struct at_device *) socket->device, RT_FALSE);
+    if (at_device_udp_sock_get(udp, socket) == RT_NULL)
+    {
+        LOG_E("AT socket(%d) is not opened unconnected.", at_socket);
+        return -RT_EINVAL;
+    }
+
+    rt_mutex_take(udp->recv_lock, RT_WAITING_FOREVER);
+
+    /* wait for the header, the socket timeout and close are returned by it */
+    result = at_recv(at_socket, &head, sizeof(head), 0);
+    if (result <= 0)
+    {
+        goto __exit;
+    }
+
+    if (result != sizeof(head))
+    {
+        LOG_E("AT socket(%d) received datagram header error.", at_socket);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the datagram follows its header in the same received packet */
+    while (recv_len < head.len)
+    {
+        if (recv_len < len)
+        {
+            read_len = (head.len < len) ? head.len - recv_len : len - recv_len;
+            result = at_recv(at_socket, (char *) mem + recv_len, read_len, 0);
+        }
+        else
+        {
+            read_len = (head.len - recv_len < sizeof(temp)) ? head.len - recv_len : sizeof(temp);
+            result = at_recv(at_socket, temp, read_len, 0);
+        }
+
+        if (result <= 0)
+        {
+            LOG_E("AT socket(%d) received datagram size(%d) error.", at_socket, head.len);
+            result = -RT_ERROR;
+            goto __exit;
+        }
+
+        recv_len += result;
+    }
+
+    at_device_udp_from_set(&head, from, fromlen);
+    result = (int) ((head.len < len) ? head.len : len);
+
+__exit:
+    rt_mutex_release(udp->recv_lock);
+
+    return result;
+}
+
+/**
+ * This function will get whether the device socket is opened unconnected, the datagrams
+ * received by it are put after the header set by at_device_udp_head_set().
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket device socket number
+ *
+ * @return RT_TRUE: the socket is opened unconnected
+ */
+rt_bool_t at_device_udp_is_unconnected(struct at_device *device, int device_socket)
+{
+    struct at_device_udp *udp = at_device_udp_get(device, RT_FALSE);
+
+    if (udp == RT_NULL || device_socket < 0 || device_socket >= (int) device->socket_num)
+    {
+        return RT_FALSE;
+    }
+
+    return (udp->socks[device_socket].socket_fd >= 0 &&
+            udp->socks[device_socket].socket_fd == device->sockets[device_socket].socket) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * This function will set the destination of the UDP device socket, it's used by the device
+ * classes which send every datagram with its destination.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket device socket number
+ * @param ip destination IP address
+ * @param port destination port
+ */
+void at_device_udp_set_dest(struct at_device *device, int device_socket, const char *ip, int port)
+{
+    struct at_device_udp *udp = at_device_udp_get(device, RT_TRUE);
+
+    if (udp == RT_NULL || device_socket < 0 || device_socket >= (int) device->socket_num)
+    {
+        return;
+    }
+
+    rt_strncpy(udp->socks[device_socket].ip, ip, sizeof(udp->socks[device_socket].ip) - 1);
+    udp->socks[device_socket].port = port;
+}
+
+/**
+ * This function will get the destination of the sending datagram, it's called by the device
+ * class send operation to send the datagram by the send command with the destination.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket device socket number
+ * @param ip destination IP address
+ * @param port destination port
+ *
+ * @return RT_TRUE: the destination is set
+ */
+rt_bool_t at_device_udp_get_dest(struct at_device *device, int device_socket, char ip[16], int *port)
+{
+    struct at_device_udp *udp = at_device_udp_get(device, RT_FALSE);
+
+    if (udp == RT_NULL || device_socket < 0 || device_socket >= (int) device->socket_num ||
+            udp->socks[device_socket].port == 0)
+    {
+        return RT_FALSE;
+    }
+
+    rt_strncpy(ip, udp->socks[device_socket].ip, 16);
+    *port = udp->socks[device_socket].port;
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will set the header of the datagram received by the unconnected UDP socket.
+ *
+ * @param head the header before the received datagram
+ * @param ip source IP address, RT_NULL if the module doesn't report it
+ * @param port source port
+ * @param len datagram length
+ */
+void at_device_udp_head_set(struct at_device_udp_head *head, const char *ip, int port, rt_size_t len)
+{
+    rt_memset(head, 0x00, sizeof(struct at_device_udp_head));
+    if (ip)
+    {
+        rt_strncpy(head->ip, ip, sizeof(head->ip) - 1);
+    }
+    head->port = port;
+    head->len = len;
+}
+
+/**
+ * This function will reset the UDP status of the device socket when it's connected, the socket
+ * number may be reused by a new socket.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket device socket number
+ */
+void at_device_udp_reset(struct at_device *device, int device_socket)
+{
+    struct at_device_udp *udp = at_device_udp_get(device, RT_FALSE);
+
+    if (udp == RT_NULL || device_socket < 0 || device_socket >= (int) device->socket_num ||
+            udp->socks[device_socket].is_opening)
+    {
+        return;
+    }
+
+    udp->socks[device_socket].socket_fd = -1;
+    udp->socks[device_socket].port = 0;
+}
+
+#endif /* AT_USING_SOCKET */
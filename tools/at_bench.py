@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+#
+# File      : at_bench.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+# Benchmark of the AT device classes. It runs the bench server of the at_bench msh command
+# (samples/at_sample_bench.c), starts the host build with the modem emulator for every model,
+# link speed and module delay, and writes the BENCH results as JSON or CSV.
+#
+#   python3 at_bench.py --model esp8266 --model ec20 --baud 115200 --baud 921600 --delay 0 --delay 20
+#   python3 at_bench.py --output result.csv --format csv
+#   python3 at_bench.py --model ec20 --devices 1 --devices 2 --test conc
+#                                       the sockets are spread over the emulated modems
+#   python3 at_bench.py --test up --write-size 64 --coalesce 20
+#                                       small writes coalesced by the AT device
+#   python3 at_bench.py --serve 9000        only run the bench server for the real hardware
+#
+
+import argparse
+import csv
+import json
+import os
+import socket
+import subprocess
+import sys
+import threading
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HOST = os.path.join(ROOT, 'host', 'build', 'at_host')
+EMULATOR = os.path.join(ROOT, 'host', 'at_modem_emu.py')
+
+TESTS = {
+    'up':      'at_bench up localhost {port} -n {bytes} -w {write_size} -f {coalesce} -g {segments}',
+    'down':    'at_bench down localhost {port} -n {bytes}',
+    'rtt':     'at_bench rtt localhost {port} -n {count} -s {size}',
+    'conc':    'at_bench conc localhost {port} -n {bytes} -c {sockets} -w {write_size} -f {coalesce} -g {segments}',
+    'connect': 'at_bench connect localhost {port} -n {count}',
+}
+
+
+def read_line(conn):
+    line = b''
+    while not line.endswith(b'\n'):
+        data = conn.recv(1)
+        if not data:
+            return None
+        line += data
+    return line.decode('ascii', 'replace').strip()
+
+
+def serve_client(conn):
+    try:
+        request = read_line(conn)
+        if request is None:
+            return
+        args = request.split()
+        if args[0] == 'up':
+            left = int(args[1])
+            while left > 0:
+                data = conn.recv(min(left, 65536))
+                if not data:
+                    return
+                left -= len(data)
+            conn.sendall(b'done %d\n' % int(args[1]))
+        elif args[0] == 'down':
+            left = int(args[1])
+            while left > 0:
+                size = min(left, 4096)
+                conn.sendall(b'd' * size)
+                left -= size
+        elif args[0] == 'echo':
+            while True:
+                data = conn.recv(4096)
+                if not data:
+                    return
+                conn.sendall(data)
+        # wait for the client closing the connection
+        while conn.recv(4096):
+            pass
+    except (OSError, ValueError, IndexError):
+        pass
+    finally:
+        conn.close()
+
+
+def start_server(port):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(('0.0.0.0', port))
+    server.listen(16)
+
+    def accept_loop():
+        while True:
+            conn, _ = server.accept()
+            threading.Thread(target=serve_client, args=(conn,), daemon=True).start()
+
+    threading.Thread(target=accept_loop, daemon=True).start()
+    return server.getsockname()[1]
+
+
+def run_case(args, port, model, devices, baud, delay):
+    emulator = '!%s %s --model %s --baud %d --delay %d' % (sys.executable, EMULATOR, model, baud, delay)
+    cmd = [args.host, '-t', str(args.ready_timeout), '-p', 'least', '-v', '0']
+    for _ in range(devices):
+        cmd += ['-d', '%s=%s' % (model, emulator)]
+    for test in args.test:
+        cmd += ['-c', TESTS[test].format(port=port, bytes=args.bytes, count=args.count,
+                                         size=args.size, sockets=args.sockets,
+                                         write_size=args.write_size, coalesce=args.coalesce,
+                                         segments=args.segments)]
+
+    results = []
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              timeout=args.timeout, universal_newlines=True)
+        output, code = proc.stdout, proc.returncode
+    except subprocess.TimeoutExpired as error:
+        output, code = error.stdout or '', -1
+        if isinstance(output, bytes):
+            output = output.decode('utf-8', 'replace')
+
+    for line in output.splitlines():
+        if line.startswith('BENCH '):
+            result = json.loads(line[len('BENCH '):])
+            result.update(model=model, devices=devices, baud=baud, delay_ms=delay)
+            results.append(result)
+
+    if code != 0 or len(results) != len(args.test):
+        sys.stderr.write('%s devices %d baud %d delay %d: exit %d, %d of %d results\n%s\n' %
+                         (model, devices, baud, delay, code, len(results), len(args.test), output))
+    return results, code == 0
+
+
+def write_results(results, path, fmt):
+    out = open(path, 'w', newline='') if path else sys.stdout
+    try:
+        if fmt == 'json':
+            json.dump(results, out, indent=2)
+            out.write('\n')
+        else:
+            fields = []
+            for result in results:
+                fields += [key for key in result if key not in fields]
+            writer = csv.DictWriter(out, fieldnames=fields)
+            writer.writeheader()
+            writer.writerows(results)
+    finally:
+        if path:
+            out.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AT device throughput and latency benchmark')
+    parser.add_argument('--model', action='append', help='emulated module model, default esp8266 and ec20')
+    parser.add_argument('--devices', action='append', type=int, help='emulated modems of the model, default 1')
+    parser.add_argument('--baud', action='append', type=int, help='link speed in baud, default 115200')
+    parser.add_argument('--delay', action='append', type=int, help='module processing delay in ms, default 0')
+    parser.add_argument('--test', action='append', choices=sorted(TESTS), help='tests to run, default all')
+    parser.add_argument('--bytes', type=int, default=16384, help='bytes of the up, down and conc tests')
+    parser.add_argument('--count', type=int, default=20, help='iterations of the rtt and connect tests')
+    parser.add_argument('--size', type=int, default=32, help='message size of the rtt test')
+    parser.add_argument('--sockets', type=int, default=4, help='sockets of the conc test')
+    parser.add_argument('--write-size', type=int, default=1024, help='write size of the up and conc tests')
+    parser.add_argument('--coalesce', type=int, default=0, metavar='MS',
+                        help='coalesce the writes of the up and conc tests with the flush delay, '
+                             'the host build needs AT_DEVICE_USING_COALESCE')
+    parser.add_argument('--segments', type=int, default=1,
+                        help='send every write of the up and conc tests by the vectored send in the segments')
+    parser.add_argument('--host', default=HOST, help='host build program, default host/build/at_host')
+    parser.add_argument('--ready-timeout', type=int, default=20000, help='AT device ready timeout in ms')
+    parser.add_argument('--timeout', type=int, default=600, help='timeout of one case in seconds')
+    parser.add_argument('--format', choices=['json', 'csv'], default='json')
+    parser.add_argument('--output', help='result file, default the standard output')
+    parser.add_argument('--port', type=int, default=0, help='bench server port, default any free port')
+    parser.add_argument('--serve', type=int, metavar='PORT', help='only run the bench server on the port')
+    args = parser.parse_args()
+
+    if args.serve is not None:
+        start_server(args.serve)
+        sys.stderr.write('bench server on port %d\n' % args.serve)
+        threading.Event().wait()
+
+    args.model = args.model or ['esp8266', 'ec20']
+    args.devices = args.devices or [1]
+    args.baud = args.baud or [115200]
+    args.delay = args.delay or [0]
+    args.test = args.test or ['up', 'down', 'rtt', 'conc', 'connect']
+
+    if not os.path.exists(args.host):
+        sys.exit('%s not found, build it with "make -C host"' % args.host)
+
+    port = start_server(args.port)
+    results, passed = [], True
+    for model in args.model:
+        for devices in args.devices:
+            for baud in args.baud:
+                for delay in args.delay:
+                    case_results, case_passed = run_case(args, port, model, devices, baud, delay)
+                    results += case_results
+                    passed = passed and case_passed
+
+    write_results(results, args.output, args.format)
+    sys.exit(0 if passed else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# File      : at_trace_decode.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     agent        first version
+#
+# Decode the AT device trace ring buffer dumped by the "at_device trace" msh command to a
+# timeline. The input is the captured console log, the other console lines are skipped.
+#
+#   python3 at_trace_decode.py console.log [--gap 500] [--socket 0] [--device esp0]
+#
+
+import argparse
+import struct
+import sys
+
+# struct at_device_trace_event, little endian
+EVENT_FORMAT = '<IBBbBHh12s'
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+EVENT_TYPES = {
+    0x01: 'CMD',
+    0x02: 'URC',
+    0x03: 'SEND',
+    0x04: 'SEND_FAIL',
+    0x05: 'RECV',
+    0x06: 'RECV_DROP',
+    0x07: 'CONNECT',
+    0x08: 'RESOLVE',
+    0x10: 'RESP',
+}
+
+
+def parse_dump(lines):
+    tick_hz = 1000
+    devices = {}
+    events = []
+
+    for line in lines:
+        # the console prompt or log may be printed before the trace line
+        pos = line.find('AT_TRACE')
+        if pos < 0:
+            continue
+        fields = line[pos:].split()
+
+        if fields[0] == 'AT_TRACE_BEGIN':
+            args = dict(field.split('=', 1) for field in fields[1:] if '=' in field)
+            tick_hz = int(args.get('tick_hz', tick_hz))
+            if int(args.get('size', EVENT_SIZE)) != EVENT_SIZE:
+                sys.exit('trace event size %s mismatch, expect %d' % (args['size'], EVENT_SIZE))
+            devices = {}
+            events = []
+        elif fields[0] == 'AT_TRACE_DEVICE' and len(fields) >= 3:
+            devices[int(fields[1])] = fields[2]
+        elif fields[0] == 'AT_TRACE' and len(fields) >= 2:
+            try:
+                data = bytes.fromhex(fields[1])
+            except ValueError:
+                continue
+            if len(data) == EVENT_SIZE:
+                events.append(struct.unpack(EVENT_FORMAT, data))
+
+    return tick_hz, devices, events
+
+
+def tag_text(tag):
+    return ''.join(chr(c) if 0x20 <= c < 0x7F else '.' for c in tag.rstrip(b'\0'))
+
+
+def event_detail(type_name, socket, length, result, tag):
+    if type_name == 'CMD':
+        return '%s (%d bytes)' % (tag, length)
+    if type_name == 'RESP':
+        return '%s result %d, %d lines' % (tag, result, length)
+    if type_name == 'URC':
+        return '%s (%d bytes)' % (tag, length)
+    if type_name in ('CONNECT', 'RESOLVE'):
+        return 'latency %d ms' % length
+    if type_name in ('SEND', 'RECV'):
+        return '%d bytes' % length
+    return ''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the AT device trace dump to a timeline.')
+    parser.add_argument('file', nargs='?', help='console log file, default read from stdin')
+    parser.add_argument('--gap', type=int, default=0,
+                        help='mark the events after a gap longer than GAP milliseconds')
+    parser.add_argument('--socket', type=int, help='only show the events of the socket')
+    parser.add_argument('--device', help='only show the events of the device')
+    args = parser.parse_args()
+
+    stream = open(args.file, errors='replace') if args.file else sys.stdin
+    tick_hz, devices, events = parse_dump(stream)
+    if not events:
+        sys.exit('no trace event found')
+
+    # the tick is 32 bits and it may overflow in the dumped window
+    start_tick = events[0][0]
+    last_ms = None
+    print('%10s %8s  %-8s %-10s %4s  %s' % ('time(ms)', 'delta', 'device', 'event', 'sock', 'detail'))
+
+    for tick, etype, device, socket, _, length, result, tag in events:
+        device_name = devices.get(device, '#%d' % device)
+        if args.device and device_name != args.device:
+            continue
+        if args.socket is not None and socket != args.socket:
+            continue
+
+        ms = ((tick - start_tick) & 0xFFFFFFFF) * 1000 // tick_hz
+        delta = 0 if last_ms is None else ms - last_ms
+        last_ms = ms
+
+        type_name = EVENT_TYPES.get(etype, 'TYPE_%02x' % etype)
+        mark = ' <-- gap' if args.gap and delta > args.gap else ''
+        print('%10d %+8d  %-8s %-10s %4s  %s%s' % (ms, delta, device_name, type_name,
+                                                   socket if socket >= 0 else '-',
+                                                   event_detail(type_name, socket, length, result,
+                                                                tag_text(tag)), mark))
+
+
+if __name__ == '__main__':
+    main()